@@ -0,0 +1,33 @@
+/**
+ * \file
+ * \brief Configuration of the benchmarks that capture the posted events to an event stream
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_CONFIG_H
+#define HSM_CONFIG_H
+
+// Copy the hook to the hsm_config.h of an application to record its event streams with event_stream.cpp.
+// The hook returns after a load of a flag, while no capture is running.
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+extern void capture_posted_event(const void* pState_Machine, const void* pEvent);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#define HSM_TRACE_POST(pState_Machine, pEvent)    capture_posted_event(pState_Machine, pEvent)
+
+#endif // HSM_CONFIG_H
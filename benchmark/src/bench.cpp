@@ -0,0 +1,422 @@
+/**
+ * \file
+ * \brief Harness of the framework benchmarks
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// Each benchmark case is calibrated till a run of its iterations takes the minimum time,
+// then the run is repeated and the median of the repetitions is reported.
+//
+// Options of the benchmark executables:
+//   --filter=<text>       run only the cases whose name contains the text
+//   --min-time=<ms>       minimum duration of a measured run, default 100 ms
+//   --repetitions=<n>     measured runs of each case, default 5
+//   --perf                read the hardware counters around the measured runs and report them per event:
+//                         instructions, IPC, L1 data cache, last level cache and branch misses
+//   --json=<file>         write the results to the file, compare two of them with bench_compare
+//
+// The JSON results have the per event values of each measured run, so that bench_compare can test
+// whether two results differ beyond the noise of the runs:
+//   {"benchmark": "hsm_dispatch_bench", "min_time_ms": 100, "repetitions": 5,
+//    "cases": [{"name": "...", "iterations": 1000, "events": 5000,
+//               "samples": {"ns_per_event": [...], "cycles_per_event": [...], "perf_<counter>_per_event": [...]},
+//               "counters": {"<counter>_per_event": 1.5}}]}
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bench.h"
+#include "hsm_port.h"
+#include "perf_counters.h"
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define MAX_ITERATIONS      (UINT64_C(1) << 40)   //!< Upper limit of calibration
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+namespace
+{
+
+typedef struct
+{
+  double Min_Time;          //!< Minimum duration of a measured run, in ns
+  uint32_t Repetitions;     //!< Measured runs of each case
+  std::string Filter;       //!< Substring of the selected case names
+  bool Perf;                //!< Read the hardware counters
+  std::string Json;         //!< File of the JSON results, empty if not written
+}options_t;
+
+typedef struct
+{
+  std::string Name;
+  uint64_t Count;           //!< Total of the measured runs
+}counter_t;
+
+//! Duration of a run of the benchmark case
+typedef struct
+{
+  double Ns;
+  double Cycles;
+  uint64_t Events;
+  perf_sample_t Perf;       //!< Hardware counters, if they are read
+}run_t;
+
+typedef struct
+{
+  std::string Name;
+  uint64_t Iterations;              //!< Iterations of each measured run
+  uint64_t Events;                  //!< Events of all the measured runs
+  std::vector<double> Ns_Per_Event; //!< Each measured run
+  std::vector<double> Cycles_Per_Event;
+  std::vector<double> Perf_Per_Event[PERF_COUNTERS];  //!< Each measured run, empty if the counter isn't read
+  std::vector<counter_t> Counters;
+}result_t;
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+options_t Options = {100e6, 5, std::string(), false, std::string()};
+std::string Program;                        //!< Name of the benchmark executable
+std::vector<result_t> Results;
+bool Perf_Open;                             //!< Hardware counters are read
+std::vector<counter_t>* pActive_Counters;   //!< Counters of the measured run, NULL during calibration
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+void print_usage(const char* pProgram)
+{
+  fprintf(stderr, "Usage: %s [--filter=<text>] [--min-time=<ms>] [--repetitions=<n>] [--perf] [--json=<file>]\n",
+          pProgram);
+}
+
+run_t measure(const bench_function_t& function, uint64_t iterations)
+{
+  run_t run;
+  if(Perf_Open)
+  {
+    start_perf_counters();
+  }
+  const auto start = std::chrono::steady_clock::now();
+  const uint64_t start_cycles = HSM_CYCLE_COUNTER();
+
+  run.Events = function(iterations);
+
+  const uint64_t stop_cycles = HSM_CYCLE_COUNTER();
+  const auto stop = std::chrono::steady_clock::now();
+  if(Perf_Open)
+  {
+    stop_perf_counters(&run.Perf);
+  }
+  else
+  {
+    run.Perf = perf_sample_t();
+  }
+
+  run.Ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+  run.Cycles = (double)(stop_cycles - start_cycles);
+  return run;
+}
+
+double median(std::vector<double> values)
+{
+  std::sort(values.begin(), values.end());
+  const size_t middle = values.size() / 2;
+  return (values.size() % 2) ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+void report(const result_t& result)
+{
+  if(Results.size() == 1)
+  {
+    printf("%-60s %12s %14s %13s %8s\n", "benchmark", "ns/event", "events/s", "cycles/event", "spread");
+  }
+
+  const double ns = median(result.Ns_Per_Event);
+  const double spread = (ns > 0)
+      ? 100 * (*std::max_element(result.Ns_Per_Event.begin(), result.Ns_Per_Event.end())
+               - *std::min_element(result.Ns_Per_Event.begin(), result.Ns_Per_Event.end())) / ns
+      : 0;
+
+  printf("%-60s %12.2f %14.0f %13.2f %7.1f%%", result.Name.c_str(), ns, (ns > 0) ? 1e9 / ns : 0,
+         median(result.Cycles_Per_Event), spread);
+
+  for(const counter_t& counter : result.Counters)
+  {
+    printf("  %s/event=%.2f", counter.Name.c_str(), (double)counter.Count / (double)result.Events);
+  }
+
+  for(uint32_t counter = 0; counter < PERF_COUNTERS; counter++)
+  {
+    if(!result.Perf_Per_Event[counter].empty())
+    {
+      printf("  %s/event=%.2f", get_perf_counter_name((perf_counter_t)counter),
+             median(result.Perf_Per_Event[counter]));
+    }
+  }
+  if(!result.Perf_Per_Event[PERF_CYCLES].empty() && !result.Perf_Per_Event[PERF_INSTRUCTIONS].empty())
+  {
+    const double cycles = median(result.Perf_Per_Event[PERF_CYCLES]);
+    printf("  ipc=%.2f", (cycles > 0) ? median(result.Perf_Per_Event[PERF_INSTRUCTIONS]) / cycles : 0);
+  }
+  printf("\n");
+  fflush(stdout);
+}
+
+void write_json_string(FILE* const pFile, const std::string& text)
+{
+  fputc('"', pFile);
+  for(const char character : text)
+  {
+    if((character == '"') || (character == '\\'))
+    {
+      fputc('\\', pFile);
+    }
+    fputc(character, pFile);
+  }
+  fputc('"', pFile);
+}
+
+void write_json_samples(FILE* const pFile, const std::string& name, const std::vector<double>& samples)
+{
+  fprintf(pFile, "%s\"%s\": [", (name == "ns_per_event") ? "" : ", ", name.c_str());
+  for(size_t index = 0; index < samples.size(); index++)
+  {
+    fprintf(pFile, "%s%.17g", (index != 0) ? ", " : "", samples[index]);
+  }
+  fprintf(pFile, "]");
+}
+
+bool write_json(const std::string& path)
+{
+  FILE* const pFile = fopen(path.c_str(), "w");
+  if(pFile == NULL)
+  {
+    return false;
+  }
+
+  fprintf(pFile, "{\"benchmark\": ");
+  write_json_string(pFile, Program);
+  fprintf(pFile, ", \"min_time_ms\": %.17g, \"repetitions\": %u,\n \"cases\": [", Options.Min_Time / 1e6,
+          Options.Repetitions);
+
+  for(size_t index = 0; index < Results.size(); index++)
+  {
+    const result_t& result = Results[index];
+    fprintf(pFile, "%s\n  {\"name\": ", (index != 0) ? "," : "");
+    write_json_string(pFile, result.Name);
+    fprintf(pFile, ", \"iterations\": %llu, \"events\": %llu,\n   \"samples\": {",
+            (unsigned long long)result.Iterations, (unsigned long long)result.Events);
+    write_json_samples(pFile, "ns_per_event", result.Ns_Per_Event);
+    write_json_samples(pFile, "cycles_per_event", result.Cycles_Per_Event);
+    for(uint32_t counter = 0; counter < PERF_COUNTERS; counter++)
+    {
+      if(!result.Perf_Per_Event[counter].empty())
+      {
+        write_json_samples(pFile, std::string("perf_") + get_perf_counter_name((perf_counter_t)counter) + "_per_event",
+                           result.Perf_Per_Event[counter]);
+      }
+    }
+
+    fprintf(pFile, "},\n   \"counters\": {");
+    for(size_t counter = 0; counter < result.Counters.size(); counter++)
+    {
+      fprintf(pFile, "%s", (counter != 0) ? ", " : "");
+      write_json_string(pFile, result.Counters[counter].Name + "_per_event");
+      fprintf(pFile, ": %.17g", (double)result.Counters[counter].Count / (double)result.Events);
+    }
+    fprintf(pFile, "}}");
+  }
+  fprintf(pFile, "\n ]\n}\n");
+
+  return (fclose(pFile) == 0);
+}
+
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Parse the command line options of the benchmark.
+ *
+ * \param argc int        number of arguments
+ * \param argv char*[]    arguments
+ *
+ */
+void bench_init(int argc, char* argv[])
+{
+  Program = argv[0];
+  Program = Program.substr(Program.find_last_of("/\\") + 1);
+
+  for(int index = 1; index < argc; index++)
+  {
+    const char* const pArgument = argv[index];
+
+    if(strncmp(pArgument, "--filter=", 9) == 0)
+    {
+      Options.Filter = pArgument + 9;
+    }
+    else if(strncmp(pArgument, "--min-time=", 11) == 0)
+    {
+      Options.Min_Time = atof(pArgument + 11) * 1e6;
+    }
+    else if(strncmp(pArgument, "--repetitions=", 14) == 0)
+    {
+      Options.Repetitions = (uint32_t)strtoul(pArgument + 14, NULL, 10);
+      Options.Repetitions = std::max(Options.Repetitions, 1u);
+    }
+    else if(strcmp(pArgument, "--perf") == 0)
+    {
+      Options.Perf = true;
+    }
+    else if(strncmp(pArgument, "--json=", 7) == 0)
+    {
+      Options.Json = pArgument + 7;
+    }
+    else
+    {
+      print_usage(argv[0]);
+      exit((strcmp(pArgument, "--help") == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+  }
+
+  // Without counters, e.g. in a virtual machine or with perf_event_paranoid > 2, the benchmarks run without them.
+  Perf_Open = Options.Perf && open_perf_counters();
+}
+
+/** \brief Check if the case is selected by the filter. Use it to skip the setup of the cases that don't run.
+ *
+ * \param name const std::string&   name of benchmark case
+ * \return bool                     true if the case runs
+ *
+ */
+bool bench_selected(const std::string& name)
+{
+  return name.find(Options.Filter) != std::string::npos;
+}
+
+/** \brief Calibrate and measure a benchmark case, then print its result.
+ *
+ * \param name const std::string&             name of benchmark case, "group/parameter:value/..."
+ * \param function const bench_function_t&    measured code
+ *
+ */
+void bench_run(const std::string& name, const bench_function_t& function)
+{
+  if(!bench_selected(name))
+  {
+    return;
+  }
+
+  // Grow the iterations till a run takes the minimum time.
+  uint64_t iterations = 1;
+  while(iterations < MAX_ITERATIONS)
+  {
+    const run_t run = measure(function, iterations);
+    if(run.Ns >= Options.Min_Time)
+    {
+      break;
+    }
+
+    const double scale = (run.Ns > 0) ? 1.5 * Options.Min_Time / run.Ns : 10;
+    iterations = (uint64_t)std::ceil((double)iterations * std::min(std::max(scale, 2.0), 10.0));
+  }
+
+  result_t result;
+  result.Name = name;
+  result.Iterations = iterations;
+  result.Events = 0;
+  pActive_Counters = &result.Counters;
+
+  for(uint32_t repetition = 0; repetition < Options.Repetitions; repetition++)
+  {
+    const run_t run = measure(function, iterations);
+    const double events = (double)std::max(run.Events, UINT64_C(1));
+    result.Events += run.Events;
+    result.Ns_Per_Event.push_back(run.Ns / events);
+    result.Cycles_Per_Event.push_back(run.Cycles / events);
+    for(uint32_t counter = 0; counter < PERF_COUNTERS; counter++)
+    {
+      if(run.Perf.Valid[counter])
+      {
+        result.Perf_Per_Event[counter].push_back((double)run.Perf.Count[counter] / events);
+      }
+    }
+  }
+
+  pActive_Counters = NULL;
+  Results.push_back(result);
+  report(result);
+}
+
+/** \brief Add to a counter of the measured case, e.g. the number of entry actions.
+ *  The counter is reported per event. Counts of the calibration runs are ignored.
+ *
+ * \param counter const std::string&    name of counter
+ * \param count uint64_t                count to add
+ *
+ */
+void bench_count(const std::string& counter, uint64_t count)
+{
+  if(pActive_Counters == NULL)
+  {
+    return;
+  }
+
+  for(counter_t& active : *pActive_Counters)
+  {
+    if(active.Name == counter)
+    {
+      active.Count += count;
+      return;
+    }
+  }
+  pActive_Counters->push_back(counter_t{counter, count});
+}
+
+/** \brief Finish the benchmark.
+ *
+ * \return int    exit code of the benchmark, failure if the filter has selected no case
+ *
+ */
+int bench_finish(void)
+{
+  close_perf_counters();
+  if(Results.empty())
+  {
+    fprintf(stderr, "No benchmark matches the filter \"%s\"\n", Options.Filter.c_str());
+    return EXIT_FAILURE;
+  }
+
+  if(!Options.Json.empty() && !write_json(Options.Json))
+  {
+    fprintf(stderr, "Failed to write the results to \"%s\"\n", Options.Json.c_str());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,48 @@
+/**
+ * \file
+ * \brief Harness of the framework benchmarks
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+/** \brief Measured code of a benchmark case.
+ *
+ * \param iterations uint64_t   number of iterations to run
+ * \return uint64_t             number of events processed by the iterations
+ *
+ */
+typedef std::function<uint64_t(uint64_t iterations)> bench_function_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+extern void bench_init(int argc, char* argv[]);
+
+extern bool bench_selected(const std::string& name);
+
+extern void bench_run(const std::string& name, const bench_function_t& function);
+
+extern void bench_count(const std::string& counter, uint64_t count);
+
+extern int bench_finish(void);
+
+#endif // BENCH_H
@@ -0,0 +1,557 @@
+/**
+ * \file
+ * \brief Comparison of two benchmark results with regression detection
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// Usage: bench_compare [options] <baseline.json> <contender.json>
+// Compares the JSON results written by the benchmarks with --json, case by case.
+//
+// The measured runs of a case in both results are compared with the Mann-Whitney U test, exact for
+// the runs without ties and normal approximation with tie correction otherwise. A case regresses when
+// the test finds the runs different and the median of the contender is slower than the threshold.
+// It needs enough repetitions: with 5 runs on each side the smallest p-value is 0.008, with 3 runs 0.1.
+//
+// Options:
+//   --metric=<name>       samples to compare, default ns_per_event. Also cycles_per_event and
+//                         perf_<counter>_per_event of the results measured with --perf
+//   --threshold=<n>       change of the median in percent that is a regression, default 5
+//   --alpha=<p>           significance level of the test, default 0.05
+//
+// Returns failure if any case regresses.
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ *  --------------------- ENUMERATION ---------------------
+ */
+
+namespace
+{
+
+typedef enum
+{
+  JSON_NULL,
+  JSON_BOOL,
+  JSON_NUMBER,
+  JSON_STRING,
+  JSON_ARRAY,
+  JSON_OBJECT,
+}json_type_t;
+
+typedef enum
+{
+  VERDICT_SAME,
+  VERDICT_REGRESSION,
+  VERDICT_IMPROVEMENT,
+}verdict_t;
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+typedef struct json_value_t
+{
+  json_type_t Type;
+  double Number;
+  std::string String;
+  std::vector<json_value_t> Items;                                  //!< Values of array
+  std::vector<std::pair<std::string, json_value_t>> Members;        //!< Members of object
+}json_value_t;
+
+typedef struct
+{
+  const char* pText;
+  const char* pError;       //!< First syntax error, NULL if none
+}json_parser_t;
+
+typedef struct
+{
+  std::string Metric;
+  double Threshold;         //!< Percent
+  double Alpha;
+  const char* pBaseline;
+  const char* pContender;
+}options_t;
+
+typedef struct
+{
+  double U;                 //!< Pairs of runs where the contender is slower, ties count half
+  double P_Value;           //!< Two sided
+  double Min_P_Value;       //!< Smallest p-value possible with the number of runs
+}mann_whitney_t;
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+options_t Options = {"ns_per_event", 5, 0.05, NULL, NULL};
+
+const char* const Verdict_Names[] = {"same", "REGRESSION", "improvement"};
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+void print_usage(const char* pProgram)
+{
+  fprintf(stderr, "Usage: %s [--metric=<name>] [--threshold=<percent>] [--alpha=<p>] <baseline.json> <contender.json>\n",
+          pProgram);
+}
+
+void parse_options(int argc, char* argv[])
+{
+  for(int index = 1; index < argc; index++)
+  {
+    const char* const pArgument = argv[index];
+
+    if(strncmp(pArgument, "--metric=", 9) == 0)
+    {
+      Options.Metric = pArgument + 9;
+    }
+    else if(strncmp(pArgument, "--threshold=", 12) == 0)
+    {
+      Options.Threshold = atof(pArgument + 12);
+    }
+    else if(strncmp(pArgument, "--alpha=", 8) == 0)
+    {
+      Options.Alpha = atof(pArgument + 8);
+    }
+    else if((strncmp(pArgument, "--", 2) != 0) && (Options.pBaseline == NULL))
+    {
+      Options.pBaseline = pArgument;
+    }
+    else if((strncmp(pArgument, "--", 2) != 0) && (Options.pContender == NULL))
+    {
+      Options.pContender = pArgument;
+    }
+    else
+    {
+      print_usage(argv[0]);
+      exit((strcmp(pArgument, "--help") == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+  }
+
+  if(Options.pContender == NULL)
+  {
+    print_usage(argv[0]);
+    exit(EXIT_FAILURE);
+  }
+}
+
+/* --------------------- JSON --------------------- */
+
+// Parser of the JSON written by the benchmark harness. It accepts standard JSON,
+// except the \u escapes of the strings that the harness doesn't write.
+
+void skip_space(json_parser_t* const pParser)
+{
+  while(isspace((unsigned char)*pParser->pText))
+  {
+    pParser->pText++;
+  }
+}
+
+bool fail(json_parser_t* const pParser, const char* pError)
+{
+  if(pParser->pError == NULL)
+  {
+    pParser->pError = pError;
+  }
+  return false;
+}
+
+bool expect(json_parser_t* const pParser, char character)
+{
+  skip_space(pParser);
+  if(*pParser->pText != character)
+  {
+    return false;
+  }
+  pParser->pText++;
+  return true;
+}
+
+bool parse_string(json_parser_t* const pParser, std::string* const pString)
+{
+  if(!expect(pParser, '"'))
+  {
+    return fail(pParser, "expected string");
+  }
+
+  pString->clear();
+  while(*pParser->pText != '"')
+  {
+    char character = *pParser->pText++;
+    if(character == '\0')
+    {
+      return fail(pParser, "unterminated string");
+    }
+    if(character == '\\')
+    {
+      character = *pParser->pText++;
+      switch(character)
+      {
+      case 'n': character = '\n'; break;
+      case 't': character = '\t'; break;
+      case 'r': character = '\r'; break;
+      case 'b': character = '\b'; break;
+      case 'f': character = '\f'; break;
+      case '"':
+      case '\\':
+      case '/':
+        break;
+      default:
+        return fail(pParser, "unsupported escape in string");
+      }
+    }
+    pString->push_back(character);
+  }
+  pParser->pText++;
+  return true;
+}
+
+bool parse_value(json_parser_t* const pParser, json_value_t* const pValue)
+{
+  skip_space(pParser);
+  pValue->Type = JSON_NULL;
+
+  const char character = *pParser->pText;
+  if(character == '{')
+  {
+    pParser->pText++;
+    pValue->Type = JSON_OBJECT;
+    if(expect(pParser, '}'))
+    {
+      return true;
+    }
+    do
+    {
+      std::pair<std::string, json_value_t> member;
+      if(!parse_string(pParser, &member.first) || !expect(pParser, ':')
+         || !parse_value(pParser, &member.second))
+      {
+        return fail(pParser, "expected member of object");
+      }
+      pValue->Members.push_back(std::move(member));
+    }while(expect(pParser, ','));
+    return expect(pParser, '}') || fail(pParser, "expected '}'");
+  }
+
+  if(character == '[')
+  {
+    pParser->pText++;
+    pValue->Type = JSON_ARRAY;
+    if(expect(pParser, ']'))
+    {
+      return true;
+    }
+    do
+    {
+      pValue->Items.emplace_back();
+      if(!parse_value(pParser, &pValue->Items.back()))
+      {
+        return false;
+      }
+    }while(expect(pParser, ','));
+    return expect(pParser, ']') || fail(pParser, "expected ']'");
+  }
+
+  if(character == '"')
+  {
+    pValue->Type = JSON_STRING;
+    return parse_string(pParser, &pValue->String);
+  }
+
+  static const char* const Literals[] = {"null", "true", "false"};
+  for(const char* pLiteral : Literals)
+  {
+    if(strncmp(pParser->pText, pLiteral, strlen(pLiteral)) == 0)
+    {
+      pParser->pText += strlen(pLiteral);
+      pValue->Type = (pLiteral[0] == 'n') ? JSON_NULL : JSON_BOOL;
+      pValue->Number = (pLiteral[0] == 't') ? 1 : 0;
+      return true;
+    }
+  }
+
+  char* pEnd;
+  pValue->Number = strtod(pParser->pText, &pEnd);
+  if(pEnd == pParser->pText)
+  {
+    return fail(pParser, "expected value");
+  }
+  pValue->Type = JSON_NUMBER;
+  pParser->pText = pEnd;
+  return true;
+}
+
+//! Member of the object, NULL if the value is not an object or has no such member
+const json_value_t* find_member(const json_value_t& object, const char* pName)
+{
+  for(const auto& member : object.Members)
+  {
+    if(member.first == pName)
+    {
+      return &member.second;
+    }
+  }
+  return NULL;
+}
+
+bool read_results(const char* pPath, json_value_t* const pResults)
+{
+  FILE* const pFile = fopen(pPath, "rb");
+  if(pFile == NULL)
+  {
+    fprintf(stderr, "Failed to open \"%s\"\n", pPath);
+    return false;
+  }
+
+  std::string text;
+  char buffer[4096];
+  size_t length;
+  while((length = fread(buffer, 1, sizeof(buffer), pFile)) != 0)
+  {
+    text.append(buffer, length);
+  }
+  fclose(pFile);
+
+  json_parser_t parser = {text.c_str(), NULL};
+  if(!parse_value(&parser, pResults) || (skip_space(&parser), *parser.pText != '\0'))
+  {
+    fprintf(stderr, "%s: %s at offset %zu\n", pPath, (parser.pError != NULL) ? parser.pError : "unexpected text",
+            (size_t)(parser.pText - text.c_str()));
+    return false;
+  }
+
+  const json_value_t* const pCases = find_member(*pResults, "cases");
+  if((pCases == NULL) || (pCases->Type != JSON_ARRAY))
+  {
+    fprintf(stderr, "%s: no benchmark cases, write it with the --json option of the benchmarks\n", pPath);
+    return false;
+  }
+  return true;
+}
+
+//! Samples of the metric in the case, empty if the case has none
+std::vector<double> get_samples(const json_value_t& benchmark_case)
+{
+  std::vector<double> samples;
+  const json_value_t* const pSamples = find_member(benchmark_case, "samples");
+  const json_value_t* const pMetric = (pSamples != NULL) ? find_member(*pSamples, Options.Metric.c_str()) : NULL;
+  if(pMetric != NULL)
+  {
+    for(const json_value_t& sample : pMetric->Items)
+    {
+      samples.push_back(sample.Number);
+    }
+  }
+  return samples;
+}
+
+/* --------------------- STATISTICS --------------------- */
+
+double median(std::vector<double> values)
+{
+  std::sort(values.begin(), values.end());
+  const size_t middle = values.size() / 2;
+  return (values.size() % 2) ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+double normal_cdf(double value)
+{
+  return 0.5 * std::erfc(-value / std::sqrt(2.0));
+}
+
+/** \brief Mann-Whitney U test of the contender against the baseline runs.
+ *
+ * \param baseline const std::vector<double>&    runs of the baseline
+ * \param contender const std::vector<double>&   runs of the contender
+ * \return mann_whitney_t                        U of the contender and the two sided p-value
+ *
+ */
+mann_whitney_t mann_whitney(const std::vector<double>& baseline, const std::vector<double>& contender)
+{
+  const size_t n1 = contender.size();
+  const size_t n2 = baseline.size();
+  mann_whitney_t test = {0, 1, 1};
+
+  for(const double value : contender)
+  {
+    for(const double reference : baseline)
+    {
+      test.U += (value > reference) ? 1 : ((value == reference) ? 0.5 : 0);
+    }
+  }
+
+  // Tied runs, within or between the samples, reduce the variance of U.
+  bool ties = false;
+  std::vector<double> all(baseline);
+  all.insert(all.end(), contender.begin(), contender.end());
+  std::sort(all.begin(), all.end());
+  double tie_sum = 0;
+  for(size_t start = 0; start < all.size();)
+  {
+    size_t end = start;
+    while((end < all.size()) && (all[end] == all[start]))
+    {
+      end++;
+    }
+    const double count = (double)(end - start);
+    tie_sum += count * count * count - count;
+    ties = ties || (count > 1);
+    start = end;
+  }
+
+  const size_t pairs = n1 * n2;
+  if(!ties && (n1 + n2 <= 60))
+  {
+    // Exact distribution of U over the orderings of the runs. Ways[m][u] is the number of orderings
+    // of m contender runs and the baseline runs so far that give U = u. The largest run is either a
+    // contender run above all the n baseline runs, adding n to U, or a baseline run, adding none.
+    std::vector<std::vector<double>> ways(n1 + 1, std::vector<double>(pairs + 1, 0));
+    for(size_t runs = 0; runs <= n1; runs++)
+    {
+      ways[runs][0] = 1;
+    }
+    for(size_t n = 1; n <= n2; n++)
+    {
+      for(size_t runs = 1; runs <= n1; runs++)
+      {
+        for(size_t u = pairs + 1; u-- > n;)
+        {
+          ways[runs][u] += ways[runs - 1][u - n];
+        }
+      }
+    }
+
+    double total = 0;
+    double lower = 0;
+    double upper = 0;
+    for(size_t u = 0; u <= pairs; u++)
+    {
+      total += ways[n1][u];
+      lower += ((double)u <= test.U) ? ways[n1][u] : 0;
+      upper += ((double)u >= test.U) ? ways[n1][u] : 0;
+    }
+    test.P_Value = std::min(1.0, 2 * std::min(lower, upper) / total);
+    test.Min_P_Value = std::min(1.0, 2 / total);
+    return test;
+  }
+
+  const double mean = (double)pairs / 2;
+  const double variance = (double)pairs / 12
+                          * ((double)(n1 + n2 + 1) - tie_sum / (double)((n1 + n2) * (n1 + n2 - 1)));
+  if(variance > 0)
+  {
+    const double z = (std::fabs(test.U - mean) - 0.5) / std::sqrt(variance);
+    test.P_Value = std::min(1.0, 2 * (1 - normal_cdf(std::max(z, 0.0))));
+    test.Min_P_Value = std::min(1.0, 2 * (1 - normal_cdf((mean - 0.5) / std::sqrt(variance))));
+  }
+  return test;
+}
+
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+int main(int argc, char* argv[])
+{
+  parse_options(argc, argv);
+
+  json_value_t baseline;
+  json_value_t contender;
+  if(!read_results(Options.pBaseline, &baseline) || !read_results(Options.pContender, &contender))
+  {
+    return EXIT_FAILURE;
+  }
+
+  const json_value_t& baseline_cases = *find_member(baseline, "cases");
+  const json_value_t& contender_cases = *find_member(contender, "cases");
+
+  printf("%-60s %12s %12s %9s %9s  %s\n", "benchmark", "baseline", "contender", "change", "p-value",
+         Options.Metric.c_str());
+
+  uint32_t regressions = 0;
+  uint32_t improvements = 0;
+  uint32_t compared = 0;
+  bool too_few_runs = false;
+  for(const json_value_t& contender_case : contender_cases.Items)
+  {
+    const json_value_t* const pName = find_member(contender_case, "name");
+    if((pName == NULL) || (pName->Type != JSON_STRING))
+    {
+      continue;
+    }
+
+    const json_value_t* pBaseline_Case = NULL;
+    for(const json_value_t& baseline_case : baseline_cases.Items)
+    {
+      const json_value_t* const pBaseline_Name = find_member(baseline_case, "name");
+      if((pBaseline_Name != NULL) && (pBaseline_Name->String == pName->String))
+      {
+        pBaseline_Case = &baseline_case;
+        break;
+      }
+    }
+
+    const std::vector<double> contender_samples = get_samples(contender_case);
+    const std::vector<double> baseline_samples = (pBaseline_Case != NULL) ? get_samples(*pBaseline_Case)
+                                                                         : std::vector<double>();
+    if(contender_samples.empty() || baseline_samples.empty())
+    {
+      printf("%-60s %12s\n", pName->String.c_str(), (pBaseline_Case == NULL) ? "new" : "no samples");
+      continue;
+    }
+
+    const double baseline_median = median(baseline_samples);
+    const double contender_median = median(contender_samples);
+    const double change = (baseline_median != 0) ? 100 * (contender_median - baseline_median) / baseline_median : 0;
+    const mann_whitney_t test = mann_whitney(baseline_samples, contender_samples);
+
+    verdict_t verdict = VERDICT_SAME;
+    if(test.P_Value < Options.Alpha)
+    {
+      verdict = (change > Options.Threshold) ? VERDICT_REGRESSION
+                : ((change < -Options.Threshold) ? VERDICT_IMPROVEMENT : VERDICT_SAME);
+    }
+    regressions += (verdict == VERDICT_REGRESSION) ? 1 : 0;
+    improvements += (verdict == VERDICT_IMPROVEMENT) ? 1 : 0;
+    too_few_runs = too_few_runs || (test.Min_P_Value >= Options.Alpha);
+    compared++;
+
+    printf("%-60s %12.2f %12.2f %+8.1f%% %9.4f  %s\n", pName->String.c_str(), baseline_median, contender_median,
+           change, test.P_Value, Verdict_Names[verdict]);
+  }
+
+  printf("%u cases compared, %u regressions, %u improvements beyond %g%% at p < %g\n", compared, regressions,
+         improvements, Options.Threshold, Options.Alpha);
+  if(too_few_runs)
+  {
+    printf("Too few runs to find a significant change in some cases, measure with more --repetitions\n");
+  }
+  return (regressions == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,53 @@
+/**
+ * \file
+ * \brief Random numbers of the benchmarks, deterministic from a seed
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef BENCH_RANDOM_H
+#define BENCH_RANDOM_H
+
+// The numbers come from splitmix64 and are reduced without the standard library distributions,
+// so the same seed gives the same sequence on every platform.
+
+#include <cstdint>
+
+/*
+ *  --------------------- Inline functions ---------------------
+ */
+
+/** \brief Next random number of splitmix64.
+ *
+ * \param pSeed uint64_t* const   state of the generator
+ * \return uint64_t               random number
+ *
+ */
+static inline uint64_t next_random(uint64_t* const pSeed)
+{
+  uint64_t value = (*pSeed += UINT64_C(0x9E3779B97F4A7C15));
+  value = (value ^ (value >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+  value = (value ^ (value >> 27)) * UINT64_C(0x94D049BB133111EB);
+  return value ^ (value >> 31);
+}
+
+/** \brief Random number from 0 to bound - 1.
+ *
+ * \param pSeed uint64_t* const   state of the generator
+ * \param bound uint32_t          upper bound, excluded
+ * \return uint32_t               random number
+ *
+ */
+static inline uint32_t random_below(uint64_t* const pSeed, uint32_t bound)
+{
+  return (uint32_t)(((next_random(pSeed) >> 32) * bound) >> 32);
+}
+
+#endif // BENCH_RANDOM_H
@@ -0,0 +1,263 @@
+/**
+ * \file
+ * \brief Throughput benchmark of dispatch_event
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// Each iteration sets the event of the pending state machines and calls dispatch_event once.
+// The cases vary one parameter at a time around 256 state machines with 10% pending events:
+//   machines   number of state machines in the array passed to dispatch_event
+//   pending    percentage of state machines with an event
+//   chain      TRIGGERED_TO_SELF results before the handler returns EVENT_HANDLED
+//   bubble     parent states the event bubbles up to before it is handled (HSM only)
+// Each TRIGGERED_TO_SELF is counted as an event, as it dispatches the event again.
+//
+// The generated cases dispatch random events to 64 state machines running a generated state machine
+// of the given number of states, see state_generator.h. Their working set grows with the states.
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "hsm.h"
+#include "state_generator.h"
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#if HIERARCHICAL_STATES
+#define ENGINE_NAME         "hsm"
+#else
+#define ENGINE_NAME         "fsm"
+#endif // HIERARCHICAL_STATES
+
+#define MAX_BUBBLE_DEPTH    8u
+#define GENERATED_MACHINES  64u
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+namespace
+{
+
+enum
+{
+  BENCH_EVENT = 1,
+};
+
+//! State machine of the benchmark
+typedef struct
+{
+  state_machine_t Machine;
+  uint32_t Chain_Left;      //!< TRIGGERED_TO_SELF results left for the pending event
+}bench_machine_t;
+
+/*
+ *  --------------------- STATE HANDLERS ---------------------
+ */
+
+state_machine_result_t handle_event(state_machine_t* const pState_Machine)
+{
+  bench_machine_t* const pMachine = reinterpret_cast<bench_machine_t*>(pState_Machine);
+  if(pMachine->Chain_Left != 0)
+  {
+    pMachine->Chain_Left--;
+    return TRIGGERED_TO_SELF;
+  }
+  return EVENT_HANDLED;
+}
+
+#if HIERARCHICAL_STATES
+state_machine_result_t pass_event(state_machine_t* const)
+{
+  return EVENT_UN_HANDLED;
+}
+
+//! Path of nested states, the event of state at index n bubbles up n levels to the top state.
+extern const state_t Nested_States[MAX_BUBBLE_DEPTH + 1];
+
+const state_t Nested_States[MAX_BUBBLE_DEPTH + 1] =
+{
+  {handle_event, NULL, NULL, NULL, NULL, 0},
+  {pass_event, NULL, NULL, &Nested_States[0], NULL, 1},
+  {pass_event, NULL, NULL, &Nested_States[1], NULL, 2},
+  {pass_event, NULL, NULL, &Nested_States[2], NULL, 3},
+  {pass_event, NULL, NULL, &Nested_States[3], NULL, 4},
+  {pass_event, NULL, NULL, &Nested_States[4], NULL, 5},
+  {pass_event, NULL, NULL, &Nested_States[5], NULL, 6},
+  {pass_event, NULL, NULL, &Nested_States[6], NULL, 7},
+  {pass_event, NULL, NULL, &Nested_States[7], NULL, 8},
+};
+#else
+const state_t Nested_States[1] =
+{
+  {handle_event, NULL, NULL},
+};
+#endif // HIERARCHICAL_STATES
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+void run_dispatch(uint32_t machines, uint32_t pending_percent, uint32_t chain, uint32_t bubble)
+{
+  const std::string name = std::string(ENGINE_NAME "/dispatch/machines:") + std::to_string(machines)
+                           + "/pending:" + std::to_string(pending_percent) + "%"
+                           + "/chain:" + std::to_string(chain) + "/bubble:" + std::to_string(bubble);
+  if(!bench_selected(name))
+  {
+    return;
+  }
+
+  std::vector<bench_machine_t> pool(machines, bench_machine_t());
+  std::vector<state_machine_t*> list(machines);
+  for(uint32_t index = 0; index < machines; index++)
+  {
+    pool[index].Machine.State = &Nested_States[bubble];
+    list[index] = &pool[index].Machine;
+  }
+
+  // Spread the pending state machines evenly over the array.
+  const uint32_t pending_count = std::max(machines * pending_percent / 100, 1u);
+  std::vector<bench_machine_t*> pending(pending_count);
+  for(uint32_t index = 0; index < pending_count; index++)
+  {
+    pending[index] = &pool[(uint64_t)index * machines / pending_count];
+  }
+
+  bench_run(name, [&](uint64_t iterations)
+  {
+    for(uint64_t iteration = 0; iteration < iterations; iteration++)
+    {
+      for(bench_machine_t* const pMachine : pending)
+      {
+        pMachine->Machine.Event = BENCH_EVENT;
+        pMachine->Chain_Left = chain;
+      }
+
+      if(dispatch_event(list.data(), machines) != EVENT_HANDLED)
+      {
+        fprintf(stderr, "%s: dispatch_event failed\n", name.c_str());
+        exit(EXIT_FAILURE);
+      }
+    }
+    return iterations * pending_count * (chain + 1);
+  });
+}
+
+void run_generated(uint32_t states)
+{
+  const std::string name = std::string(ENGINE_NAME "/dispatch/generated/states:") + std::to_string(states);
+  if(!bench_selected(name))
+  {
+    return;
+  }
+
+  const generator_config_t config =
+  {
+    states,
+    16,           // Max_Depth
+    16,           // Max_Fanout
+    16,           // Events
+    10,           // None_Percent
+    30,           // Pass_Percent
+    50,           // Transition_Percent
+    states,       // Seed
+  };
+
+  generated_hsm_t hsm;
+  if(!generate_hsm(&hsm, &config))
+  {
+    fprintf(stderr, "%s: state machine not generated\n", name.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  std::vector<generated_machine_t> pool(GENERATED_MACHINES);
+  std::vector<state_machine_t*> list(GENERATED_MACHINES);
+  for(uint32_t index = 0; index < GENERATED_MACHINES; index++)
+  {
+    init_generated_machine(&pool[index], &hsm, index % hsm.Top_States);
+    list[index] = &pool[index].Machine;
+  }
+
+  uint64_t seed = config.Seed;
+  bench_run(name, [&](uint64_t iterations)
+  {
+    uint64_t transitions = 0;
+    for(uint64_t iteration = 0; iteration < iterations; iteration++)
+    {
+      generated_machine_t* const pMachine = &pool[random_below(&seed, GENERATED_MACHINES)];
+      pMachine->Machine.Event = random_below(&seed, hsm.Events) + 1;
+      const uint64_t before = pMachine->Transitions;
+
+      if(dispatch_event(list.data(), GENERATED_MACHINES) != EVENT_HANDLED)
+      {
+        fprintf(stderr, "%s: dispatch_event failed\n", name.c_str());
+        exit(EXIT_FAILURE);
+      }
+      transitions += pMachine->Transitions - before;
+    }
+
+    bench_count("transitions", transitions);
+    return iterations;
+  });
+
+  free_generated_hsm(&hsm);
+}
+
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+int main(int argc, char* argv[])
+{
+  bench_init(argc, argv);
+
+  for(uint32_t machines : {1u, 16u, 256u, 4096u})
+  {
+    run_dispatch(machines, 10, 0, 0);
+  }
+
+  for(uint32_t pending_percent : {1u, 50u, 100u})
+  {
+    run_dispatch(256, pending_percent, 0, 0);
+  }
+
+  for(uint32_t chain : {1u, 4u, 16u})
+  {
+    run_dispatch(256, 10, chain, 0);
+  }
+
+#if HIERARCHICAL_STATES
+  for(uint32_t bubble : {1u, 2u, 4u, MAX_BUBBLE_DEPTH})
+  {
+    run_dispatch(256, 10, 0, bubble);
+  }
+#endif // HIERARCHICAL_STATES
+
+  for(uint32_t states : {1000u, 100000u, 1000000u})
+  {
+    run_generated(states);
+  }
+
+  return bench_finish();
+}
@@ -0,0 +1,257 @@
+/**
+ * \file
+ * \brief Replay of a recorded event stream on fresh state machines
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// Usage: event_replay [options] <stream file>
+// Feeds an event stream recorded by the HSM_TRACE_POST hook, see event_stream.h, through the posting path:
+// each record allocates an event object of the recorded payload size, posts it to its state machine and
+// dispatches it. The state machines are a generated state machine, see state_generator.h, one for each
+// machine index of the stream. The recorded events are folded in to the events 1 to --events of the generated
+// state machine.
+//
+// At the recorded speed, record n is due at the sum of the inter-arrival times up to n and its latency runs
+// from the due time to the return of dispatch_event, as in oven_fleet. As fast as possible, the latency runs
+// from the allocation of the event object.
+//
+// Options:
+//   --speed=recorded|max   replay at the recorded inter-arrival times or as fast as possible, default max
+//   --states=<n>           states of the generated state machine, default 1000
+//   --events=<n>           events of the generated state machine, default 16
+//   --seed=<n>             seed of the generated state machine, default 1
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "event_stream.h"
+#include "hdr_histogram.h"
+#include "hsm.h"
+#include "hsm_event.h"
+#include "hsm_port.h"
+#include "state_generator.h"
+
+#if !HSM_EVENT_OBJECTS
+#error "event_replay requires HSM_EVENT_OBJECTS"
+#endif
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define POOL_CAPACITY     16u     //!< Each event is dispatched before the next one is posted
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+namespace
+{
+
+typedef struct
+{
+  bool Recorded_Speed;
+  uint32_t States;
+  uint32_t Events;
+  uint64_t Seed;
+  const char* pStream;
+}options_t;
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+options_t Options = {false, 1000, 16, 1, NULL};
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+void print_usage(const char* pProgram)
+{
+  fprintf(stderr, "Usage: %s [--speed=recorded|max] [--states=<n>] [--events=<n>] [--seed=<n>] <stream file>\n",
+          pProgram);
+}
+
+void parse_options(int argc, char* argv[])
+{
+  for(int index = 1; index < argc; index++)
+  {
+    const char* const pArgument = argv[index];
+
+    if((strcmp(pArgument, "--speed=recorded") == 0) || (strcmp(pArgument, "--speed=max") == 0))
+    {
+      Options.Recorded_Speed = (strcmp(pArgument, "--speed=recorded") == 0);
+    }
+    else if(strncmp(pArgument, "--states=", 9) == 0)
+    {
+      Options.States = (uint32_t)strtoul(pArgument + 9, NULL, 10);
+    }
+    else if(strncmp(pArgument, "--events=", 9) == 0)
+    {
+      Options.Events = (uint32_t)strtoul(pArgument + 9, NULL, 10);
+    }
+    else if(strncmp(pArgument, "--seed=", 7) == 0)
+    {
+      Options.Seed = strtoull(pArgument + 7, NULL, 10);
+    }
+    else if((strncmp(pArgument, "--", 2) != 0) && (Options.pStream == NULL))
+    {
+      Options.pStream = pArgument;
+    }
+    else
+    {
+      print_usage(argv[0]);
+      exit((strcmp(pArgument, "--help") == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+  }
+
+  if((Options.pStream == NULL) || (Options.States == 0) || (Options.Events == 0))
+  {
+    print_usage(argv[0]);
+    exit(EXIT_FAILURE);
+  }
+}
+
+void print_latency(const char* pName, const hdr_histogram_t* const pHistogram)
+{
+  printf("%-12s", pName);
+  for(double percentile : {50.0, 90.0, 99.0, 99.9, 99.99})
+  {
+    printf(" p%g=%llu", percentile, (unsigned long long)get_hdr_percentile(pHistogram, percentile));
+  }
+  printf(" max=%llu mean=%.0f\n", (unsigned long long)pHistogram->Max,
+         (pHistogram->Count != 0) ? pHistogram->Sum / (double)pHistogram->Count : 0);
+}
+
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+int main(int argc, char* argv[])
+{
+  parse_options(argc, argv);
+
+  std::vector<stream_record_t> records;
+  if(!read_event_stream(Options.pStream, &records) || records.empty())
+  {
+    fprintf(stderr, "\"%s\" is not an event stream or has no record\n", Options.pStream);
+    return EXIT_FAILURE;
+  }
+
+  uint32_t machines = 0;
+  uint32_t max_payload = 0;
+  uint64_t recorded = 0;
+  uint64_t payload = 0;
+  for(const stream_record_t& record : records)
+  {
+    machines = std::max(machines, record.Machine + 1);
+    max_payload = std::max(max_payload, record.Payload_Size);
+    recorded += record.Inter_Arrival;
+    payload += record.Payload_Size;
+  }
+
+  generator_config_t config =
+  {
+    Options.States,
+    8,          // Max_Depth
+    8,          // Max_Fanout
+    Options.Events,
+    10,         // None_Percent
+    30,         // Pass_Percent
+    40,         // Transition_Percent
+    Options.Seed,
+  };
+  generated_hsm_t hsm;
+  if(!generate_hsm(&hsm, &config))
+  {
+    fprintf(stderr, "%u states don't fit in the generated state machine\n", Options.States);
+    return EXIT_FAILURE;
+  }
+
+  std::vector<generated_machine_t> fleet(machines);
+  for(uint32_t index = 0; index < machines; index++)
+  {
+    init_generated_machine(&fleet[index], &hsm, index % hsm.Top_States);
+  }
+
+  // Blocks are aligned to 8 bytes, the payload of an event object follows its header.
+  const uint32_t block_size = (uint32_t)((sizeof(event_t) + max_payload + 7) & ~(size_t)7);
+  std::vector<uint64_t> storage((size_t)block_size * POOL_CAPACITY / sizeof(uint64_t));
+  event_pool_t pool;
+  init_event_pool(&pool, storage.data(), block_size, POOL_CAPACITY);
+
+  hdr_histogram_t latency;
+  init_hdr_histogram(&latency);
+
+  const uint64_t start = HSM_TIMESTAMP();
+  uint64_t due = start;
+  for(const stream_record_t& record : records)
+  {
+    generated_machine_t* const pMachine = &fleet[record.Machine];
+    const uint32_t event = (uint32_t)(((uint64_t)record.Event + Options.Events - 1) % Options.Events) + 1;
+
+    uint64_t begin = HSM_TIMESTAMP();
+    if(Options.Recorded_Speed)
+    {
+      // Wait for the due time, unless the replay is behind the recording.
+      due += ns_to_timestamp(record.Inter_Arrival);
+      while(begin < due)
+      {
+        begin = HSM_TIMESTAMP();
+      }
+      begin = due;
+    }
+
+    event_t* const pEvent = allocate_event(&pool, event);
+    memset(reinterpret_cast<uint8_t*>(pEvent) + sizeof(event_t), 0, record.Payload_Size);
+    post_event(&pMachine->Machine, pEvent);
+
+    state_machine_t* const machineList[] = {&pMachine->Machine};
+    if(dispatch_event(machineList, 1) != EVENT_HANDLED)
+    {
+      fprintf(stderr, "dispatch_event failed\n");
+      return EXIT_FAILURE;
+    }
+    record_hdr_value(&latency, timestamp_to_ns(HSM_TIMESTAMP() - begin));
+  }
+  const uint64_t elapsed = timestamp_to_ns(HSM_TIMESTAMP() - start);
+
+  uint64_t transitions = 0;
+  for(const generated_machine_t& machine : fleet)
+  {
+    transitions += machine.Transitions;
+  }
+
+  printf("stream      %zu events to %u machines over %.3f s, %.1f payload bytes/event\n", records.size(),
+         machines, (double)recorded / 1e9, (double)payload / (double)records.size());
+  printf("replay      %s speed, %u states, %.3f s, %.0f events/s", Options.Recorded_Speed ? "recorded" : "max",
+         Options.States, (double)elapsed / 1e9, (double)records.size() * 1e9 / (double)std::max(elapsed, UINT64_C(1)));
+  if(recorded != 0)
+  {
+    printf(", %.2fx the recorded speed", (double)recorded / (double)std::max(elapsed, UINT64_C(1)));
+  }
+  printf("\n            %.2f transitions/event\n", (double)transitions / (double)records.size());
+  printf("latency ns, %s to the return of dispatch_event\n", Options.Recorded_Speed ? "due time" : "allocation");
+  print_latency("latency", &latency);
+
+  free_generated_hsm(&hsm);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,345 @@
+/**
+ * \file
+ * \brief Compact on-disk format of the event streams recorded from the posting path
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "event_stream.h"
+#include "hsm.h"
+#include "hsm_port.h"
+
+#if HSM_EVENT_OBJECTS
+#include "hsm_event.h"
+#endif // HSM_EVENT_OBJECTS
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define STREAM_MAGIC          "HSMSTRM"     //!< With its terminating zero, the first 8 bytes of the file
+#define STREAM_HEADER_SIZE    16u
+#define MAX_VARINT_SIZE       10u           //!< LEB128 bytes of a 64 bit value
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+namespace
+{
+
+#if HSM_EVENT_OBJECTS
+//! Capture of the posted events to a stream file
+typedef struct
+{
+  std::atomic<bool> Active;
+  std::mutex Lock;                                              //!< Serializes the posting threads
+  stream_writer_t Writer;
+  std::unordered_map<const void*, uint32_t> Machines;           //!< Index of each state machine
+  uint64_t Last_Post;                                           //!< HSM_TIMESTAMP() of the previous record
+  uint64_t Lost;                                                //!< Events to unknown state machines or not written
+}capture_t;
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+capture_t Capture;
+#endif // HSM_EVENT_OBJECTS
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+uint32_t encode_varint(uint64_t value, uint8_t* const pBuffer)
+{
+  uint32_t length = 0;
+  while(value >= 0x80)
+  {
+    pBuffer[length++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  pBuffer[length++] = (uint8_t)value;
+  return length;
+}
+
+//! Decode a varint, false at the end of data or on a malformed varint
+bool decode_varint(const uint8_t** const ppData, const uint8_t* const pEnd, uint64_t* const pValue)
+{
+  *pValue = 0;
+  for(uint32_t shift = 0; shift < 7 * MAX_VARINT_SIZE; shift += 7)
+  {
+    if(*ppData == pEnd)
+    {
+      return false;
+    }
+    const uint8_t byte = *(*ppData)++;
+    *pValue |= (uint64_t)(byte & 0x7F) << shift;
+    if((byte & 0x80) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void encode_u32(uint32_t value, uint8_t* const pBuffer)
+{
+  for(uint32_t index = 0; index < 4; index++)
+  {
+    pBuffer[index] = (uint8_t)(value >> (8 * index));
+  }
+}
+
+uint32_t decode_u32(const uint8_t* const pBuffer)
+{
+  return (uint32_t)pBuffer[0] | ((uint32_t)pBuffer[1] << 8) | ((uint32_t)pBuffer[2] << 16)
+         | ((uint32_t)pBuffer[3] << 24);
+}
+
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Convert the ticks of HSM_TIMESTAMP() to ns, the time unit of the stream.
+ *
+ * \param ticks uint64_t    duration in ticks of HSM_TIMESTAMP()
+ * \return uint64_t         duration in ns
+ *
+ */
+uint64_t timestamp_to_ns(uint64_t ticks)
+{
+  // Split in seconds and remainder, so that a long duration doesn't overflow.
+  return (ticks / HSM_TIMESTAMP_FREQUENCY) * UINT64_C(1000000000)
+         + (ticks % HSM_TIMESTAMP_FREQUENCY) * UINT64_C(1000000000) / HSM_TIMESTAMP_FREQUENCY;
+}
+
+/** \brief Convert ns to the ticks of HSM_TIMESTAMP().
+ *
+ * \param ns uint64_t       duration in ns
+ * \return uint64_t         duration in ticks of HSM_TIMESTAMP()
+ *
+ */
+uint64_t ns_to_timestamp(uint64_t ns)
+{
+  return (ns / UINT64_C(1000000000)) * HSM_TIMESTAMP_FREQUENCY
+         + (ns % UINT64_C(1000000000)) * HSM_TIMESTAMP_FREQUENCY / UINT64_C(1000000000);
+}
+
+/** \brief Create the stream file and write its header.
+ *
+ * \param pWriter stream_writer_t* const    writer
+ * \param pPath const char*                 path of the stream file
+ * \return bool                             false if the file can't be written
+ *
+ */
+bool open_stream_writer(stream_writer_t* const pWriter, const char* pPath)
+{
+  pWriter->Records = 0;
+  pWriter->File = fopen(pPath, "wb");
+  if(pWriter->File == NULL)
+  {
+    return false;
+  }
+
+  uint8_t header[STREAM_HEADER_SIZE] = {0};
+  memcpy(header, STREAM_MAGIC, sizeof(STREAM_MAGIC));
+  encode_u32(EVENT_STREAM_VERSION, &header[8]);
+  if(fwrite(header, 1, sizeof(header), pWriter->File) != sizeof(header))
+  {
+    fclose(pWriter->File);
+    pWriter->File = NULL;
+    return false;
+  }
+  return true;
+}
+
+/** \brief Append a record to the stream file.
+ *
+ * \param pWriter stream_writer_t* const          writer
+ * \param pRecord const stream_record_t* const    record
+ * \return bool                                   false on write error
+ *
+ */
+bool write_stream_record(stream_writer_t* const pWriter, const stream_record_t* const pRecord)
+{
+  uint8_t buffer[4 * MAX_VARINT_SIZE];
+  uint32_t length = encode_varint(pRecord->Machine, buffer);
+  length += encode_varint(pRecord->Event, &buffer[length]);
+  length += encode_varint(pRecord->Payload_Size, &buffer[length]);
+  length += encode_varint(pRecord->Inter_Arrival, &buffer[length]);
+
+  pWriter->Records++;
+  return fwrite(buffer, 1, length, pWriter->File) == length;
+}
+
+/** \brief Close the stream file.
+ *
+ * \param pWriter stream_writer_t* const    writer
+ * \return bool                             false if the buffered records can't be written
+ *
+ */
+bool close_stream_writer(stream_writer_t* const pWriter)
+{
+  const bool written = (fclose(pWriter->File) == 0);
+  pWriter->File = NULL;
+  return written;
+}
+
+/** \brief Read all the records of a stream file.
+ *
+ * \param pPath const char*                         path of the stream file
+ * \param pRecords std::vector<stream_record_t>*    records in posting order
+ * \return bool                                     false if the file can't be read, is not an event stream
+ *                                                  of this version or ends within a record
+ *
+ */
+bool read_event_stream(const char* pPath, std::vector<stream_record_t>* const pRecords)
+{
+  FILE* const pFile = fopen(pPath, "rb");
+  if(pFile == NULL)
+  {
+    return false;
+  }
+
+  std::vector<uint8_t> data;
+  uint8_t buffer[4096];
+  size_t length;
+  while((length = fread(buffer, 1, sizeof(buffer), pFile)) != 0)
+  {
+    data.insert(data.end(), buffer, buffer + length);
+  }
+  fclose(pFile);
+
+  if((data.size() < STREAM_HEADER_SIZE) || (memcmp(data.data(), STREAM_MAGIC, sizeof(STREAM_MAGIC)) != 0)
+     || (decode_u32(&data[8]) != EVENT_STREAM_VERSION))
+  {
+    return false;
+  }
+
+  pRecords->clear();
+  const uint8_t* pData = data.data() + STREAM_HEADER_SIZE;
+  const uint8_t* const pEnd = data.data() + data.size();
+  while(pData != pEnd)
+  {
+    uint64_t fields[4];
+    for(uint64_t& field : fields)
+    {
+      if(!decode_varint(&pData, pEnd, &field))
+      {
+        return false;
+      }
+    }
+    if((fields[0] > UINT32_MAX) || (fields[1] > UINT32_MAX) || (fields[2] > UINT32_MAX))
+    {
+      return false;
+    }
+    pRecords->push_back(stream_record_t{(uint32_t)fields[0], (uint32_t)fields[1], (uint32_t)fields[2], fields[3]});
+  }
+  return true;
+}
+
+#if HSM_EVENT_OBJECTS
+
+/** \brief Start to capture the events posted to the state machines.
+ *  Start it before the threads begin to post.
+ *
+ * \param pPath const char*                 path of the stream file
+ * \param pMachines const void* const[]     state machines, the index in the array is the machine index of the records
+ * \param count uint32_t                    number of state machines
+ * \return bool                             false if the stream file can't be written
+ *
+ */
+bool start_event_capture(const char* pPath, const void* const pMachines[], uint32_t count)
+{
+  std::lock_guard<std::mutex> lock(Capture.Lock);
+  if(!open_stream_writer(&Capture.Writer, pPath))
+  {
+    return false;
+  }
+
+  Capture.Machines.clear();
+  for(uint32_t index = 0; index < count; index++)
+  {
+    Capture.Machines.emplace(pMachines[index], index);
+  }
+  Capture.Last_Post = 0;
+  Capture.Lost = 0;
+  Capture.Active.store(true, std::memory_order_release);
+  return true;
+}
+
+/** \brief Stop the capture and close the stream file. Stop it after the threads have stopped to post.
+ *
+ * \param pRecords uint64_t* const    number of captured records
+ * \return bool                       false if any event is not captured
+ *
+ */
+bool stop_event_capture(uint64_t* const pRecords)
+{
+  std::lock_guard<std::mutex> lock(Capture.Lock);
+  Capture.Active.store(false, std::memory_order_release);
+  *pRecords = Capture.Writer.Records;
+  return close_stream_writer(&Capture.Writer) && (Capture.Lost == 0);
+}
+
+/** \brief Record a posted event in the stream. It is the HSM_TRACE_POST hook, called from any posting thread.
+ *
+ * \param pState_Machine const void*    target state machine
+ * \param pEvent const void*            posted event object
+ *
+ */
+extern "C" void capture_posted_event(const void* pState_Machine, const void* pEvent)
+{
+  if(!Capture.Active.load(std::memory_order_acquire))
+  {
+    return;
+  }
+
+  const event_t* const pObject = static_cast<const event_t*>(pEvent);
+  std::lock_guard<std::mutex> lock(Capture.Lock);
+  if(!Capture.Active.load(std::memory_order_relaxed))
+  {
+    return;     // Capture has stopped while waiting for the lock.
+  }
+
+  const auto machine = Capture.Machines.find(pState_Machine);
+  if(machine == Capture.Machines.end())
+  {
+    Capture.Lost++;
+    return;
+  }
+
+  // The time is taken under the lock, so that the records are in posting order.
+  // Event objects don't carry their size, the capacity of the pool block is recorded as the payload size.
+  const uint64_t now = HSM_TIMESTAMP();
+  const stream_record_t record =
+  {
+    machine->second,
+    pObject->Id,
+    (pObject->Pool != NULL) ? (uint32_t)(pObject->Pool->Block_Size - sizeof(event_t)) : 0,
+    (Capture.Writer.Records != 0) ? timestamp_to_ns(now - Capture.Last_Post) : 0,
+  };
+  Capture.Last_Post = now;
+  Capture.Lost += write_stream_record(&Capture.Writer, &record) ? 0 : 1;
+}
+
+#endif // HSM_EVENT_OBJECTS
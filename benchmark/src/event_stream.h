@@ -0,0 +1,80 @@
+/**
+ * \file
+ * \brief Compact on-disk format of the event streams recorded from the posting path
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// An event stream file is a 16 byte header followed by the records in posting order.
+//   Header: "HSMSTRM" and a zero byte, format version and reserved 0 as 32 bit little endian.
+//   Record: machine index, event, payload size and inter-arrival time, each an unsigned LEB128 varint.
+// The inter-arrival time is in ns since the previous record, 0 for the first record, whatever the
+// frequency of HSM_TIMESTAMP() of the recording. The payload size is the block size of the event pool after
+// the event_t header, as event objects don't carry their own size: it is the capacity of the event object,
+// an upper bound of the payload actually used. Most records take 4 to 7 bytes.
+
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define EVENT_STREAM_VERSION    1u
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! A posted event of the stream
+typedef struct
+{
+  uint32_t Machine;           //!< Index of the target state machine
+  uint32_t Event;
+  uint32_t Payload_Size;      //!< Bytes of the pool block after the event_t header, 0 if the event has no pool
+  uint64_t Inter_Arrival;     //!< ns since the previous record
+}stream_record_t;
+
+typedef struct
+{
+  FILE* File;
+  uint64_t Records;
+}stream_writer_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+extern bool open_stream_writer(stream_writer_t* const pWriter, const char* pPath);
+
+extern bool write_stream_record(stream_writer_t* const pWriter, const stream_record_t* const pRecord);
+
+extern bool close_stream_writer(stream_writer_t* const pWriter);
+
+extern bool read_event_stream(const char* pPath, std::vector<stream_record_t>* const pRecords);
+
+extern uint64_t timestamp_to_ns(uint64_t ticks);
+
+extern uint64_t ns_to_timestamp(uint64_t ns);
+
+// Capture of the posted event objects, in the HSM_TRACE_POST hook of post_event.
+// It is a no-op till the capture starts. The hook is declared in benchmark/capture/hsm_config.h.
+
+extern bool start_event_capture(const char* pPath, const void* const pMachines[], uint32_t count);
+
+extern bool stop_event_capture(uint64_t* const pRecords);
+
+extern "C" void capture_posted_event(const void* pState_Machine, const void* pEvent);
+
+#endif // EVENT_STREAM_H
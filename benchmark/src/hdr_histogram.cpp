@@ -0,0 +1,142 @@
+/**
+ * \file
+ * \brief High dynamic range histogram of the latency benchmarks
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// Same bucketing as the latency histograms of the framework (hsm_histogram.h) with a finer resolution,
+// so the tail percentiles keep three significant digits from nanoseconds to minutes.
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "hdr_histogram.h"
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+namespace
+{
+
+uint32_t get_bucket(uint64_t value)
+{
+  if(value < HDR_SUB_BUCKETS)
+  {
+    return (uint32_t)value;
+  }
+
+  uint32_t msb = 63;
+  while((value >> msb) == 0)
+  {
+    msb--;
+  }
+  if(msb >= HDR_MAX_BITS)
+  {
+    return HDR_BUCKETS - 1;
+  }
+
+  const uint32_t range = msb - HDR_SUB_BUCKET_BITS + 1;
+  return range * HDR_SUB_BUCKETS + (uint32_t)(value >> (range - 1)) - HDR_SUB_BUCKETS;
+}
+
+//! Highest value counted in the bucket
+uint64_t get_bucket_value(uint32_t bucket)
+{
+  if(bucket < HDR_SUB_BUCKETS)
+  {
+    return bucket;
+  }
+
+  const uint32_t range = bucket / HDR_SUB_BUCKETS;
+  const uint64_t sub_bucket = bucket % HDR_SUB_BUCKETS;
+  return ((HDR_SUB_BUCKETS + sub_bucket + 1) << (range - 1)) - 1;
+}
+
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+//! Clear the histogram.
+void init_hdr_histogram(hdr_histogram_t* const pHistogram)
+{
+  pHistogram->Buckets.assign(HDR_BUCKETS, 0);
+  pHistogram->Count = 0;
+  pHistogram->Min = UINT64_MAX;
+  pHistogram->Max = 0;
+  pHistogram->Sum = 0;
+}
+
+/** \brief Count the value in the histogram.
+ *
+ * \param pHistogram hdr_histogram_t* const   histogram
+ * \param value uint64_t                      value, e.g. latency in ns
+ *
+ */
+void record_hdr_value(hdr_histogram_t* const pHistogram, uint64_t value)
+{
+  pHistogram->Buckets[get_bucket(value)]++;
+  pHistogram->Count++;
+  pHistogram->Min = std::min(pHistogram->Min, value);
+  pHistogram->Max = std::max(pHistogram->Max, value);
+  pHistogram->Sum += (double)value;
+}
+
+/** \brief Add the counts of a histogram to the total.
+ *
+ * \param pTotal hdr_histogram_t* const               total histogram
+ * \param pHistogram const hdr_histogram_t* const     histogram to add
+ *
+ */
+void add_hdr_histogram(hdr_histogram_t* const pTotal, const hdr_histogram_t* const pHistogram)
+{
+  for(uint32_t bucket = 0; bucket < HDR_BUCKETS; bucket++)
+  {
+    pTotal->Buckets[bucket] += pHistogram->Buckets[bucket];
+  }
+  pTotal->Count += pHistogram->Count;
+  pTotal->Min = std::min(pTotal->Min, pHistogram->Min);
+  pTotal->Max = std::max(pTotal->Max, pHistogram->Max);
+  pTotal->Sum += pHistogram->Sum;
+}
+
+/** \brief Get the value at the percentile, the highest value of its bucket but not above the maximum.
+ *
+ * \param pHistogram const hdr_histogram_t* const     histogram
+ * \param percentile double                           percentile from 0 to 100
+ * \return uint64_t                                   value at the percentile, 0 if the histogram is empty
+ *
+ */
+uint64_t get_hdr_percentile(const hdr_histogram_t* const pHistogram, double percentile)
+{
+  if(pHistogram->Count == 0)
+  {
+    return 0;
+  }
+
+  const uint64_t rank = std::max((uint64_t)std::ceil(percentile / 100 * (double)pHistogram->Count), UINT64_C(1));
+  uint64_t count = 0;
+  for(uint32_t bucket = 0; bucket < HDR_BUCKETS; bucket++)
+  {
+    count += pHistogram->Buckets[bucket];
+    if(count >= rank)
+    {
+      return std::min(get_bucket_value(bucket), pHistogram->Max);
+    }
+  }
+  return pHistogram->Max;
+}
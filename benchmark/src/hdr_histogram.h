@@ -0,0 +1,58 @@
+/**
+ * \file
+ * \brief High dynamic range histogram of the latency benchmarks
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HDR_HISTOGRAM_H
+#define HDR_HISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define HDR_SUB_BUCKET_BITS   10u   //!< Each power of 2 range is split in 1024 buckets, 0.1% resolution
+#define HDR_MAX_BITS          40u   //!< Values of 2^40 or more are recorded in the last bucket
+
+//! Values below HDR_SUB_BUCKETS have a bucket each, every power of 2 range above has HDR_SUB_BUCKETS buckets.
+#define HDR_SUB_BUCKETS       (1u << HDR_SUB_BUCKET_BITS)
+#define HDR_BUCKETS           ((HDR_MAX_BITS - HDR_SUB_BUCKET_BITS + 1) * HDR_SUB_BUCKETS)
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Histogram owned by a single thread, merge the histograms of threads with add_hdr_histogram.
+typedef struct
+{
+  std::vector<uint64_t> Buckets;
+  uint64_t Count;
+  uint64_t Min;
+  uint64_t Max;
+  double Sum;
+}hdr_histogram_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+extern void init_hdr_histogram(hdr_histogram_t* const pHistogram);
+
+extern void record_hdr_value(hdr_histogram_t* const pHistogram, uint64_t value);
+
+extern void add_hdr_histogram(hdr_histogram_t* const pTotal, const hdr_histogram_t* const pHistogram);
+
+extern uint64_t get_hdr_percentile(const hdr_histogram_t* const pHistogram, double percentile);
+
+#endif // HDR_HISTOGRAM_H
@@ -0,0 +1,330 @@
+/**
+ * \file
+ * \brief Load generator of a fleet of toaster ovens
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// Runs the oven state machine of demo/toaster_oven on a fleet of ovens, built without console.
+// Each event goes to a random oven and is dispatched to it alone, as the timer and console of the demo do.
+// The event is drawn from the mix of start, stop, door open, door close and timeout. The events that
+// the oven doesn't handle in its current state, e.g. start while the door is open, are counted as ignored.
+//
+// With a rate, event n is due at n / rate from the start and its latency runs from the due time to the
+// return of dispatch_event. So a fleet falling behind the rate shows in the latency, not only the throughput.
+// Latency is measured by HSM_CYCLE_COUNTER(), calibrated against HSM_TIMESTAMP() over the run.
+//
+// Options:
+//   --ovens=<n>         ovens in the fleet, default 100000
+//   --events=<n>        events to dispatch, default 10 per oven
+//   --rate=<n>          events per second, default 0 for as fast as possible
+//   --mix=<s,q,o,c,t>   weights of start, stop, door open, door close and timeout, default 30,10,25,25,10
+//   --seed=<n>          seed of the random events, default 1
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif // __linux__
+
+#include "bench_random.h"
+#include "hsm.h"
+#include "hsm_port.h"
+
+extern "C"
+{
+#include "toaster_oven.h"
+}
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define OVEN_EVENTS     5u      //!< Events from EN_START to EN_TIMEOUT
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+namespace
+{
+
+typedef struct
+{
+  uint32_t Ovens;
+  uint64_t Events;
+  uint64_t Rate;                    //!< Events per second, 0 for as fast as possible
+  uint32_t Mix[OVEN_EVENTS];        //!< Weight of each event
+  uint64_t Seed;
+}options_t;
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+const char* const Event_Names[OVEN_EVENTS] = {"start", "stop", "door_open", "door_close", "timeout"};
+
+options_t Options = {100000, 0, 0, {30, 10, 25, 25, 10}, 1};
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+void print_usage(const char* pProgram)
+{
+  fprintf(stderr, "Usage: %s [--ovens=<n>] [--events=<n>] [--rate=<events/s>] [--mix=<s,q,o,c,t>] [--seed=<n>]\n",
+          pProgram);
+}
+
+bool parse_mix(const char* pText)
+{
+  for(uint32_t index = 0; index < OVEN_EVENTS; index++)
+  {
+    char* pEnd;
+    Options.Mix[index] = (uint32_t)strtoul(pText, &pEnd, 10);
+    if((pEnd == pText) || (*pEnd != ((index + 1 < OVEN_EVENTS) ? ',' : '\0')))
+    {
+      return false;
+    }
+    pText = pEnd + 1;
+  }
+  return true;
+}
+
+void parse_options(int argc, char* argv[])
+{
+  for(int index = 1; index < argc; index++)
+  {
+    const char* const pArgument = argv[index];
+    bool valid = true;
+
+    if(strncmp(pArgument, "--ovens=", 8) == 0)
+    {
+      Options.Ovens = (uint32_t)strtoul(pArgument + 8, NULL, 10);
+    }
+    else if(strncmp(pArgument, "--events=", 9) == 0)
+    {
+      Options.Events = strtoull(pArgument + 9, NULL, 10);
+    }
+    else if(strncmp(pArgument, "--rate=", 7) == 0)
+    {
+      Options.Rate = strtoull(pArgument + 7, NULL, 10);
+    }
+    else if(strncmp(pArgument, "--mix=", 6) == 0)
+    {
+      valid = parse_mix(pArgument + 6);
+    }
+    else if(strncmp(pArgument, "--seed=", 7) == 0)
+    {
+      Options.Seed = strtoull(pArgument + 7, NULL, 10);
+    }
+    else
+    {
+      print_usage(argv[0]);
+      exit((strcmp(pArgument, "--help") == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    if(!valid)
+    {
+      print_usage(argv[0]);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  uint32_t total = 0;
+  for(uint32_t weight : Options.Mix)
+  {
+    total += weight;
+  }
+  if((Options.Ovens == 0) || (total == 0))
+  {
+    print_usage(argv[0]);
+    exit(EXIT_FAILURE);
+  }
+
+  if(Options.Events == 0)
+  {
+    Options.Events = (uint64_t)Options.Ovens * 10;
+  }
+}
+
+//! Resident memory of the process in bytes, 0 if unknown
+uint64_t get_resident(void)
+{
+#if defined(__linux__)
+  unsigned long long size = 0;
+  unsigned long long resident = 0;
+  FILE* const pFile = fopen("/proc/self/statm", "r");
+  if(pFile == NULL)
+  {
+    return 0;
+  }
+  if(fscanf(pFile, "%llu %llu", &size, &resident) != 2)
+  {
+    resident = 0;
+  }
+  fclose(pFile);
+  return resident * (uint64_t)sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif // __linux__
+}
+
+//! Seconds of a duration in ticks of HSM_TIMESTAMP()
+double timestamp_to_seconds(uint64_t ticks)
+{
+  return (double)ticks / (double)HSM_TIMESTAMP_FREQUENCY;
+}
+
+//! Ticks of HSM_CYCLE_COUNTER() per ns, measured over 10 ms
+double calibrate_cycle_counter(void)
+{
+  const uint64_t start = HSM_TIMESTAMP();
+  const uint64_t start_ticks = HSM_CYCLE_COUNTER();
+  while(HSM_TIMESTAMP() - start < HSM_TIMESTAMP_FREQUENCY / 100)
+  {
+  }
+  return (double)(HSM_CYCLE_COUNTER() - start_ticks) / (timestamp_to_seconds(HSM_TIMESTAMP() - start) * 1e9);
+}
+
+//! Event drawn from the mix
+uint32_t draw_event(uint64_t* const pSeed, uint32_t total_weight)
+{
+  uint32_t choice = random_below(pSeed, total_weight);
+  uint32_t event = 0;
+  while(choice >= Options.Mix[event])
+  {
+    choice -= Options.Mix[event];
+    event++;
+  }
+  return EN_START + event;
+}
+
+//! Latency at the given percentile of sorted latencies
+uint64_t get_percentile(const std::vector<uint64_t>& latencies, double percentile)
+{
+  const size_t rank = (size_t)((percentile / 100) * (double)(latencies.size() - 1) + 0.5);
+  return latencies[rank];
+}
+
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+int main(int argc, char* argv[])
+{
+  parse_options(argc, argv);
+
+  uint32_t total_weight = 0;
+  for(uint32_t weight : Options.Mix)
+  {
+    total_weight += weight;
+  }
+
+  const uint64_t resident_before = get_resident();
+  std::vector<oven_t> fleet(Options.Ovens);
+  for(oven_t& oven : fleet)
+  {
+    init_oven(&oven, 10, DOOR_CLOSED);
+  }
+  const uint64_t resident_after = get_resident();
+
+  std::vector<uint64_t> latencies(Options.Events);
+  uint64_t sent[OVEN_EVENTS] = {0};
+  uint64_t ignored[OVEN_EVENTS] = {0};
+
+  const double ticks_per_ns = calibrate_cycle_counter();
+  const double ticks_per_event = (Options.Rate != 0) ? ticks_per_ns * 1e9 / (double)Options.Rate : 0;
+  uint64_t seed = Options.Seed;
+
+  const uint64_t start = HSM_TIMESTAMP();
+  const uint64_t start_ticks = HSM_CYCLE_COUNTER();
+
+  for(uint64_t count = 0; count < Options.Events; count++)
+  {
+    oven_t* const pOven = &fleet[random_below(&seed, Options.Ovens)];
+    const uint32_t event = draw_event(&seed, total_weight);
+
+    uint64_t begin = HSM_CYCLE_COUNTER();
+    if(ticks_per_event != 0)
+    {
+      // Wait for the due time, unless the fleet is behind the rate.
+      const uint64_t due = start_ticks + (uint64_t)((double)count * ticks_per_event);
+      while(begin < due)
+      {
+        begin = HSM_CYCLE_COUNTER();
+      }
+      begin = due;
+    }
+
+    state_machine_t* const machineList[] = {&pOven->Machine};
+    pOven->Machine.Event = event;
+    if(dispatch_event(machineList, 1) == EVENT_UN_HANDLED)
+    {
+      pOven->Machine.Event = 0;   // Event is not supported in the current state of oven.
+      ignored[event - EN_START]++;
+    }
+    latencies[count] = HSM_CYCLE_COUNTER() - begin;
+    sent[event - EN_START]++;
+  }
+
+  const double elapsed = timestamp_to_seconds(HSM_TIMESTAMP() - start);
+  const double ns_per_tick = elapsed * 1e9 / (double)(HSM_CYCLE_COUNTER() - start_ticks);
+
+  uint32_t door_open = 0;
+  uint32_t heating = 0;
+  for(const oven_t& oven : fleet)
+  {
+    door_open += oven.Lamp ? 1 : 0;
+    heating += oven.Heater ? 1 : 0;
+  }
+
+  printf("ovens       %u, %zu bytes/oven", Options.Ovens, sizeof(oven_t));
+  if(resident_after > resident_before)
+  {
+    printf(", %.1f resident bytes/oven", (double)(resident_after - resident_before) / Options.Ovens);
+  }
+  printf("\n");
+  printf("            %u door open, %u heating, %u off\n", door_open, heating,
+         Options.Ovens - door_open - heating);
+
+  printf("events      %llu in %.3f s", (unsigned long long)Options.Events, elapsed);
+  if(Options.Rate != 0)
+  {
+    printf(", rate %llu events/s", (unsigned long long)Options.Rate);
+  }
+  printf("\n");
+  for(uint32_t index = 0; index < OVEN_EVENTS; index++)
+  {
+    printf("            %-10s %12llu sent %12llu ignored\n", Event_Names[index],
+           (unsigned long long)sent[index], (unsigned long long)ignored[index]);
+  }
+
+  printf("throughput  %.0f events/s\n", (elapsed != 0) ? (double)Options.Events / elapsed : 0);
+
+  std::sort(latencies.begin(), latencies.end());
+  printf("latency ns ");
+  for(double percentile : {50.0, 90.0, 99.0, 99.9, 99.99})
+  {
+    printf(" p%g=%.0f", percentile, (double)get_percentile(latencies, percentile) * ns_per_tick);
+  }
+  printf(" max=%.0f\n", (double)latencies.back() * ns_per_tick);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/**
+ * \file
+ * \brief Hardware performance counters of the benchmark harness
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// The counters are opened with perf_event_open for the calling thread, user space only, so they work
+// with perf_event_paranoid up to 2. Each counter is opened alone: a counter the CPU or the virtual
+// machine doesn't support is left out, the others are still read. On other platforms, or when no
+// counter can be opened, open_perf_counters reports why and the benchmarks run without counters.
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // __linux__
+
+#include "perf_counters.h"
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+namespace
+{
+
+const char* const Counter_Names[PERF_COUNTERS] =
+{
+  "cycles",
+  "instructions",
+  "l1d_misses",
+  "llc_misses",
+  "branch_misses",
+};
+
+#if defined(__linux__)
+
+//! Type and config of perf_event_attr of each counter
+const struct
+{
+  uint32_t Type;
+  uint64_t Config;
+}Counter_Events[PERF_COUNTERS] =
+{
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+  {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                       | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+int Counter_Fd[PERF_COUNTERS] = {-1, -1, -1, -1, -1};
+
+#endif // __linux__
+
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Open the hardware counters of the calling thread.
+ *
+ * \return bool   true if any counter is available, otherwise the reason is printed on stderr
+ *
+ */
+bool open_perf_counters(void)
+{
+#if defined(__linux__)
+  bool opened = false;
+  int error = 0;
+
+  for(uint32_t counter = 0; counter < PERF_COUNTERS; counter++)
+  {
+    struct perf_event_attr attribute;
+    memset(&attribute, 0, sizeof(attribute));
+    attribute.size = sizeof(attribute);
+    attribute.type = Counter_Events[counter].Type;
+    attribute.config = Counter_Events[counter].Config;
+    attribute.disabled = 1;
+    attribute.exclude_kernel = 1;
+    attribute.exclude_hv = 1;
+    attribute.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    Counter_Fd[counter] = (int)syscall(__NR_perf_event_open, &attribute, 0, -1, -1, 0);
+    if(Counter_Fd[counter] < 0)
+    {
+      error = errno;
+      continue;
+    }
+    opened = true;
+  }
+
+  if(!opened)
+  {
+    fprintf(stderr, "Hardware counters are not available: perf_event_open failed, %s\n", strerror(error));
+  }
+  return opened;
+#else
+  fprintf(stderr, "Hardware counters are not available on this platform\n");
+  return false;
+#endif // __linux__
+}
+
+//! Close the hardware counters.
+void close_perf_counters(void)
+{
+#if defined(__linux__)
+  for(int& fd : Counter_Fd)
+  {
+    if(fd >= 0)
+    {
+      close(fd);
+      fd = -1;
+    }
+  }
+#endif // __linux__
+}
+
+//! Reset and start the open counters.
+void start_perf_counters(void)
+{
+#if defined(__linux__)
+  for(const int fd : Counter_Fd)
+  {
+    if(fd >= 0)
+    {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif // __linux__
+}
+
+/** \brief Stop the counters and read them.
+ *
+ * \param pSample perf_sample_t* const   counts since start_perf_counters
+ *
+ */
+void stop_perf_counters(perf_sample_t* const pSample)
+{
+  *pSample = perf_sample_t();
+
+#if defined(__linux__)
+  for(const int fd : Counter_Fd)
+  {
+    if(fd >= 0)
+    {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+
+  for(uint32_t counter = 0; counter < PERF_COUNTERS; counter++)
+  {
+    uint64_t values[3];     // Count, time enabled and time running
+    if((Counter_Fd[counter] < 0) || (read(Counter_Fd[counter], values, sizeof(values)) != sizeof(values))
+       || (values[2] == 0))
+    {
+      continue;
+    }
+
+    // Scale the count to the whole run, when the counter was multiplexed with other events.
+    pSample->Count[counter] = (values[2] < values[1])
+                              ? (uint64_t)((double)values[0] * (double)values[1] / (double)values[2])
+                              : values[0];
+    pSample->Valid[counter] = true;
+  }
+#endif // __linux__
+}
+
+//! Name of the counter
+const char* get_perf_counter_name(perf_counter_t counter)
+{
+  return Counter_Names[counter];
+}
@@ -0,0 +1,60 @@
+/**
+ * \file
+ * \brief Hardware performance counters of the benchmark harness
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+
+/*
+ *  --------------------- ENUMERATION ---------------------
+ */
+
+//! Hardware counters read around the measured runs
+typedef enum
+{
+  PERF_CYCLES,
+  PERF_INSTRUCTIONS,
+  PERF_L1D_MISSES,      //!< Level 1 data cache read misses
+  PERF_LLC_MISSES,      //!< Last level cache misses
+  PERF_BRANCH_MISSES,
+  PERF_COUNTERS,
+}perf_counter_t;
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Counts of a measured run, scaled when the kernel multiplexed the counters
+typedef struct
+{
+  bool Valid[PERF_COUNTERS];      //!< Counter is available
+  uint64_t Count[PERF_COUNTERS];
+}perf_sample_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+extern bool open_perf_counters(void);
+
+extern void close_perf_counters(void);
+
+extern void start_perf_counters(void);
+
+extern void stop_perf_counters(perf_sample_t* const pSample);
+
+extern const char* get_perf_counter_name(perf_counter_t counter);
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,439 @@
+/**
+ * \file
+ * \brief Tail latency of the events posted by many producer threads
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// Producer threads post event objects to random state machines, consumer threads dispatch them.
+// Each consumer owns a slice of the state machines, as a state machine must have a single dispatcher.
+// The framework has no wake up of the dispatcher, so the consumers poll dispatch_event.
+//
+// Producers follow an open loop schedule: event n of a producer is due at n / (rate / producers).
+// Latency is measured at the start of the state handler:
+//   corrected    from the due time of the event, it includes the delay of a producer behind the schedule.
+//                This avoids the coordinated omission, where a stalled system delays its own measurements.
+//   uncorrected  from the post_event call, the latency as seen by the event queue.
+// Both are recorded in high dynamic range histograms, see hdr_histogram.h.
+//
+// Options:
+//   --producers=<n>     producer threads, default 4
+//   --consumers=<n>     consumer threads, default 2
+//   --machines=<n>      state machines, default 64
+//   --rate=<n>          events per second of all the producers, default 1000000
+//   --duration=<ms>     duration of the posting, default 1000 ms
+//   --service=<ns>      busy time of the state handler, default 0
+//   --pool=<n>          event objects in the pool, default 65536
+//   --idle=spin|yield   producer waiting for the due time and consumer with no pending event
+//                       spin or yield the CPU, default yield. Spin only with a core for each thread.
+//   --seed=<n>          seed of the random state machines, default 1
+//   --capture=<file>    record the posted events to an event stream file, to replay it with event_replay.
+//                       The capture serializes the producers, measure the latency without it.
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "bench_random.h"
+#include "event_stream.h"
+#include "hdr_histogram.h"
+#include "hsm.h"
+#include "hsm_event.h"
+#include "hsm_port.h"
+
+#if !HSM_EVENT_OBJECTS
+#error "post_latency_bench requires HSM_EVENT_OBJECTS"
+#endif
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define BENCH_EVENT     1u
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+namespace
+{
+
+typedef struct
+{
+  uint32_t Producers;
+  uint32_t Consumers;
+  uint32_t Machines;
+  uint64_t Rate;              //!< Events per second of all the producers
+  uint64_t Duration;          //!< Duration of the posting in ns
+  uint64_t Service;           //!< Busy time of the state handler in ns
+  uint32_t Pool;
+  bool Yield;                 //!< Waiting producers and idle consumers yield the CPU
+  uint64_t Seed;
+  const char* pCapture;       //!< Event stream file, NULL if not captured
+}options_t;
+
+//! Event object with the times of its post
+typedef struct
+{
+  event_t Header;
+  uint64_t Due;               //!< HSM_TIMESTAMP() of the scheduled post
+  uint64_t Posted;            //!< HSM_TIMESTAMP() just before post_event
+}timed_event_t;
+
+//! Latency measurements of a consumer thread
+typedef struct
+{
+  hdr_histogram_t Corrected;
+  hdr_histogram_t Uncorrected;
+  uint64_t Handled;
+}consumer_t;
+
+//! State machine of the benchmark, dispatched by one consumer
+typedef struct
+{
+  state_machine_t Machine;
+  consumer_t* Consumer;
+}bench_machine_t;
+
+//! Counts of a producer thread
+typedef struct
+{
+  uint64_t Posted;
+  uint64_t Pool_Stalls;       //!< Retries of allocate_event on empty pool
+  uint64_t Late;              //!< Events posted later than an interval after their due time
+}producer_t;
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+options_t Options = {4, 2, 64, 1000000, 1000000000, 0, 65536, true, 1, NULL};
+
+event_pool_t Pool;
+std::vector<bench_machine_t> Machines;
+std::atomic<bool> Posting_Done(false);
+uint64_t Service_Ticks;       //!< Options.Service in ticks of HSM_TIMESTAMP()
+
+/*
+ *  --------------------- STATE HANDLERS ---------------------
+ */
+
+state_machine_result_t handle_event(state_machine_t* const pState_Machine)
+{
+  const uint64_t start = HSM_TIMESTAMP();
+  const timed_event_t* const pEvent = reinterpret_cast<const timed_event_t*>(pState_Machine->Event_Object);
+  consumer_t* const pConsumer = reinterpret_cast<bench_machine_t*>(pState_Machine)->Consumer;
+
+  record_hdr_value(&pConsumer->Corrected, (start > pEvent->Due) ? timestamp_to_ns(start - pEvent->Due) : 0);
+  record_hdr_value(&pConsumer->Uncorrected, (start > pEvent->Posted) ? timestamp_to_ns(start - pEvent->Posted) : 0);
+  pConsumer->Handled++;
+
+  while(HSM_TIMESTAMP() - start < Service_Ticks)
+  {
+  }
+  return EVENT_HANDLED;
+}
+
+#if HIERARCHICAL_STATES
+const state_t Bench_State = {handle_event, NULL, NULL, NULL, NULL, 0};
+#else
+const state_t Bench_State = {handle_event, NULL, NULL};
+#endif // HIERARCHICAL_STATES
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+void print_usage(const char* pProgram)
+{
+  fprintf(stderr, "Usage: %s [--producers=<n>] [--consumers=<n>] [--machines=<n>] [--rate=<events/s>]\n"
+                  "       [--duration=<ms>] [--service=<ns>] [--pool=<n>] [--idle=spin|yield] [--seed=<n>]\n"
+                  "       [--capture=<file>]\n",
+          pProgram);
+}
+
+void parse_options(int argc, char* argv[])
+{
+  for(int index = 1; index < argc; index++)
+  {
+    const char* const pArgument = argv[index];
+
+    if(strncmp(pArgument, "--producers=", 12) == 0)
+    {
+      Options.Producers = (uint32_t)strtoul(pArgument + 12, NULL, 10);
+    }
+    else if(strncmp(pArgument, "--consumers=", 12) == 0)
+    {
+      Options.Consumers = (uint32_t)strtoul(pArgument + 12, NULL, 10);
+    }
+    else if(strncmp(pArgument, "--machines=", 11) == 0)
+    {
+      Options.Machines = (uint32_t)strtoul(pArgument + 11, NULL, 10);
+    }
+    else if(strncmp(pArgument, "--rate=", 7) == 0)
+    {
+      Options.Rate = strtoull(pArgument + 7, NULL, 10);
+    }
+    else if(strncmp(pArgument, "--duration=", 11) == 0)
+    {
+      Options.Duration = strtoull(pArgument + 11, NULL, 10) * 1000000;
+    }
+    else if(strncmp(pArgument, "--service=", 10) == 0)
+    {
+      Options.Service = strtoull(pArgument + 10, NULL, 10);
+    }
+    else if(strncmp(pArgument, "--pool=", 7) == 0)
+    {
+      Options.Pool = (uint32_t)strtoul(pArgument + 7, NULL, 10);
+    }
+    else if((strcmp(pArgument, "--idle=spin") == 0) || (strcmp(pArgument, "--idle=yield") == 0))
+    {
+      Options.Yield = (strcmp(pArgument, "--idle=yield") == 0);
+    }
+    else if(strncmp(pArgument, "--seed=", 7) == 0)
+    {
+      Options.Seed = strtoull(pArgument + 7, NULL, 10);
+    }
+    else if(strncmp(pArgument, "--capture=", 10) == 0)
+    {
+      Options.pCapture = pArgument + 10;
+    }
+    else
+    {
+      print_usage(argv[0]);
+      exit((strcmp(pArgument, "--help") == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+  }
+
+  // Each consumer needs at least one state machine.
+  if((Options.Producers == 0) || (Options.Consumers == 0) || (Options.Machines < Options.Consumers)
+     || (Options.Rate == 0) || (Options.Pool == 0))
+  {
+    print_usage(argv[0]);
+    exit(EXIT_FAILURE);
+  }
+}
+
+void produce(uint32_t producer, uint64_t start, producer_t* const pCounts)
+{
+  uint64_t seed = Options.Seed + producer;
+  // Producers are staggered over the interval, so their posts don't line up.
+  // The schedule is in ticks of HSM_TIMESTAMP().
+  const double interval = (double)HSM_TIMESTAMP_FREQUENCY * Options.Producers / (double)Options.Rate;
+  const double offset = interval * producer / Options.Producers;
+  const uint64_t duration = ns_to_timestamp(Options.Duration);
+
+  for(uint64_t count = 0;; count++)
+  {
+    const uint64_t due = start + (uint64_t)(offset + (double)count * interval);
+    if(due - start >= duration)
+    {
+      break;
+    }
+
+    bench_machine_t* const pMachine = &Machines[random_below(&seed, Options.Machines)];
+
+    uint64_t now = HSM_TIMESTAMP();
+    while(now < due)
+    {
+      if(Options.Yield)
+      {
+        std::this_thread::yield();
+      }
+      now = HSM_TIMESTAMP();
+    }
+    pCounts->Late += (now - due > (uint64_t)interval) ? 1 : 0;
+
+    event_t* pEvent = allocate_event(&Pool, BENCH_EVENT);
+    while(pEvent == NULL)
+    {
+      pCounts->Pool_Stalls++;
+      std::this_thread::yield();
+      pEvent = allocate_event(&Pool, BENCH_EVENT);
+    }
+
+    timed_event_t* const pTimed = reinterpret_cast<timed_event_t*>(pEvent);
+    pTimed->Due = due;
+    pTimed->Posted = HSM_TIMESTAMP();
+    post_event(&pMachine->Machine, pEvent);
+    pCounts->Posted++;
+  }
+}
+
+void consume(std::vector<state_machine_t*>* const pList, consumer_t* const pConsumer)
+{
+  while(true)
+  {
+    // Read the flag before the pass, all the events are posted when it is set.
+    const bool done = Posting_Done.load(std::memory_order_acquire);
+    const uint64_t handled = pConsumer->Handled;
+
+    if(dispatch_event(pList->data(), (uint32_t)pList->size()) != EVENT_HANDLED)
+    {
+      fprintf(stderr, "dispatch_event failed\n");
+      exit(EXIT_FAILURE);
+    }
+
+    if(pConsumer->Handled == handled)
+    {
+      if(done)
+      {
+        return;
+      }
+      if(Options.Yield)
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+}
+
+void print_latency(const char* pName, const hdr_histogram_t* const pHistogram)
+{
+  printf("%-12s", pName);
+  for(double percentile : {50.0, 90.0, 99.0, 99.9, 99.99})
+  {
+    printf(" p%g=%llu", percentile, (unsigned long long)get_hdr_percentile(pHistogram, percentile));
+  }
+  printf(" max=%llu mean=%.0f\n", (unsigned long long)pHistogram->Max,
+         (pHistogram->Count != 0) ? pHistogram->Sum / (double)pHistogram->Count : 0);
+}
+
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+int main(int argc, char* argv[])
+{
+  parse_options(argc, argv);
+  Service_Ticks = ns_to_timestamp(Options.Service);
+
+  std::vector<timed_event_t> storage(Options.Pool);
+  init_event_pool(&Pool, storage.data(), sizeof(timed_event_t), Options.Pool);
+
+  std::vector<consumer_t> consumers(Options.Consumers);
+  std::vector<std::vector<state_machine_t*>> lists(Options.Consumers);
+  Machines.assign(Options.Machines, bench_machine_t());
+
+  for(uint32_t consumer = 0; consumer < Options.Consumers; consumer++)
+  {
+    init_hdr_histogram(&consumers[consumer].Corrected);
+    init_hdr_histogram(&consumers[consumer].Uncorrected);
+    consumers[consumer].Handled = 0;
+  }
+
+  // Consecutive slices of the state machines for each consumer.
+  for(uint32_t index = 0; index < Options.Machines; index++)
+  {
+    const uint32_t consumer = (uint32_t)((uint64_t)index * Options.Consumers / Options.Machines);
+    Machines[index].Machine.State = &Bench_State;
+    Machines[index].Consumer = &consumers[consumer];
+    lists[consumer].push_back(&Machines[index].Machine);
+  }
+
+  if(Options.pCapture != NULL)
+  {
+    std::vector<const void*> machines;
+    for(const bench_machine_t& machine : Machines)
+    {
+      machines.push_back(&machine.Machine);
+    }
+    if(!start_event_capture(Options.pCapture, machines.data(), Options.Machines))
+    {
+      fprintf(stderr, "Failed to create the event stream \"%s\"\n", Options.pCapture);
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<std::thread> consumer_threads;
+  for(uint32_t consumer = 0; consumer < Options.Consumers; consumer++)
+  {
+    consumer_threads.emplace_back(consume, &lists[consumer], &consumers[consumer]);
+  }
+
+  // Give the threads 10 ms to start before the schedule begins.
+  const uint64_t start = HSM_TIMESTAMP() + HSM_TIMESTAMP_FREQUENCY / 100;
+  std::vector<producer_t> producers(Options.Producers, producer_t());
+  std::vector<std::thread> producer_threads;
+  for(uint32_t producer = 0; producer < Options.Producers; producer++)
+  {
+    producer_threads.emplace_back(produce, producer, start, &producers[producer]);
+  }
+
+  for(std::thread& thread : producer_threads)
+  {
+    thread.join();
+  }
+
+  uint64_t captured = 0;
+  if((Options.pCapture != NULL) && !stop_event_capture(&captured))
+  {
+    fprintf(stderr, "Failed to capture all the events to \"%s\"\n", Options.pCapture);
+    return EXIT_FAILURE;
+  }
+  Posting_Done.store(true, std::memory_order_release);
+  for(std::thread& thread : consumer_threads)
+  {
+    thread.join();
+  }
+  const double elapsed = (double)timestamp_to_ns(HSM_TIMESTAMP() - start) / 1e9;
+
+  producer_t total = producer_t();
+  for(const producer_t& producer : producers)
+  {
+    total.Posted += producer.Posted;
+    total.Pool_Stalls += producer.Pool_Stalls;
+    total.Late += producer.Late;
+  }
+
+  hdr_histogram_t corrected;
+  hdr_histogram_t uncorrected;
+  init_hdr_histogram(&corrected);
+  init_hdr_histogram(&uncorrected);
+  uint64_t handled = 0;
+  for(const consumer_t& consumer : consumers)
+  {
+    add_hdr_histogram(&corrected, &consumer.Corrected);
+    add_hdr_histogram(&uncorrected, &consumer.Uncorrected);
+    handled += consumer.Handled;
+  }
+
+  printf("producers %u, consumers %u, machines %u, rate %llu events/s, service %llu ns, idle %s\n",
+         Options.Producers, Options.Consumers, Options.Machines, (unsigned long long)Options.Rate,
+         (unsigned long long)Options.Service, Options.Yield ? "yield" : "spin");
+  printf("events      %llu posted, %llu handled in %.3f s, %.0f events/s\n", (unsigned long long)total.Posted,
+         (unsigned long long)handled, elapsed, (elapsed != 0) ? (double)handled / elapsed : 0);
+  printf("            %llu posted late by more than an interval, %llu pool stalls\n",
+         (unsigned long long)total.Late, (unsigned long long)total.Pool_Stalls);
+  printf("latency ns, post to handler start\n");
+  print_latency("corrected", &corrected);
+  print_latency("uncorrected", &uncorrected);
+  if(Options.pCapture != NULL)
+  {
+    printf("captured    %llu events to %s\n", (unsigned long long)captured, Options.pCapture);
+  }
+
+  if(handled != total.Posted)
+  {
+    fprintf(stderr, "%llu events are not handled\n", (unsigned long long)(total.Posted - handled));
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
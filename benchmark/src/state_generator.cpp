@@ -0,0 +1,292 @@
+/**
+ * \file
+ * \brief Generator of synthetic state machines, deterministic from a seed
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// The shape is a random recursive tree: each new state picks its parent uniformly from the states
+// that are not yet full, i.e. below the maximum depth and fan-out. A virtual root stands for the parent
+// of the top states. The states are then laid out breadth first, so the child states of each state are
+// consecutive as the framework expects. The finite state machine has only top states.
+//
+// The random numbers come from bench_random.h, so the same seed generates the same state machine
+// on every platform.
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "state_generator.h"
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define NO_PARENT       UINT32_MAX      //!< Parent index of the top states, the virtual root
+
+/*
+ *  --------------------- STATE HANDLERS ---------------------
+ */
+
+namespace
+{
+
+generated_machine_t* get_machine(state_machine_t* const pState_Machine)
+{
+  return reinterpret_cast<generated_machine_t*>(pState_Machine);
+}
+
+state_machine_result_t pass_event(state_machine_t* const pState_Machine)
+{
+  get_machine(pState_Machine)->Handler_Calls++;
+  return EVENT_UN_HANDLED;
+}
+
+state_machine_result_t handle_event(state_machine_t* const pState_Machine)
+{
+  generated_machine_t* const pMachine = get_machine(pState_Machine);
+  const generated_hsm_t* const pHsm = pMachine->Hsm;
+  pMachine->Handler_Calls++;
+
+  const uint32_t target = get_generated_target(pHsm, pState_Machine->State, pState_Machine->Event);
+  if(target == GENERATED_NO_TARGET)
+  {
+    return EVENT_HANDLED;
+  }
+
+  pMachine->Transitions++;
+  const state_t* const pTarget = &pHsm->Tree.States[target];
+#if HIERARCHICAL_STATES
+  return traverse_state(pState_Machine, pTarget);
+#else
+  return switch_state(pState_Machine, pTarget);
+#endif // HIERARCHICAL_STATES
+}
+
+state_machine_result_t count_exit(state_machine_t* const pState_Machine)
+{
+  get_machine(pState_Machine)->Exits++;
+  return EVENT_HANDLED;
+}
+
+state_machine_result_t count_entry(state_machine_t* const pState_Machine)
+{
+  get_machine(pState_Machine)->Entries++;
+  return EVENT_HANDLED;
+}
+
+state_handler choose_handler(uint64_t* const pSeed, const generator_config_t* const pConfig, bool top)
+{
+  const uint32_t choice = random_below(pSeed, 100);
+
+  // Top states handle all the events, the unhandled event is fatal for the dispatcher.
+  if(!top && (choice < pConfig->None_Percent))
+  {
+    return NULL;
+  }
+
+  if(!top && (choice < pConfig->None_Percent + pConfig->Pass_Percent))
+  {
+    return pass_event;
+  }
+
+  return handle_event;
+}
+
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Generate a state machine.
+ *
+ * \param pHsm generated_hsm_t* const                 generated state machine, free it with free_generated_hsm
+ * \param pConfig const generator_config_t* const     shape and behaviour
+ * \return bool                                       false if the states don't fit in the depth and fan-out
+ *
+ */
+bool generate_hsm(generated_hsm_t* const pHsm, const generator_config_t* const pConfig)
+{
+  const uint32_t states = pConfig->States;
+  uint64_t seed = pConfig->Seed;
+
+#if HIERARCHICAL_STATES
+  const uint32_t max_depth = pConfig->Max_Depth;
+  const uint32_t max_fanout = pConfig->Max_Fanout;
+#else
+  const uint32_t max_depth = 1;
+  const uint32_t max_fanout = states;
+#endif // HIERARCHICAL_STATES
+
+  if((states == 0) || (max_depth == 0) || (max_fanout == 0) || (pConfig->Events == 0))
+  {
+    return false;
+  }
+
+  // Shape: parent of each state. Index 'states' in the children count is the virtual root.
+  std::vector<uint32_t> parent(states);
+  std::vector<uint32_t> level(states);
+  std::vector<uint32_t> children(states + 1, 0);
+  std::vector<uint32_t> open(1, states);              // States that can take a child state
+
+  for(uint32_t state = 0; state < states; state++)
+  {
+    if(open.empty())
+    {
+      return false;
+    }
+
+    const uint32_t position = random_below(&seed, (uint32_t)open.size());
+    const uint32_t chosen = open[position];
+    parent[state] = (chosen == states) ? NO_PARENT : chosen;
+    level[state] = (chosen == states) ? 0 : level[chosen] + 1;
+
+    if(++children[chosen] == max_fanout)
+    {
+      open[position] = open.back();
+      open.pop_back();
+    }
+
+    if(level[state] + 1 < max_depth)
+    {
+      open.push_back(state);
+    }
+  }
+
+  // Child states of each state, in the order of generation.
+  std::vector<uint32_t> first_child(states + 2, 0);
+  for(uint32_t state = 0; state < states; state++)
+  {
+    first_child[((parent[state] == NO_PARENT) ? states : parent[state]) + 1]++;
+  }
+  for(uint32_t index = 1; index < states + 2; index++)
+  {
+    first_child[index] += first_child[index - 1];
+  }
+  std::vector<uint32_t> child_list(states);
+  std::vector<uint32_t> filled(first_child.begin(), first_child.end() - 1);
+  for(uint32_t state = 0; state < states; state++)
+  {
+    child_list[filled[(parent[state] == NO_PARENT) ? states : parent[state]]++] = state;
+  }
+
+  // Breadth first layout. Each state is constructed when its child states are reserved.
+  init_state_tree(&pHsm->Tree, states);
+  std::vector<state_t*> slot(states);
+  std::vector<uint32_t> queue;
+  queue.reserve(states);
+
+  pHsm->Top_States = children[states];
+  pHsm->Events = pConfig->Events;
+  pHsm->Max_Level = 0;
+
+  state_t* const pTop = reserve_states(&pHsm->Tree, pHsm->Top_States);
+  for(uint32_t index = 0; index < pHsm->Top_States; index++)
+  {
+    const uint32_t state = child_list[first_child[states] + index];
+    slot[state] = &pTop[index];
+    queue.push_back(state);
+  }
+
+  for(size_t head = 0; head < queue.size(); head++)
+  {
+    const uint32_t state = queue[head];
+    state_t* const pChildren = (children[state] != 0) ? reserve_states(&pHsm->Tree, children[state]) : NULL;
+
+    for(uint32_t index = 0; index < children[state]; index++)
+    {
+      const uint32_t child = child_list[first_child[state] + index];
+      slot[child] = &pChildren[index];
+      queue.push_back(child);
+    }
+
+    const bool top = (parent[state] == NO_PARENT);
+    construct_state(slot[state], choose_handler(&seed, pConfig, top), count_entry, count_exit,
+                    (uint32_t)(slot[state] - pHsm->Tree.States), top ? NULL : slot[parent[state]],
+                    pChildren, level[state]);
+
+    if(level[state] > pHsm->Max_Level)
+    {
+      pHsm->Max_Level = level[state];
+    }
+  }
+
+  // Target of each state and event, used by the state handling the event.
+  // Dispatcher calls the handler of current state, so only the states with handler are the targets.
+  std::vector<uint32_t> handled;
+  for(uint32_t state = 0; state < states; state++)
+  {
+    if(pHsm->Tree.States[state].Handler != NULL)
+    {
+      handled.push_back(state);
+    }
+  }
+
+  pHsm->Targets = static_cast<uint32_t*>(malloc(sizeof(uint32_t) * states * pConfig->Events));
+  if(pHsm->Targets == NULL)
+  {
+    fprintf(stderr, "Out of memory for the targets of %u states\n", states);
+    exit(EXIT_FAILURE);
+  }
+  for(uint64_t index = 0; index < (uint64_t)states * pConfig->Events; index++)
+  {
+    pHsm->Targets[index] = (random_below(&seed, 100) < pConfig->Transition_Percent)
+                           ? handled[random_below(&seed, (uint32_t)handled.size())] : GENERATED_NO_TARGET;
+  }
+  return true;
+}
+
+//! Free the generated state machine.
+void free_generated_hsm(generated_hsm_t* const pHsm)
+{
+  free_state_tree(&pHsm->Tree);
+  free(pHsm->Targets);
+  pHsm->Targets = NULL;
+}
+
+/** \brief Get the behaviour of the handler of a generated state.
+ *
+ * \param pState const state_t* const   generated state
+ * \return generated_action_t           behaviour of the handler
+ *
+ */
+generated_action_t get_generated_action(const state_t* const pState)
+{
+  if(pState->Handler == pass_event)
+  {
+    return ACTION_PASS;
+  }
+  if(pState->Handler == handle_event)
+  {
+    return ACTION_HANDLE;
+  }
+  return ACTION_NONE;
+}
+
+/** \brief Initialize a state machine running the generated state machine.
+ *
+ * \param pMachine generated_machine_t* const     state machine
+ * \param pHsm const generated_hsm_t* const       generated state machine
+ * \param state uint32_t                          index of initial state
+ *
+ */
+void init_generated_machine(generated_machine_t* const pMachine, const generated_hsm_t* const pHsm,
+                            uint32_t state)
+{
+  *pMachine = generated_machine_t();
+  pMachine->Machine.State = &pHsm->Tree.States[state];
+  pMachine->Hsm = pHsm;
+}
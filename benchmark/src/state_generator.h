@@ -0,0 +1,113 @@
+/**
+ * \file
+ * \brief Generator of synthetic state machines, deterministic from a seed
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef STATE_GENERATOR_H
+#define STATE_GENERATOR_H
+
+#include <cstdint>
+
+#include "bench_random.h"
+#include "hsm.h"
+#include "state_tree.h"
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define GENERATED_NO_TARGET   UINT32_MAX    //!< Event is handled without transition
+
+/*
+ *  --------------------- ENUMERATION ---------------------
+ */
+
+//! Behaviour of the state handler of a generated state
+typedef enum
+{
+  ACTION_NONE,          //!< State has no handler, the event bubbles to its parent
+  ACTION_PASS,          //!< Handler returns EVENT_UN_HANDLED
+  ACTION_HANDLE,        //!< Handler transitions to the target of current state and event, if any,
+                        //!< otherwise returns EVENT_HANDLED
+}generated_action_t;
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Shape and behaviour of the generated state machine
+typedef struct
+{
+  uint32_t States;              //!< Number of states
+  uint32_t Max_Depth;           //!< Maximum number of hierarchy levels, 1 for flat state machine
+  uint32_t Max_Fanout;          //!< Maximum number of child states of a state, and of top states
+  uint32_t Events;              //!< Events are from 1 to Events
+  uint32_t None_Percent;        //!< Child states without handler
+  uint32_t Pass_Percent;        //!< Child states that pass the event to the parent state
+  uint32_t Transition_Percent;  //!< Pairs of current state and event that have a transition target
+  uint64_t Seed;
+}generator_config_t;
+
+//! Generated state machine. The child states of a state are consecutive, top states are the first states.
+//! Top states and all the transition targets have a handler, start the state machines in one of them.
+typedef struct
+{
+  state_tree_t Tree;
+  uint32_t Top_States;
+  uint32_t Events;
+  uint32_t Max_Level;           //!< Deepest level of the generated states
+  uint32_t* Targets;            //!< Target of (current state, event) at [state * Events + event - 1],
+                                //!< GENERATED_NO_TARGET if the event is handled without transition
+}generated_hsm_t;
+
+//! State machine running a generated state machine. Its handlers count their calls here.
+typedef struct
+{
+  state_machine_t Machine;
+  const generated_hsm_t* Hsm;
+  uint64_t Handler_Calls;
+  uint64_t Transitions;
+  uint64_t Exits;
+  uint64_t Entries;
+}generated_machine_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+extern bool generate_hsm(generated_hsm_t* const pHsm, const generator_config_t* const pConfig);
+
+extern void free_generated_hsm(generated_hsm_t* const pHsm);
+
+extern generated_action_t get_generated_action(const state_t* const pState);
+
+extern void init_generated_machine(generated_machine_t* const pMachine, const generated_hsm_t* const pHsm,
+                                   uint32_t state);
+
+/*
+ *  --------------------- Inline functions ---------------------
+ */
+
+//! Index of the state in the generated state machine
+static inline uint32_t get_state_index(const generated_hsm_t* const pHsm, const state_t* const pState)
+{
+  return (uint32_t)(pState - pHsm->Tree.States);
+}
+
+//! Transition target of the current state and event, GENERATED_NO_TARGET if none
+static inline uint32_t get_generated_target(const generated_hsm_t* const pHsm, const state_t* const pCurrent,
+                                            uint32_t event)
+{
+  return pHsm->Targets[get_state_index(pHsm, pCurrent) * pHsm->Events + event - 1];
+}
+
+#endif // STATE_GENERATOR_H
@@ -0,0 +1,115 @@
+/**
+ * \file
+ * \brief States built at runtime, for the synthetic hierarchies of benchmarks
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// The members of state_t are constant, so each state is constructed once in its reserved slot.
+// The child states of a state are reserved together before the state is constructed,
+// as the state points to the first of them.
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "state_tree.h"
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Allocate the storage of states.
+ *
+ * \param pTree state_tree_t* const   state tree
+ * \param capacity uint32_t           maximum number of states
+ *
+ */
+void init_state_tree(state_tree_t* const pTree, uint32_t capacity)
+{
+  pTree->States = static_cast<state_t*>(calloc(capacity, sizeof(state_t)));
+  if((pTree->States == NULL) && (capacity != 0))
+  {
+    fprintf(stderr, "Out of memory for %u states\n", capacity);
+    exit(EXIT_FAILURE);
+  }
+  pTree->Capacity = capacity;
+  pTree->Count = 0;
+}
+
+//! Free the storage of states.
+void free_state_tree(state_tree_t* const pTree)
+{
+  free(pTree->States);
+  pTree->States = NULL;
+  pTree->Capacity = 0;
+  pTree->Count = 0;
+}
+
+/** \brief Reserve consecutive slots, e.g. for the child states of a state.
+ *
+ * \param pTree state_tree_t* const   state tree
+ * \param count uint32_t              number of states
+ * \return state_t*                   first slot, each slot must be constructed with construct_state
+ *
+ */
+state_t* reserve_states(state_tree_t* const pTree, uint32_t count)
+{
+  if(count > pTree->Capacity - pTree->Count)
+  {
+    fprintf(stderr, "State tree is full, capacity %u states\n", pTree->Capacity);
+    exit(EXIT_FAILURE);
+  }
+
+  state_t* const pSlot = &pTree->States[pTree->Count];
+  pTree->Count += count;
+  return pSlot;
+}
+
+/** \brief Construct a state in its reserved slot.
+ *  The hierarchy arguments are ignored by the finite state machine, and the Id when states have no Id.
+ *
+ * \param pSlot state_t* const            reserved slot
+ * \param handler state_handler           state handler
+ * \param entry state_handler             entry action, NULL if none
+ * \param exit state_handler              exit action, NULL if none
+ * \param id uint32_t                     state Id
+ * \param pParent const state_t* const    parent state, NULL for top states
+ * \param pNode const state_t* const      first child state, NULL for leaf states
+ * \param level uint32_t                  hierarchy level, 0 for top states
+ * \return const state_t*                 constructed state
+ *
+ */
+const state_t* construct_state(state_t* const pSlot, state_handler handler, state_handler entry,
+                               state_handler exit, uint32_t id, const state_t* const pParent,
+                               const state_t* const pNode, uint32_t level)
+{
+#if HSM_STATE_ID
+#define STATE_ID    id,
+#else
+#define STATE_ID
+  (void)id;
+#endif // HSM_STATE_ID
+
+#if HIERARCHICAL_STATES
+  return new (pSlot) state_t{handler, entry, exit, STATE_ID pParent, pNode, level};
+#else
+  (void)pParent;
+  (void)pNode;
+  (void)level;
+  return new (pSlot) state_t{handler, entry, exit, STATE_ID};
+#endif // HIERARCHICAL_STATES
+
+#undef STATE_ID
+}
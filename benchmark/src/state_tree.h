@@ -0,0 +1,48 @@
+/**
+ * \file
+ * \brief States built at runtime, for the synthetic hierarchies of benchmarks
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef STATE_TREE_H
+#define STATE_TREE_H
+
+#include <cstdint>
+
+#include "hsm.h"
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Storage of the states built at runtime. States don't move, so the pointers to them stay valid.
+typedef struct
+{
+  state_t* States;
+  uint32_t Capacity;
+  uint32_t Count;         //!< Number of reserved states
+}state_tree_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+extern void init_state_tree(state_tree_t* const pTree, uint32_t capacity);
+
+extern void free_state_tree(state_tree_t* const pTree);
+
+extern state_t* reserve_states(state_tree_t* const pTree, uint32_t count);
+
+extern const state_t* construct_state(state_t* const pSlot, state_handler handler, state_handler entry,
+                                      state_handler exit, uint32_t id, const state_t* const pParent,
+                                      const state_t* const pNode, uint32_t level);
+
+#endif // STATE_TREE_H
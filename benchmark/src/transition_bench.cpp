@@ -0,0 +1,278 @@
+/**
+ * \file
+ * \brief Benchmark of traverse_state and switch_state
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// Each iteration puts the state machine back in the source state and makes one transition.
+// The exit and entry actions count their calls, reported per transition.
+//
+// tree       the hierarchy of test/src/case/hierarchical_state_transition.txt and its transition classes
+// spine      synthetic hierarchy of the given depth. Each state of the spine has fan-out child states,
+//            the first of them continues the spine. A second spine starts from the last top state,
+//            there are at least two top states so that the transitions below cross the spines.
+//              sibling   leaf of the spine to its sibling
+//              up        leaf of the spine to the top state of the other spine
+//              down      top state of the other spine to the leaf of the spine
+//              across    leaf of the spine to the leaf of the other spine
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "bench.h"
+#include "hsm.h"
+#include "state_tree.h"
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#if HIERARCHICAL_STATES
+#define ENGINE_NAME         "hsm"
+#else
+#define ENGINE_NAME         "fsm"
+#endif // HIERARCHICAL_STATES
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+namespace
+{
+
+uint64_t Exit_Calls;
+uint64_t Entry_Calls;
+
+/*
+ *  --------------------- STATE HANDLERS ---------------------
+ */
+
+state_machine_result_t count_exit(state_machine_t* const)
+{
+  Exit_Calls++;
+  return EVENT_HANDLED;
+}
+
+state_machine_result_t count_entry(state_machine_t* const)
+{
+  Entry_Calls++;
+  return EVENT_HANDLED;
+}
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+typedef state_machine_result_t (*transition_t)(state_machine_t* const pState_Machine,
+                                               const state_t* const pTarget);
+
+void run_transition(const std::string& name, transition_t transition,
+                    const state_t* const pSource, const state_t* const pTarget)
+{
+  state_machine_t machine = state_machine_t();
+
+  bench_run(name, [&](uint64_t iterations)
+  {
+    Exit_Calls = 0;
+    Entry_Calls = 0;
+
+    for(uint64_t iteration = 0; iteration < iterations; iteration++)
+    {
+      machine.State = pSource;
+      if(transition(&machine, pTarget) != EVENT_HANDLED)
+      {
+        fprintf(stderr, "%s: transition failed\n", name.c_str());
+        exit(EXIT_FAILURE);
+      }
+    }
+
+    bench_count("exits", Exit_Calls);
+    bench_count("entries", Entry_Calls);
+    return iterations;
+  });
+}
+
+#if HIERARCHICAL_STATES
+
+/*
+ *  --------------------- HIERARCHY OF hierarchical_state_transition.txt ---------------------
+ */
+
+extern const state_t Level2_Child1[];
+extern const state_t Level2_Child3[];
+extern const state_t Level3_Child1[];
+extern const state_t Level3_Child3[];
+extern const state_t Level3_Child4[];
+
+const state_t Level1[] =
+{
+  {NULL, count_entry, count_exit, NULL, Level2_Child1, 0},
+  {NULL, count_entry, count_exit, NULL, Level2_Child3, 0},
+  {NULL, count_entry, count_exit, NULL, NULL, 0},
+};
+
+const state_t Level2_Child1[] =
+{
+  {NULL, count_entry, count_exit, &Level1[0], NULL, 1},
+  {NULL, count_entry, count_exit, &Level1[0], Level3_Child1, 1},
+};
+
+const state_t Level2_Child3[] =
+{
+  {NULL, count_entry, count_exit, &Level1[1], Level3_Child3, 1},
+  {NULL, count_entry, count_exit, &Level1[1], Level3_Child4, 1},
+};
+
+const state_t Level3_Child1[] =
+{
+  {NULL, count_entry, count_exit, &Level2_Child1[1], NULL, 2},
+  {NULL, count_entry, count_exit, &Level2_Child1[1], NULL, 2},
+};
+
+const state_t Level3_Child3[] =
+{
+  {NULL, count_entry, count_exit, &Level2_Child3[0], NULL, 2},
+};
+
+const state_t Level3_Child4[] =
+{
+  {NULL, count_entry, count_exit, &Level2_Child3[1], NULL, 2},
+};
+
+//! Transition scenarios of hierarchical_state_transition.txt
+typedef struct
+{
+  const char* Name;
+  const state_t* Source;
+  const state_t* Target;
+}scenario_t;
+
+const scenario_t Scenarios[] =
+{
+  {"same_parent/L3_Child1-L3_Child2", &Level3_Child1[0], &Level3_Child1[1]},
+  {"different_parent/L3_Child3-L3_Child4", &Level3_Child3[0], &Level3_Child4[0]},
+  {"different_parent/L3_Child4-L3_Child2", &Level3_Child4[0], &Level3_Child1[1]},
+  {"up/L3_Child3-L1_Child3", &Level3_Child3[0], &Level1[2]},
+  {"up/L3_Child1-L2_Child1", &Level3_Child1[0], &Level2_Child1[0]},
+  {"up/L3_Child4-L2_Child1", &Level3_Child4[0], &Level2_Child1[0]},
+  {"down/L1_Child3-L3_Child2", &Level1[2], &Level3_Child1[1]},
+  {"down/L2_Child1-L3_Child2", &Level2_Child1[0], &Level3_Child1[1]},
+  {"down/L2_Child1-L3_Child4", &Level2_Child1[0], &Level3_Child4[0]},
+};
+
+void run_scenarios(void)
+{
+  for(const scenario_t& scenario : Scenarios)
+  {
+    run_transition(std::string(ENGINE_NAME "/traverse_state/tree/") + scenario.Name, traverse_state,
+                   scenario.Source, scenario.Target);
+    run_transition(std::string(ENGINE_NAME "/switch_state/tree/") + scenario.Name, switch_state,
+                   scenario.Source, scenario.Target);
+  }
+}
+
+/*
+ *  --------------------- SYNTHETIC SPINE ---------------------
+ */
+
+//! Build a spine under the top state, returns its leaf.
+const state_t* build_spine(state_tree_t* const pTree, state_t* const pTop, uint32_t depth, uint32_t fanout)
+{
+  state_t* pState = pTop;
+  const state_t* pParent = NULL;
+
+  for(uint32_t level = 0; level < depth; level++)
+  {
+    state_t* const pChildren = (level + 1 < depth) ? reserve_states(pTree, fanout) : NULL;
+    construct_state(pState, NULL, count_entry, count_exit, 0, pParent, pChildren, level);
+
+    // Siblings of the next state of spine are leaf states.
+    for(uint32_t child = 1; (pChildren != NULL) && (child < fanout); child++)
+    {
+      construct_state(&pChildren[child], NULL, count_entry, count_exit, 0, pState, NULL, level + 1);
+    }
+
+    pParent = pState;
+    pState = pChildren;
+  }
+  return pParent;
+}
+
+void run_spine(uint32_t depth, uint32_t fanout)
+{
+  const std::string name = ENGINE_NAME "/traverse_state/spine/depth:" + std::to_string(depth)
+                           + "/fanout:" + std::to_string(fanout) + "/";
+
+  const uint32_t tops = (fanout > 1) ? fanout : 2;
+  state_tree_t tree;
+  init_state_tree(&tree, 2 * depth * fanout + tops);
+
+  state_t* const pTop = reserve_states(&tree, tops);
+  const state_t* const pLeaf = build_spine(&tree, &pTop[0], depth, fanout);
+  for(uint32_t top = 1; top < tops - 1; top++)
+  {
+    construct_state(&pTop[top], NULL, count_entry, count_exit, 0, NULL, NULL, 0);
+  }
+  const state_t* const pOther_Leaf = build_spine(&tree, &pTop[tops - 1], depth, fanout);
+  const state_t* const pOther_Top = &pTop[tops - 1];
+
+  if((fanout > 1) && (depth > 1))
+  {
+    run_transition(name + "sibling", traverse_state, pLeaf, pLeaf + fanout - 1);
+  }
+  run_transition(name + "up", traverse_state, pLeaf, pOther_Top);
+  run_transition(name + "down", traverse_state, pOther_Top, pLeaf);
+  run_transition(name + "across", traverse_state, pLeaf, pOther_Leaf);
+
+  free_state_tree(&tree);
+}
+
+#else
+
+const state_t Flat_States[] =
+{
+  {NULL, count_entry, count_exit},
+  {NULL, count_entry, count_exit},
+};
+
+#endif // HIERARCHICAL_STATES
+
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+int main(int argc, char* argv[])
+{
+  bench_init(argc, argv);
+
+#if HIERARCHICAL_STATES
+  run_scenarios();
+
+  for(uint32_t depth : {1u, 2u, 4u, 8u, 16u, 32u, 64u})
+  {
+    for(uint32_t fanout : {1u, 16u, 256u})
+    {
+      run_spine(depth, fanout);
+    }
+  }
+#else
+  run_transition(ENGINE_NAME "/switch_state/flat", switch_state, &Flat_States[0], &Flat_States[1]);
+#endif // HIERARCHICAL_STATES
+
+  return bench_finish();
+}
@@ -42,14 +42,14 @@ sem_t Semaphore;
  *  --------------------- Functions ---------------------
  */
 
-//! Callback function to log the events dispatched by state machine framework.
-void event_logger(uint32_t stateMachine, uint32_t state, uint32_t event)
+//! Logger function called by the state machine framework before dispatching the event.
+void state_machine_event_logger(uint32_t stateMachine, uint32_t state, uint32_t event)
 {
   printf("State Machine: %d, State: %d, Event: %d\n", stateMachine, state, event);
 }
 
-//! Callback function to log the result of event processed by state machine
-void result_logger(uint32_t state, state_machine_result_t result)
+//! Logger function called by the state machine framework with the result of event processed by state machine
+void state_machine_result_logger(uint32_t state, state_machine_result_t result)
 {
   printf("Result: %d, New State: %d\n", result, state);
 }
@@ -122,7 +122,7 @@ int main(void)
   {
     sem_wait(&Semaphore);   // Wait for event
 
-    if(dispatch_event(State_Machines, 1, event_logger, result_logger) == EVENT_UN_HANDLED)
+    if(dispatch_event(State_Machines, 1) == EVENT_UN_HANDLED)
     {
       printf("invalid event entered\n");
     }
@@ -26,6 +26,18 @@
  *  --------------------- DEFINITION ---------------------
  */
 
+// Print the oven actions and the prompts on the console.
+// The fleet load generator of the benchmarks builds the oven without console.
+#ifndef OVEN_CONSOLE
+#define OVEN_CONSOLE    1
+#endif // OVEN_CONSOLE
+
+#if OVEN_CONSOLE
+#define print_console(...)    printf(__VA_ARGS__)
+#else
+#define print_console(...)    ((void)0)
+#endif // OVEN_CONSOLE
+
 #define ALL_OVEN_STATES	\
 	ADD_ROOT_LEAF(DOOR_OPEN_STATE, door_open_handler, door_open_entry_handler, NULL)	\
 	ADD_ROOT(DOOR_CLOSE_STATE, NULL, door_close_entry_handler, NULL, Door_Close_State) \
@@ -143,10 +155,10 @@ void init_oven(oven_t* const pOven, uint32_t toastTime, door_status_t status)
   pOven->Lamp = false;
   pOven->Heater = false;
 
-  printf("Oven is initialized\n");
-  printf("Door is closed and oven is off\n");
-  printf("Press 's': to turn on Oven\n");
-  printf("Press 'o': to open the door\n");
+  print_console("Oven is initialized\n");
+  print_console("Door is closed and oven is off\n");
+  print_console("Press 's': to turn on Oven\n");
+  print_console("Press 'o': to open the door\n");
 }
 
 static state_machine_result_t door_open_handler(state_machine_t* const pState)
@@ -171,16 +183,16 @@ static state_machine_result_t door_open_handler(state_machine_t* const pState)
 
 static state_machine_result_t door_open_entry_handler(state_machine_t* const pState)
 {
-  printf("Turn on Oven lamp\n");
+  print_console("Turn on Oven lamp\n");
   ((oven_t*)pState)->Lamp = true;
 
-  printf("Press 'c': to close the door\n");
+  print_console("Press 'c': to close the door\n");
   return EVENT_HANDLED;
 }
 
 static state_machine_result_t door_close_entry_handler(state_machine_t* const pState)
 {
-  printf("Turn off Oven lamp\n");
+  print_console("Turn off Oven lamp\n");
   ((oven_t*)pState)->Lamp = false;
   return EVENT_HANDLED;
 }
@@ -209,8 +221,8 @@ static state_machine_result_t off_handler(state_machine_t* const pState)
 static state_machine_result_t off_entry_handler(state_machine_t* const pState)
 {
   (void)(pState);
-  printf("Press 's': to turn on Oven\n");
-  printf("Press 'o': to open the door\n");
+  print_console("Press 's': to turn on Oven\n");
+  print_console("Press 'o': to open the door\n");
   return EVENT_HANDLED;
 }
 
@@ -240,7 +252,7 @@ static state_machine_result_t on_handler(state_machine_t* const pState)
 static state_machine_result_t on_entry_handler(state_machine_t* const pState)
 {
   oven_t* const pOven = (oven_t*)pState;
-  printf("Turn on heater\n");
+  print_console("Turn on heater\n");
   pOven->Heater = true;
 
   if(pOven->Resume_Time)
@@ -248,8 +260,8 @@ static state_machine_result_t on_entry_handler(state_machine_t* const pState)
     pOven->Timer = pOven->Resume_Time;
     pOven->Resume_Time = 0;
   }
-  printf("Press 'q': to turn off Oven\n");
-  printf("Press 'o': to open the door\n");
+  print_console("Press 'q': to turn off Oven\n");
+  print_console("Press 'o': to open the door\n");
 
   return EVENT_HANDLED;
 }
@@ -257,7 +269,7 @@ static state_machine_result_t on_entry_handler(state_machine_t* const pState)
 static state_machine_result_t on_exit_handler(state_machine_t* const pState)
 {
   oven_t* const pOven = (oven_t*)pState;
-  printf("Turn Off heater\n");
+  print_console("Turn Off heater\n");
   pOven->Heater = false;
   return EVENT_HANDLED;
 }
@@ -21,16 +21,187 @@
 #include <stdio.h>
 
 #include "hsm.h"
+#include "hsm_probe.h"
+
+#if HSM_EVENT_OBJECTS
+#include "hsm_event.h"
+#endif // HSM_EVENT_OBJECTS
+
+#if HSM_ASYNC_COMPLETION
+#include "hsm_port.h"
+#endif // HSM_ASYNC_COMPLETION
+
+#if HSM_TRACE_BUFFER
+#include "hsm_trace.h"
+#else
+#define TRACE_RECORD_EVENT(index, pState_Machine, pState)               ((void)0)
+#define TRACE_RECORD_RESULT(index, pState_Machine, pState, result)      ((void)0)
+#define TRACE_RECORD_BUBBLE(index, pState_Machine, pState, pParent)     ((void)0)
+#define TRACE_RECORD_TRANSITION(pState_Machine, pSource, pTarget)       ((void)0)
+#define TRACE_RECORD_EXIT(pState_Machine, pState)                       ((void)0)
+#define TRACE_RECORD_ENTRY(pState_Machine, pState)                      ((void)0)
+#endif // HSM_TRACE_BUFFER
+
+#if HSM_RUNTIME_COUNTERS
+#include "hsm_counter.h"
+#else
+#define COUNT_DISPATCHER()                                              ((void)0)
+#define COUNT_RESTART()                                                 ((void)0)
+#define COUNT_EVENT(pState_Machine)                                     ((void)0)
+#define COUNT_RESULT(pState_Machine, result)                            ((void)0)
+#define COUNT_BUBBLE(pState_Machine)                                    ((void)0)
+#define COUNT_UNHANDLED(pState_Machine)                                 ((void)0)
+#define COUNT_TRANSITION(pState_Machine)                                ((void)0)
+#define COUNT_EXIT(pState_Machine)                                      ((void)0)
+#define COUNT_ENTRY(pState_Machine)                                     ((void)0)
+#endif // HSM_RUNTIME_COUNTERS
+
+#if HSM_FLIGHT_RECORDER
+#include "hsm_recorder.h"
+#else
+#define FLIGHT_RECORD_EVENT(pState_Machine, pState)                     ((void)0)
+#define FLIGHT_RECORD_RESULT(pState_Machine, pState, result)            ((void)0)
+#define FLIGHT_RECORD_TRANSITION(pState_Machine, pSource, pTarget)      ((void)0)
+#define FLIGHT_RECORD_UNHANDLED(index, pState_Machine, pState)          ((void)0)
+#endif // HSM_FLIGHT_RECORDER
+
+#if HSM_LATENCY_HISTOGRAM
+#include "hsm_histogram.h"
+#else
+#define HISTOGRAM_START(event, pState_Machine)                          ((void)0)
+#define HISTOGRAM_RECORD(cycles, event, index, pState)                  ((void)0)
+#endif // HSM_LATENCY_HISTOGRAM
+
+#if HSM_STATE_COVERAGE
+#include "hsm_coverage.h"
+#else
+#define COVERAGE_START_HANDLER()                                        ((void)0)
+#define COVERAGE_RECORD_HANDLER(cycles, pState)                         ((void)0)
+#define COVERAGE_RECORD_TRANSITION(pSource, pTarget)                    ((void)0)
+#endif // HSM_STATE_COVERAGE
+
+#if HSM_QUEUE_METRICS
+#include "hsm_queue.h"
+#else
+#define QUEUE_RECORD_DISPATCH(index, pState_Machine)                    ((void)0)
+#endif // HSM_QUEUE_METRICS
+
+#if HSM_SAMPLING_PROFILER
+#include "hsm_profiler.h"
+#else
+#define PROFILE_EVENT(saved, index, pState_Machine, pState)             ((void)0)
+#define PROFILE_RESULT(saved)                                           ((void)0)
+#endif // HSM_SAMPLING_PROFILER
+
+#if HSM_WATCHDOG
+#include "hsm_watchdog.h"
+#else
+#define WATCHDOG_START(kind, pState_Machine, pState)                    ((void)0)
+#define WATCHDOG_STOP()                                                 ((void)0)
+#endif // HSM_WATCHDOG
+
+#if HSM_STATE_RESIDENCY
+#include "hsm_residency.h"
+#else
+#define RESIDENCY_RECORD(pState_Machine, pSource)                       ((void)0)
+#endif // HSM_STATE_RESIDENCY
+
+//! The dispatcher measures the duration of handler calls, when any of the enabled features uses it.
+#define HSM_HANDLER_TIMER   (HSM_LATENCY_HISTOGRAM || HSM_STATE_COVERAGE)
+
+#if HSM_HANDLER_TIMER
+#include "hsm_port.h"
+#define HANDLER_TIMER_START(cycles)     ((cycles) = HSM_CYCLE_COUNTER())
+#define HANDLER_TIMER_STOP(cycles)      ((cycles) = HSM_CYCLE_COUNTER() - (cycles))
+#else
+#define HANDLER_TIMER_START(cycles)     ((void)0)
+#define HANDLER_TIMER_STOP(cycles)      ((void)0)
+#endif // HSM_HANDLER_TIMER
 
 /*
  *  --------------------- DEFINITION ---------------------
  */
 
-#define EXECUTE_HANDLER(handler, triggerd, state_machine)       \
+// Instrumentation points. Each point calls the user trace hook
+// followed by the enabled instrumentation of framework.
+// ON_EVENT and ON_RESULT are used only in the dispatcher, they share its local variables.
+
+#define ON_EVENT(index, pState_Machine, pState)                 \
+do{                                                             \
+  HSM_TRACE_EVENT(index, pState_Machine, pState);               \
+  TRACE_RECORD_EVENT(index, pState_Machine, pState);            \
+  PROBE_EVENT(index, pState_Machine, pState);                   \
+  COUNT_EVENT(pState_Machine);                                  \
+  FLIGHT_RECORD_EVENT(pState_Machine, pState);                  \
+  HISTOGRAM_START(handler_event, pState_Machine);               \
+  PROFILE_EVENT(profile_word, index, pState_Machine, pState);   \
+  COVERAGE_START_HANDLER();                                     \
+  HANDLER_TIMER_START(handler_cycles);                          \
+  WATCHDOG_START(WATCHDOG_HANDLER, pState_Machine, pState);     \
+} while(0)
+
+#define ON_RESULT(index, pState_Machine, pState, result)        \
+do{                                                             \
+  WATCHDOG_STOP();                                              \
+  HANDLER_TIMER_STOP(handler_cycles);                           \
+  PROFILE_RESULT(profile_word);                                 \
+  HISTOGRAM_RECORD(handler_cycles, handler_event, index, pState); \
+  COVERAGE_RECORD_HANDLER(handler_cycles, pState);              \
+  HSM_TRACE_RESULT(index, pState_Machine, pState, result);      \
+  TRACE_RECORD_RESULT(index, pState_Machine, pState, result);   \
+  PROBE_RESULT(index, pState_Machine, pState, result);          \
+  COUNT_RESULT(pState_Machine, result);                         \
+  FLIGHT_RECORD_RESULT(pState_Machine, pState, result);         \
+} while(0)
+
+#define ON_BUBBLE(index, pState_Machine, pState, pParent)       \
+do{                                                             \
+  HSM_TRACE_BUBBLE(index, pState_Machine, pState, pParent);     \
+  TRACE_RECORD_BUBBLE(index, pState_Machine, pState, pParent);  \
+  PROBE_BUBBLE(index, pState_Machine, pState, pParent);         \
+  COUNT_BUBBLE(pState_Machine);                                 \
+} while(0)
+
+#define ON_TRANSITION(pState_Machine, pSource, pTarget)         \
+do{                                                             \
+  HSM_TRACE_TRANSITION(pState_Machine, pSource, pTarget);       \
+  TRACE_RECORD_TRANSITION(pState_Machine, pSource, pTarget);    \
+  PROBE_TRANSITION(pState_Machine, pSource, pTarget);           \
+  COUNT_TRANSITION(pState_Machine);                             \
+  FLIGHT_RECORD_TRANSITION(pState_Machine, pSource, pTarget);   \
+  COVERAGE_RECORD_TRANSITION(pSource, pTarget);                 \
+  RESIDENCY_RECORD(pState_Machine, pSource);                    \
+} while(0)
+
+#define ON_EXIT(pState_Machine, pState)                         \
+do{                                                             \
+  HSM_TRACE_EXIT(pState_Machine, pState);                       \
+  TRACE_RECORD_EXIT(pState_Machine, pState);                    \
+  PROBE_EXIT(pState_Machine, pState);                           \
+  COUNT_EXIT(pState_Machine);                                   \
+} while(0)
+
+#define ON_ENTRY(pState_Machine, pState)                        \
+do{                                                             \
+  HSM_TRACE_ENTRY(pState_Machine, pState);                      \
+  TRACE_RECORD_ENTRY(pState_Machine, pState);                   \
+  PROBE_ENTRY(pState_Machine, pState);                          \
+  COUNT_ENTRY(pState_Machine);                                  \
+} while(0)
+
+#define ON_UNHANDLED(index, pState_Machine, pState)             \
+do{                                                             \
+  COUNT_UNHANDLED(pState_Machine);                              \
+  FLIGHT_RECORD_UNHANDLED(index, pState_Machine, pState);       \
+} while(0)
+
+#define EXECUTE_HANDLER(handler, kind, pState, triggerd, state_machine) \
 do{                                                             \
   if(handler != NULL)                                           \
   {                                                             \
+    WATCHDOG_START(kind, state_machine, pState);                \
     state_machine_result_t result = handler(state_machine);     \
+    WATCHDOG_STOP();                                            \
     switch(result)                                              \
     {                                                           \
     case TRIGGERED_TO_SELF:                                     \
@@ -38,12 +209,56 @@ do{                                                             \
     case EVENT_HANDLED:                                         \
       break;                                                    \
                                                                 \
+    ACTION_PENDING_CASE                                         \
     default:                                                    \
       return result;                                            \
     }                                                           \
   }                                                             \
 } while(0)
 
+#define EXECUTE_EXIT(pState, triggerd, state_machine)           \
+do{                                                             \
+  ON_EXIT(state_machine, pState);                               \
+  EXECUTE_HANDLER((pState)->Exit, WATCHDOG_EXIT, pState, triggerd, state_machine); \
+} while(0)
+
+#define EXECUTE_ENTRY(pState, triggerd, state_machine)          \
+do{                                                             \
+  ON_ENTRY(state_machine, pState);                              \
+  EXECUTE_HANDLER((pState)->Entry, WATCHDOG_ENTRY, pState, triggerd, state_machine); \
+} while(0)
+
+#if HSM_ASYNC_COMPLETION
+//! Values of state_machine_t::Completion
+#define COMPLETION_NONE       0     //!< No event is pending for completion
+#define COMPLETION_PARKED     1     //!< State machine waits for complete_event
+#define COMPLETION_DONE       2     //!< complete_event is called, result is added to this value
+
+// Only the state handler may complete asynchronously,
+// EVENT_PENDING of an exit or entry action stops the transition as an error.
+#define ACTION_PENDING_CASE   case EVENT_PENDING: return EVENT_UN_HANDLED;
+#else
+#define ACTION_PENDING_CASE
+#endif // HSM_ASYNC_COMPLETION
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+//! Clear the Event of state machine, once its processing is over.
+static inline void clear_event(state_machine_t* const pState_Machine)
+{
+  pState_Machine->Event = 0;
+#if HSM_EVENT_OBJECTS
+  // Run to completion is over, return the event object to its pool.
+  if(pState_Machine->Event_Object != NULL)
+  {
+    release_event(pState_Machine->Event_Object);
+    pState_Machine->Event_Object = NULL;
+  }
+#endif // HSM_EVENT_OBJECTS
+}
+
 /*
  *  --------------------- FUNCTION BODY ---------------------
  */
@@ -56,41 +271,81 @@ do{                                                             \
  *
  */
 state_machine_result_t dispatch_event(state_machine_t* const pState_Machine[]
-                                      ,uint32_t quantity
-#if STATE_MACHINE_LOGGER
-                                      ,state_machine_event_logger event_logger
-                                      ,state_machine_result_logger result_logger
-#endif // STATE_MACHINE_LOGGER
-                                      )
+                                      ,uint32_t quantity)
 {
   state_machine_result_t result;
+#if HSM_HANDLER_TIMER
+  uint64_t handler_cycles;  // Cycle counter at the call of state handler, then the duration of call
+#endif // HSM_HANDLER_TIMER
+#if HSM_LATENCY_HISTOGRAM
+  uint32_t handler_event;   // Event passed to the state handler
+#endif // HSM_LATENCY_HISTOGRAM
+#if HSM_SAMPLING_PROFILER
+  uint64_t profile_word;    // Activity word of the thread before the call of state handler
+#endif // HSM_SAMPLING_PROFILER
+
+  PROBE_DISPATCHER(pState_Machine, quantity);
+  COUNT_DISPATCHER();
 
   // Iterate through all state machines in the array to check if event is pending to dispatch.
   for(uint32_t index = 0; index < quantity;)
   {
-    if(pState_Machine[index]->Event == 0)
+#if HSM_ASYNC_COMPLETION
+    const uint32_t completion = HSM_ATOMIC_LOAD(&pState_Machine[index]->Completion);
+    if(completion == COMPLETION_PARKED)
     {
-      index++;
+      index++;    // Skip the state machine till its pending event is completed.
       continue;
     }
+#endif // HSM_ASYNC_COMPLETION
+
+    if(pState_Machine[index]->Event == 0)
+    {
+#if HSM_EVENT_OBJECTS
+      // Load the next posted event, if any.
+      if(load_posted_event(pState_Machine[index]) == false)
+#endif // HSM_EVENT_OBJECTS
+      {
+        index++;
+        continue;
+      }
+#if HSM_EVENT_OBJECTS
+      QUEUE_RECORD_DISPATCH(index, pState_Machine[index]);
+#endif // HSM_EVENT_OBJECTS
+    }
 
     const state_t* pState = pState_Machine[index]->State;
+#if HSM_ASYNC_COMPLETION
+    bool completed = (completion != COMPLETION_NONE);
+    if(completed)
+    {
+      // Asynchronous processing is over. Take the result as if the parked handler returned it.
+      HSM_ATOMIC_STORE(&pState_Machine[index]->Completion, COMPLETION_NONE);
+      pState = pState_Machine[index]->Pending_State;
+      result = (state_machine_result_t)(completion - COMPLETION_DONE);
+    }
+#endif // HSM_ASYNC_COMPLETION
     do
     {
-#if STATE_MACHINE_LOGGER
-      event_logger(index, pState->Id, pState_Machine[index]->Event);
-#endif // STATE_MACHINE_LOGGER
-        // Call the state handler.
-      result = pState->Handler(pState_Machine[index]);
-#if STATE_MACHINE_LOGGER
-      result_logger(pState_Machine[index]->State->Id, result);
-#endif // STATE_MACHINE_LOGGER
+#if HSM_ASYNC_COMPLETION
+      if(completed)
+      {
+        completed = false;
+      }
+      else
+#endif // HSM_ASYNC_COMPLETION
+      {
+        ON_EVENT(index, pState_Machine[index], pState);
+          // Call the state handler.
+        result = pState->Handler(pState_Machine[index]);
+        ON_RESULT(index, pState_Machine[index], pState, result);
+      }
 
       switch(result)
       {
       case EVENT_HANDLED:
         // Clear event, if successfully handled by state handler.
-        pState_Machine[index]->Event = 0;
+        clear_event(pState_Machine[index]);
 
         // intentional fall through
 
@@ -98,6 +353,7 @@ state_machine_result_t dispatch_event(state_machine_t* const pState_Machine[]
         // and posted a new event to itself.
       case TRIGGERED_TO_SELF:
 
+        COUNT_RESTART();
         index = 0;  // Restart the event dispatcher from the first state machine.
         break;
 
@@ -112,26 +368,74 @@ state_machine_result_t dispatch_event(state_machine_t* const pState_Machine[]
           if(pState->Parent == NULL)   // Is Node reached top
           {
             // This is a fatal error. terminate state machine.
+            ON_UNHANDLED(index, pState_Machine[index], pState);
             return EVENT_UN_HANDLED;
           }
 
+          ON_BUBBLE(index, pState_Machine[index], pState, pState->Parent);
           pState = pState->Parent;        // traverse to parent state
         }while(pState->Handler == NULL);   // repeat again if parent state doesn't have handler
         continue;
     #endif // HIERARCHICAL_STATES
 
+    #if HSM_ASYNC_COMPLETION
+      // State handler started the event processing and completes it later.
+      case EVENT_PENDING:
+        {
+          uint32_t expected = COMPLETION_NONE;
+          pState_Machine[index]->Pending_State = pState;
+          // Park the state machine, unless the event is already completed.
+          HSM_ATOMIC_CAS(&pState_Machine[index]->Completion, &expected, COMPLETION_PARKED);
+        }
+        break;
+    #endif // HSM_ASYNC_COMPLETION
+
       // Either state handler could not handle the event or it has returned
       // the unknown return code. Terminate the state machine.
       default:
+    #if !HIERARCHICAL_STATES
+        if(result == EVENT_UN_HANDLED)
+        {
+          // Finite state has no parent to pass the event to.
+          ON_UNHANDLED(index, pState_Machine[index], pState);
+        }
+    #endif // HIERARCHICAL_STATES
         return result;
       }
       break;
 
     }while(1);
   }
+
+#if HSM_ASYNC_COMPLETION
+  for(uint32_t index = 0; index < quantity; index++)
+  {
+    if(HSM_ATOMIC_LOAD(&pState_Machine[index]->Completion) != COMPLETION_NONE)
+    {
+      return EVENT_PENDING;
+    }
+  }
+#endif // HSM_ASYNC_COMPLETION
   return EVENT_HANDLED;
 }
 
+#if HSM_ASYNC_COMPLETION
+/** \brief Complete the event of state machine, whose handler has returned EVENT_PENDING.
+ *  It is safe to call from any thread. Call dispatch_event afterwards to resume the state machine.
+ *
+ * \param pState_Machine state_machine_t* const   state machine with pending event
+ * \param result state_machine_result_t           EVENT_HANDLED to clear the Event,
+ *                                                TRIGGERED_TO_SELF to dispatch the Event again
+ *                                                or EVENT_UN_HANDLED to pass the Event to the parent state
+ *                                                of the state whose handler returned EVENT_PENDING.
+ *
+ */
+void complete_event(state_machine_t* const pState_Machine, state_machine_result_t result)
+{
+  HSM_ATOMIC_STORE(&pState_Machine->Completion, COMPLETION_DONE + (uint32_t)result);
+}
+#endif // HSM_ASYNC_COMPLETION
+
 /** \brief Switch to target states without traversing to hierarchical levels.
  *
  * \param pState_Machine state_machine_t* const   pointer to state machine
@@ -144,12 +448,13 @@ extern state_machine_result_t switch_state(state_machine_t* const pState_Machine
 {
   const state_t* const pSource_State = pState_Machine->State;
   bool triggered_to_self = false;
+  ON_TRANSITION(pState_Machine, pSource_State, pTarget_State);
   pState_Machine->State = pTarget_State;    // Save the target node
 
   // Call Exit function before leaving the Source state.
-    EXECUTE_HANDLER(pSource_State->Exit, triggered_to_self, pState_Machine);
+    EXECUTE_EXIT(pSource_State, triggered_to_self, pState_Machine);
   // Call entry function before entering the target state.
-    EXECUTE_HANDLER(pTarget_State->Entry, triggered_to_self, pState_Machine);
+    EXECUTE_ENTRY(pTarget_State, triggered_to_self, pState_Machine);
 
   if(triggered_to_self == true)
   {
@@ -173,6 +478,7 @@ state_machine_result_t traverse_state(state_machine_t* const pState_Machine,
 {
   const state_t *pSource_State = pState_Machine->State;
   bool triggered_to_self = false;
+  ON_TRANSITION(pState_Machine, pSource_State, pTarget_State);
   pState_Machine->State = pTarget_State;    // Save the target node
 
 #if (HSM_USE_VARIABLE_LENGTH_ARRAY == 1)
@@ -198,7 +504,7 @@ state_machine_result_t traverse_state(state_machine_t* const pState_Machine,
     // till it matches with target state hierarchy level.
     while(pSource_State->Level > pTarget_State->Level)
     {
-      EXECUTE_HANDLER(pSource_State->Exit, triggered_to_self, pState_Machine);
+      EXECUTE_EXIT(pSource_State, triggered_to_self, pState_Machine);
       pSource_State = pSource_State->Parent;
     }
   }
@@ -218,7 +524,7 @@ state_machine_result_t traverse_state(state_machine_t* const pState_Machine,
   // Traverse the source & target state to upward, till we find their common parent.
   while(pSource_State->Parent != pTarget_State->Parent)
   {
-    EXECUTE_HANDLER(pSource_State->Exit, triggered_to_self, pState_Machine);
+    EXECUTE_EXIT(pSource_State, triggered_to_self, pState_Machine);
     pSource_State = pSource_State->Parent;  // Move source state to upward state.
 
     pTarget_Path[index++] = pTarget_State;  // Store the target node path.
@@ -226,15 +532,15 @@ state_machine_result_t traverse_state(state_machine_t* const pState_Machine,
   }
 
   // Call Exit function before leaving the Source state.
-    EXECUTE_HANDLER(pSource_State->Exit, triggered_to_self, pState_Machine);
+    EXECUTE_EXIT(pSource_State, triggered_to_self, pState_Machine);
   // Call entry function before entering the target state.
-    EXECUTE_HANDLER(pTarget_State->Entry, triggered_to_self, pState_Machine);
+    EXECUTE_ENTRY(pTarget_State, triggered_to_self, pState_Machine);
 
     // Now traverse down to the target node & call their entry functions.
     while(index)
     {
       index--;
-      EXECUTE_HANDLER(pTarget_Path[index]->Entry, triggered_to_self, pState_Machine);
+      EXECUTE_ENTRY(pTarget_Path[index], triggered_to_self, pState_Machine);
     }
 
   if(triggered_to_self == true)
@@ -36,6 +36,154 @@
 #define HSM_USE_VARIABLE_LENGTH_ARRAY 1
 #endif
 
+#ifndef HSM_EVENT_OBJECTS
+#define HSM_EVENT_OBJECTS       0         //!< Disable the pool backed event objects
+#endif // HSM_EVENT_OBJECTS
+
+#ifndef HSM_ASYNC_COMPLETION
+#define HSM_ASYNC_COMPLETION    0         //!< Disable the asynchronous completion of event
+#endif // HSM_ASYNC_COMPLETION
+
+#ifndef HSM_TRACE_BUFFER
+#define HSM_TRACE_BUFFER        0         //!< Disable the binary trace buffer
+#endif // HSM_TRACE_BUFFER
+
+#if HSM_TRACE_BUFFER
+#ifndef HSM_TRACE_BUFFER_SIZE
+#define HSM_TRACE_BUFFER_SIZE   1024      //!< Number of records in trace buffer of each thread, power of 2
+#endif // HSM_TRACE_BUFFER_SIZE
+
+#ifndef HSM_TRACE_MAX_THREADS
+#define HSM_TRACE_MAX_THREADS   4         //!< Maximum number of threads recording the trace
+#endif // HSM_TRACE_MAX_THREADS
+#endif // HSM_TRACE_BUFFER
+
+#ifndef HSM_LATENCY_HISTOGRAM
+#define HSM_LATENCY_HISTOGRAM   0         //!< Disable the handler latency histograms
+#endif // HSM_LATENCY_HISTOGRAM
+
+#if HSM_LATENCY_HISTOGRAM
+#ifndef HSM_HISTOGRAM_MAX_STATES
+#define HSM_HISTOGRAM_MAX_STATES      16  //!< State Ids from 0 to max - 1 have their own histograms
+#endif // HSM_HISTOGRAM_MAX_STATES
+
+#ifndef HSM_HISTOGRAM_MAX_EVENTS
+#define HSM_HISTOGRAM_MAX_EVENTS      16  //!< Events from 0 to max - 1 have their own histograms
+#endif // HSM_HISTOGRAM_MAX_EVENTS
+
+#ifndef HSM_HISTOGRAM_MAX_MACHINES
+#define HSM_HISTOGRAM_MAX_MACHINES    8   //!< State machine index from 0 to max - 1 have their own histograms
+#endif // HSM_HISTOGRAM_MAX_MACHINES
+#endif // HSM_LATENCY_HISTOGRAM
+
+#ifndef HSM_QUEUE_METRICS
+#define HSM_QUEUE_METRICS       0         //!< Disable the queue depth and event wait time metrics
+#endif // HSM_QUEUE_METRICS
+
+#if HSM_QUEUE_METRICS
+#if !HSM_EVENT_OBJECTS
+#error "HSM_QUEUE_METRICS requires HSM_EVENT_OBJECTS"
+#endif
+
+#ifndef HSM_QUEUE_MAX_MACHINES
+#define HSM_QUEUE_MAX_MACHINES        8   //!< State machine index from 0 to max - 1 have their own wait histograms
+#endif // HSM_QUEUE_MAX_MACHINES
+#endif // HSM_QUEUE_METRICS
+
+//! Histogram functions are used by the latency histograms and the queue metrics.
+#define HSM_HISTOGRAMS    (HSM_LATENCY_HISTOGRAM || HSM_QUEUE_METRICS)
+
+#if HSM_HISTOGRAMS
+#ifndef HSM_HISTOGRAM_SUB_BUCKET_BITS
+#define HSM_HISTOGRAM_SUB_BUCKET_BITS 2   //!< Each power of 2 range is split in 2^bits buckets
+#endif // HSM_HISTOGRAM_SUB_BUCKET_BITS
+
+#ifndef HSM_HISTOGRAM_MAX_BITS
+#define HSM_HISTOGRAM_MAX_BITS        40  //!< Latency of 2^bits ticks or more is recorded in the last bucket
+#endif // HSM_HISTOGRAM_MAX_BITS
+#endif // HSM_HISTOGRAMS
+
+#ifndef HSM_RUNTIME_COUNTERS
+#define HSM_RUNTIME_COUNTERS    0         //!< Disable the runtime counters
+#endif // HSM_RUNTIME_COUNTERS
+
+#if HSM_RUNTIME_COUNTERS
+#ifndef HSM_COUNTER_MAX_THREADS
+#define HSM_COUNTER_MAX_THREADS 8         //!< Maximum number of threads with their own global counters
+#endif // HSM_COUNTER_MAX_THREADS
+#endif // HSM_RUNTIME_COUNTERS
+
+#ifndef HSM_FLIGHT_RECORDER
+#define HSM_FLIGHT_RECORDER     0         //!< Disable the flight recorder of state machines
+#endif // HSM_FLIGHT_RECORDER
+
+#if HSM_FLIGHT_RECORDER
+#ifndef HSM_FLIGHT_RECORDER_SIZE
+#define HSM_FLIGHT_RECORDER_SIZE  16      //!< Number of recent records kept by each state machine, power of 2
+#endif // HSM_FLIGHT_RECORDER_SIZE
+#endif // HSM_FLIGHT_RECORDER
+
+#ifndef HSM_STATE_COVERAGE
+#define HSM_STATE_COVERAGE      0         //!< Disable the transition coverage and handler time of states
+#endif // HSM_STATE_COVERAGE
+
+#if HSM_STATE_COVERAGE
+#ifndef HSM_COVERAGE_MAX_STATES
+#define HSM_COVERAGE_MAX_STATES   64      //!< States with Ids from 0 to max - 1 can be registered for the coverage
+#endif // HSM_COVERAGE_MAX_STATES
+#endif // HSM_STATE_COVERAGE
+
+#ifndef HSM_SAMPLING_PROFILER
+#define HSM_SAMPLING_PROFILER   0         //!< Disable the sampling profiler
+#endif // HSM_SAMPLING_PROFILER
+
+#if HSM_SAMPLING_PROFILER
+#ifndef HSM_PROFILER_BUCKETS
+#define HSM_PROFILER_BUCKETS    256       //!< Number of distinct (machine, state, event) samples, power of 2
+#endif // HSM_PROFILER_BUCKETS
+#endif // HSM_SAMPLING_PROFILER
+
+#ifndef HSM_WATCHDOG
+#define HSM_WATCHDOG            0         //!< Disable the slow handler watchdog
+#endif // HSM_WATCHDOG
+
+#if HSM_WATCHDOG
+#ifndef HSM_WATCHDOG_MAX_STATES
+#define HSM_WATCHDOG_MAX_STATES   16      //!< State Ids from 0 to max - 1 can have their own threshold
+#endif // HSM_WATCHDOG_MAX_STATES
+
+#ifndef HSM_WATCHDOG_MAX_THREADS
+#define HSM_WATCHDOG_MAX_THREADS  8       //!< Maximum number of dispatching threads checked by the watchdog
+#endif // HSM_WATCHDOG_MAX_THREADS
+
+#ifndef HSM_WATCHDOG_MAX_DEPTH
+#define HSM_WATCHDOG_MAX_DEPTH    4       //!< Maximum nesting of watched calls, e.g. entry action in the handler
+#endif // HSM_WATCHDOG_MAX_DEPTH
+
+#ifndef HSM_WATCHDOG_VIOLATIONS
+#define HSM_WATCHDOG_VIOLATIONS   16      //!< Number of recent violations kept by the watchdog, power of 2
+#endif // HSM_WATCHDOG_VIOLATIONS
+#endif // HSM_WATCHDOG
+
+#ifndef HSM_STATE_RESIDENCY
+#define HSM_STATE_RESIDENCY     0         //!< Disable the time in state accounting
+#endif // HSM_STATE_RESIDENCY
+
+#if HSM_STATE_RESIDENCY
+#ifndef HSM_RESIDENCY_MAX_STATES
+#define HSM_RESIDENCY_MAX_STATES  16      //!< Time in state is accounted for state Ids from 0 to max - 1
+#endif // HSM_RESIDENCY_MAX_STATES
+#endif // HSM_STATE_RESIDENCY
+
+#ifndef HSM_USDT_PROBES
+#define HSM_USDT_PROBES         1         //!< Enable the USDT probes, on the platforms that support them
+#endif // HSM_USDT_PROBES
+
+//! state_t contains the Id, when any of the enabled features identifies the states.
+#define HSM_STATE_ID    (STATE_MACHINE_LOGGER || HSM_TRACE_BUFFER || HSM_LATENCY_HISTOGRAM \
+                         || HSM_SAMPLING_PROFILER || HSM_WATCHDOG || HSM_STATE_RESIDENCY \
+                         || HSM_STATE_COVERAGE)
+
 /*
  *  --------------------- ENUMERATION ---------------------
  */
@@ -47,6 +195,8 @@ typedef enum
   EVENT_UN_HANDLED,    //!< Event could not be handled.
   //!< Handler handled the Event successfully and posted new event to itself.
   TRIGGERED_TO_SELF,
+  //!< Handler started the Event processing, it completes later through complete_event.
+  EVENT_PENDING,
 }state_machine_result_t;
 
 /*
@@ -61,8 +211,6 @@ typedef struct finite_state state_t;
 
 typedef struct state_machine_t state_machine_t;
 typedef state_machine_result_t (*state_handler) (state_machine_t* const State);
-typedef void (*state_machine_event_logger)(uint32_t state_machine, uint32_t state, uint32_t event);
-typedef void (*state_machine_result_logger)(uint32_t state, state_machine_result_t result);
 
 //! finite state structure
 struct finite_state{
@@ -70,7 +218,7 @@ struct finite_state{
   state_handler Entry;        //!< Entry action for state
   state_handler Exit;          //!< Exit action for state.
 
-#if STATE_MACHINE_LOGGER
+#if HSM_STATE_ID
   uint32_t Id;              //!< unique identifier of state within the single state machine
 #endif
 };
@@ -82,7 +230,7 @@ struct hierarchical_state
   state_handler Entry;        //!< Entry action for state
   state_handler Exit;          //!< Exit action for state.
 
-#if STATE_MACHINE_LOGGER
+#if HSM_STATE_ID
   uint32_t Id;              //!< unique identifier of state within the single state machine
 #endif
 
@@ -91,13 +239,176 @@ struct hierarchical_state
   uint32_t Level;            //!< Hierarchy level from the top state.
 };
 
+#if HSM_EVENT_OBJECTS
+typedef struct event_t event_t;
+
+//! Header of an event object. It must be the first member of the user event structure.
+struct event_t
+{
+  uint32_t Id;                    //!< Event value dispatched to the state machine
+  uint32_t Free_Next;             //!< Index of next free block, used by the event pool
+  struct event_pool_t* Pool;      //!< Pool owning the event object
+  event_t* Next;                  //!< Next event in the event queue of state machine
+#if HSM_QUEUE_METRICS
+  uint64_t Post_Time;             //!< HSM_TIMESTAMP() at the post of event
+#endif // HSM_QUEUE_METRICS
+};
+#endif // HSM_EVENT_OBJECTS
+
+#if HSM_RUNTIME_COUNTERS
+//! Activity counters of state machine. They only increase, compute the rates from the difference of snapshots.
+typedef struct
+{
+  uint64_t Handler_Calls;   //!< State handler calls, including the parent states the event bubbled to
+  uint64_t Handled;         //!< EVENT_HANDLED results
+  uint64_t Triggered;       //!< TRIGGERED_TO_SELF results
+  uint64_t Pending;         //!< EVENT_PENDING results
+  uint64_t Unhandled;       //!< Events that are not handled up to the top state
+  uint64_t Bubbles;         //!< Steps of unhandled events to the parent state
+  uint64_t Transitions;     //!< switch_state and traverse_state calls
+  uint64_t Exits;           //!< States exited in the transitions
+  uint64_t Entries;         //!< States entered in the transitions
+}state_machine_counters_t;
+#endif // HSM_RUNTIME_COUNTERS
+
+#if HSM_QUEUE_METRICS
+//! Depth of the event queue of state machine
+typedef struct
+{
+  uint32_t Depth;           //!< Posted events that are not yet dispatched
+  uint32_t High_Water;      //!< Highest depth since the last reset
+}queue_depth_t;
+#endif // HSM_QUEUE_METRICS
+
+#if HSM_FLIGHT_RECORDER
+//! Type of flight record
+typedef enum
+{
+  FLIGHT_DISPATCH,      //!< Event is dispatched to the handler of State
+  FLIGHT_RESULT,        //!< Handler of State has returned the Result
+  FLIGHT_TRANSITION,    //!< Transition from State to Target has begun
+}flight_record_type_t;
+
+//! A step of the event processing recorded by the flight recorder
+typedef struct
+{
+  const state_t* State;     //!< State handling the event, or source state of the transition
+  const state_t* Target;    //!< Target state of the transition
+  uint32_t Event;           //!< Event of the state machine
+  uint8_t Type;             //!< flight_record_type_t
+  uint8_t Result;           //!< state_machine_result_t of FLIGHT_RESULT record
+}flight_record_t;
+
+//! Circular buffer of the recent records of a state machine
+typedef struct
+{
+  flight_record_t Records[HSM_FLIGHT_RECORDER_SIZE];
+  uint32_t Count;           //!< Number of records since the start, the newest is at (Count - 1) % size
+}flight_recorder_t;
+#endif // HSM_FLIGHT_RECORDER
+
+#if HSM_STATE_RESIDENCY
+//! Time spent by a state machine in each state, in ticks of HSM_TIMESTAMP()
+typedef struct
+{
+  uint64_t Enter_Time;                        //!< Start of the current state, 0 till the accounting starts
+  uint64_t Time[HSM_RESIDENCY_MAX_STATES];    //!< Completed time in each state Id, including its child states
+}state_residency_t;
+#endif // HSM_STATE_RESIDENCY
+
 //! Abstract state machine structure
 struct state_machine_t
 {
    uint32_t Event;          //!< Pending Event for state machine
    const state_t* State;    //!< State of state machine.
+
+#if HSM_EVENT_OBJECTS
+   event_t* Event_Object;   //!< Event object of the pending Event. NULL for plain events.
+   event_t* Inbox;          //!< Posted events waiting for the dispatcher, newest first.
+   event_t* Queue;          //!< Events taken from the inbox, oldest first.
+#endif // HSM_EVENT_OBJECTS
+
+#if HSM_ASYNC_COMPLETION
+   uint32_t Completion;     //!< Asynchronous completion status of the pending Event.
+   const state_t* Pending_State;  //!< State whose handler returned EVENT_PENDING.
+#endif // HSM_ASYNC_COMPLETION
+
+#if HSM_RUNTIME_COUNTERS
+   state_machine_counters_t Counters;   //!< Activity counters, written by the dispatching thread only.
+#endif // HSM_RUNTIME_COUNTERS
+
+#if HSM_QUEUE_METRICS
+   queue_depth_t Queue_Depth;           //!< Depth of the posted events, updated by the posting threads.
+#endif // HSM_QUEUE_METRICS
+
+#if HSM_FLIGHT_RECORDER
+   flight_recorder_t Recorder;          //!< Recent dispatches and transitions of the state machine.
+#endif // HSM_FLIGHT_RECORDER
+
+#if HSM_STATE_RESIDENCY
+   state_residency_t Residency;         //!< Time in each state, written by the dispatching thread only.
+#endif // HSM_STATE_RESIDENCY
 };
 
+/*
+ *  --------------------- TRACE HOOKS ---------------------
+ */
+
+// The trace hooks are resolved at compile time. Each hook can be overridden by
+// defining it in hsm_config.h, e.g. to call an inline function. The hooks that
+// are not defined compile to nothing.
+
+#if STATE_MACHINE_LOGGER
+
+#ifndef HSM_TRACE_EVENT
+//! Logs the event before it is dispatched to the handler of pState.
+#define HSM_TRACE_EVENT(index, pState_Machine, pState) \
+        state_machine_event_logger(index, (pState)->Id, (pState_Machine)->Event)
+#endif // HSM_TRACE_EVENT
+
+#ifndef HSM_TRACE_RESULT
+//! Logs the result of handler of pState along with the new state of the state machine.
+#define HSM_TRACE_RESULT(index, pState_Machine, pState, result) \
+        state_machine_result_logger((pState_Machine)->State->Id, result)
+#endif // HSM_TRACE_RESULT
+
+#endif // STATE_MACHINE_LOGGER
+
+#ifndef HSM_TRACE_EVENT
+//! Called before the event is dispatched to the handler of pState.
+#define HSM_TRACE_EVENT(index, pState_Machine, pState)                ((void)0)
+#endif
+
+#ifndef HSM_TRACE_RESULT
+//! Called after the handler of pState has returned the result.
+#define HSM_TRACE_RESULT(index, pState_Machine, pState, result)       ((void)0)
+#endif
+
+#ifndef HSM_TRACE_BUBBLE
+//! Called when an unhandled event is passed from pState to its parent state pParent.
+#define HSM_TRACE_BUBBLE(index, pState_Machine, pState, pParent)      ((void)0)
+#endif
+
+#ifndef HSM_TRACE_TRANSITION
+//! Called when switch_state or traverse_state begins the transition.
+#define HSM_TRACE_TRANSITION(pState_Machine, pSource, pTarget)        ((void)0)
+#endif
+
+#ifndef HSM_TRACE_EXIT
+//! Called when state machine exits the pState, before its exit action.
+#define HSM_TRACE_EXIT(pState_Machine, pState)                        ((void)0)
+#endif
+
+#ifndef HSM_TRACE_ENTRY
+//! Called when state machine enters the pState, before its entry action.
+#define HSM_TRACE_ENTRY(pState_Machine, pState)                       ((void)0)
+#endif
+
+#ifndef HSM_TRACE_POST
+//! Called by post_event on the posting thread, before the event object pEvent is visible to the dispatcher.
+#define HSM_TRACE_POST(pState_Machine, pEvent)                        ((void)0)
+#endif
+
 /*
  *  --------------------- EXPORTED FUNCTION ---------------------
  */
@@ -107,12 +418,7 @@ extern "C"  {
 #endif // __cplusplus
 
 extern state_machine_result_t dispatch_event(state_machine_t* const pState_Machine[],
-                                            uint32_t quantity
-#if STATE_MACHINE_LOGGER
-                                            ,state_machine_event_logger event_logger
-                                            ,state_machine_result_logger result_logger
-#endif // STATE_MACHINE_LOGGER
-                                            );
+                                            uint32_t quantity);
 
 #if HIERARCHICAL_STATES
 extern state_machine_result_t traverse_state(state_machine_t* const pState_Machine,
@@ -122,6 +428,16 @@ extern state_machine_result_t traverse_state(state_machine_t* const pState_Machi
 extern state_machine_result_t switch_state(state_machine_t* const pState_Machine,
                                                     const state_t* const pTarget_State);
 
+#if HSM_ASYNC_COMPLETION
+extern void complete_event(state_machine_t* const pState_Machine, state_machine_result_t result);
+#endif // HSM_ASYNC_COMPLETION
+
+#if STATE_MACHINE_LOGGER
+// Logger functions to be implemented by the user.
+extern void state_machine_event_logger(uint32_t state_machine, uint32_t state, uint32_t event);
+extern void state_machine_result_logger(uint32_t state, state_machine_result_t result);
+#endif // STATE_MACHINE_LOGGER
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -0,0 +1,351 @@
+/**
+ * \file
+ * \brief C++20 coroutine state handlers
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_COROUTINE_HPP
+#define HSM_COROUTINE_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+
+#include "hsm.h"
+
+namespace hsm
+{
+
+/** \brief Arena of the coroutine frames of a state machine.
+ *
+ * The arena holds a frame for each coroutine state that can be suspended at a time, e.g. a coroutine state
+ * and its coroutine parent state. Each frame is prefixed by a pointer to the arena to find it back in
+ * operator delete.
+ */
+class coroutine_arena
+{
+public:
+  static constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+  coroutine_arena(unsigned char* pBuffer, std::size_t slot_size, std::uint32_t slots) noexcept
+    : pBuffer_(pBuffer), slot_size_(slot_size), slots_(slots), used_(0) {}
+
+  void* allocate(std::size_t size) noexcept
+  {
+    if((size + HEADER_SIZE) > slot_size_)
+    {
+      return nullptr;
+    }
+
+    for(std::uint32_t slot = 0; slot < slots_; slot++)
+    {
+      if((used_ & (1u << slot)) == 0)
+      {
+        used_ |= 1u << slot;
+        unsigned char* const pBlock = pBuffer_ + slot * slot_size_;
+        *reinterpret_cast<coroutine_arena**>(pBlock) = this;
+        return pBlock + HEADER_SIZE;
+      }
+    }
+    return nullptr;
+  }
+
+  static void deallocate(void* pFrame) noexcept
+  {
+    unsigned char* const pBlock = static_cast<unsigned char*>(pFrame) - HEADER_SIZE;
+    coroutine_arena* const pArena = *reinterpret_cast<coroutine_arena**>(pBlock);
+    pArena->used_ &= ~(1u << ((pBlock - pArena->pBuffer_) / pArena->slot_size_));
+  }
+
+private:
+  unsigned char* const pBuffer_;
+  const std::size_t slot_size_;
+  const std::uint32_t slots_;
+  std::uint32_t used_;            //!< Bit mask of the used slots
+};
+
+struct coroutine_context;
+
+//! Return type of a coroutine state handler.
+class state_task
+{
+public:
+  struct promise_type
+  {
+    template<typename Machine>
+    explicit promise_type(Machine& machine) noexcept;
+
+    static void* operator new(std::size_t size, coroutine_context& context) noexcept;
+
+    static void operator delete(void* pFrame, std::size_t) noexcept
+    {
+      coroutine_arena::deallocate(pFrame);
+    }
+
+    static state_task get_return_object_on_allocation_failure() noexcept { return state_task(); }
+
+    state_task get_return_object() noexcept
+    {
+      return state_task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    // Coroutine starts handling the event which created it.
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    // Keep the frame to let the dispatcher read the final result.
+    std::suspend_always final_suspend() noexcept { return {}; }
+
+    void return_value(state_machine_result_t result) noexcept { Result = result; }
+    void unhandled_exception() noexcept { std::terminate(); }
+
+    state_machine_t* const pState_Machine;
+    state_machine_result_t Result = EVENT_HANDLED;
+  };
+
+  typedef std::coroutine_handle<promise_type> handle_t;
+
+  state_task() noexcept : handle_(nullptr) {}
+  explicit state_task(handle_t handle) noexcept : handle_(handle) {}
+  state_task(state_task&& other) noexcept : handle_(other.release()) {}
+  state_task(const state_task&) = delete;
+  state_task& operator=(const state_task&) = delete;
+  ~state_task() { if(handle_) handle_.destroy(); }
+
+  handle_t release() noexcept
+  {
+    handle_t handle = handle_;
+    handle_ = nullptr;
+    return handle;
+  }
+
+  explicit operator bool() const noexcept { return static_cast<bool>(handle_); }
+
+private:
+  handle_t handle_;
+};
+
+/** \brief Suspend the coroutine handler until the next event is dispatched to the state.
+ *
+ * The current event completes with the given result, and co_await returns the next event.
+ */
+class next_event
+{
+public:
+  explicit next_event(state_machine_result_t result = EVENT_HANDLED) noexcept
+    : result_(result), pState_Machine_(nullptr) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(state_task::handle_t handle) noexcept
+  {
+    handle.promise().Result = result_;
+    pState_Machine_ = handle.promise().pState_Machine;
+  }
+
+  std::uint32_t await_resume() const noexcept { return pState_Machine_->Event; }
+
+private:
+  state_machine_result_t result_;
+  state_machine_t* pState_Machine_;
+};
+
+//! Suspended coroutine handler of a state
+struct coroutine_frame
+{
+  state_task::handle_t Handle;
+  state_handler Owner;              //!< State handler which created the coroutine, nullptr if the frame is free
+  bool Running;                     //!< Coroutine is running, it can't be destroyed now
+  bool Discarded;                   //!< State was left while the coroutine was running
+};
+
+/** \brief State machine with coroutine handlers.
+ *
+ * It must be the first base of the user state machine. Use coroutine_machine to provide the arena storage.
+ */
+struct coroutine_context
+{
+  state_machine_t Machine;            //!< Abstract state machine
+  coroutine_arena Arena;              //!< Storage of coroutine frames
+  coroutine_frame* const pFrames;
+  const std::uint32_t Frame_Count;
+
+  coroutine_context(unsigned char* pBuffer, std::size_t slot_size, coroutine_frame* pFrame_List,
+                    std::uint32_t frames) noexcept
+    : Machine(), Arena(pBuffer, slot_size, frames), pFrames(pFrame_List), Frame_Count(frames)
+  {
+    for(std::uint32_t index = 0; index < Frame_Count; index++)
+    {
+      pFrames[index] = coroutine_frame{nullptr, nullptr, false, false};
+    }
+  }
+
+  coroutine_context(const coroutine_context&) = delete;
+  coroutine_context& operator=(const coroutine_context&) = delete;
+
+  ~coroutine_context()
+  {
+    for(std::uint32_t index = 0; index < Frame_Count; index++)
+    {
+      release(&pFrames[index]);
+    }
+  }
+
+  //! Frame of the coroutine created by the owner, a free frame for nullptr.
+  coroutine_frame* find(state_handler owner) noexcept
+  {
+    for(std::uint32_t index = 0; index < Frame_Count; index++)
+    {
+      if(pFrames[index].Owner == owner)
+      {
+        return &pFrames[index];
+      }
+    }
+    return nullptr;
+  }
+
+  //! True if the coroutine of the owner is suspended, waiting for the next event.
+  bool suspended(state_handler owner) noexcept
+  {
+    const coroutine_frame* const pFrame = find(owner);
+    return (pFrame != nullptr) && pFrame->Handle && !pFrame->Running;
+  }
+
+  void release(coroutine_frame* const pFrame) noexcept
+  {
+    if(pFrame->Handle)
+    {
+      pFrame->Handle.destroy();
+    }
+    *pFrame = coroutine_frame{nullptr, nullptr, false, false};
+  }
+
+  //! Discard the coroutine of the owner. A running coroutine is destroyed when it suspends.
+  void discard(state_handler owner) noexcept
+  {
+    coroutine_frame* const pFrame = find(owner);
+    if(pFrame == nullptr)
+    {
+      return;
+    }
+
+    if(pFrame->Running)
+    {
+      pFrame->Discarded = true;
+    }
+    else
+    {
+      release(pFrame);
+    }
+  }
+
+  template<typename Factory>
+  state_machine_result_t resume(state_handler owner, Factory factory) noexcept
+  {
+    coroutine_frame* pFrame = find(owner);
+    if(pFrame != nullptr)
+    {
+      pFrame->Running = true;
+      pFrame->Handle.resume();
+    }
+    else
+    {
+      pFrame = find(nullptr);
+      if(pFrame == nullptr)
+      {
+        return EVENT_UN_HANDLED;    // All the frames are taken by the suspended coroutines.
+      }
+
+      pFrame->Owner = owner;
+      pFrame->Running = true;
+      state_task task = factory();
+      if(!task)
+      {
+        release(pFrame);
+        return EVENT_UN_HANDLED;    // Coroutine frame doesn't fit in the arena.
+      }
+      pFrame->Handle = task.release();
+    }
+
+    pFrame->Running = false;
+    const state_machine_result_t result = pFrame->Handle.promise().Result;
+    if(pFrame->Handle.done() || pFrame->Discarded)
+    {
+      release(pFrame);
+    }
+    return result;
+  }
+};
+
+template<typename Machine>
+inline state_task::promise_type::promise_type(Machine& machine) noexcept
+  : pState_Machine(&static_cast<coroutine_context&>(machine).Machine) {}
+
+inline void* state_task::promise_type::operator new(std::size_t size, coroutine_context& context) noexcept
+{
+  return context.Arena.allocate(size);
+}
+
+/** \brief State machine with Frames coroutine frames of FrameSize bytes.
+ *
+ * One frame is needed for each coroutine state that is suspended at the same time, i.e. for the
+ * coroutine states along the deepest path of the state hierarchy.
+ */
+template<std::size_t FrameSize, std::uint32_t Frames = 1>
+struct coroutine_machine : coroutine_context
+{
+  static_assert((Frames != 0) && (Frames <= 32), "coroutine_machine supports 1 to 32 frames");
+
+  //! Size of each frame, aligned for the next frame.
+  static constexpr std::size_t SLOT_SIZE = (FrameSize + alignof(std::max_align_t) - 1)
+                                           & ~(alignof(std::max_align_t) - 1);
+
+  coroutine_machine() noexcept : coroutine_context(Storage, SLOT_SIZE, Frame_List, Frames) {}
+
+  alignas(std::max_align_t) unsigned char Storage[SLOT_SIZE * Frames];
+  coroutine_frame Frame_List[Frames];
+};
+
+/** \brief State handler that runs the coroutine Handler.
+ *
+ * The event creating the coroutine is handled by the code till the first co_await next_event().
+ * Each dispatched event resumes the coroutine till next co_await next_event() or co_return.
+ * The result passed to next_event() or co_return is the result of the state handler.
+ * Each coroutine state has its own frame, so a coroutine state stays suspended while the event
+ * bubbles to a coroutine parent state.
+ * Use coroutine_exit as the exit action of the state, or call discard_coroutine from it: the coroutine
+ * is discarded when the state machine leaves the state and starts again on the next entry.
+ */
+template<typename Machine, state_task (*Handler)(Machine&)>
+state_machine_result_t coroutine_state(state_machine_t* const pState_Machine) noexcept
+{
+  coroutine_context& context = *reinterpret_cast<coroutine_context*>(pState_Machine);
+  return context.resume(&coroutine_state<Machine, Handler>,
+                        [&context]() { return Handler(static_cast<Machine&>(context)); });
+}
+
+//! Discard the coroutine of the coroutine state, call it from the exit action of the state.
+template<typename Machine, state_task (*Handler)(Machine&)>
+void discard_coroutine(state_machine_t* const pState_Machine) noexcept
+{
+  reinterpret_cast<coroutine_context*>(pState_Machine)->discard(&coroutine_state<Machine, Handler>);
+}
+
+//! Exit action of the coroutine state, it discards the coroutine of the state.
+template<typename Machine, state_task (*Handler)(Machine&)>
+state_machine_result_t coroutine_exit(state_machine_t* const pState_Machine) noexcept
+{
+  discard_coroutine<Machine, Handler>(pState_Machine);
+  return EVENT_HANDLED;
+}
+
+} // namespace hsm
+
+#endif // HSM_COROUTINE_HPP
@@ -0,0 +1,147 @@
+/**
+ * \file
+ * \brief Runtime counters of dispatcher and transitions
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+#include "hsm_counter.h"
+
+#if HSM_RUNTIME_COUNTERS
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define CACHE_LINE_PAIR_SIZE    128   //!< Counters of threads don't share the cache lines, also with adjacent prefetch
+
+#define MACHINE_COUNTERS        (sizeof(state_machine_counters_t) / sizeof(uint64_t))
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+typedef struct HSM_ALIGNAS(CACHE_LINE_PAIR_SIZE)
+{
+  hsm_counters_t Counters;
+  uint8_t Padding[CACHE_LINE_PAIR_SIZE - (sizeof(hsm_counters_t) % CACHE_LINE_PAIR_SIZE)];
+}counter_block_t;
+
+//! Layout of the blocks starting at the cache line pair boundary, for the alignment check.
+typedef struct
+{
+  uint8_t Offset;
+  counter_block_t Block;
+}counter_block_layout_t;
+
+HSM_STATIC_ASSERT((sizeof(counter_block_t) % CACHE_LINE_PAIR_SIZE) == 0, counter_block_size_check);
+HSM_STATIC_ASSERT(offsetof(counter_block_layout_t, Block) == CACHE_LINE_PAIR_SIZE, counter_block_alignment_check);
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+HSM_THREAD_LOCAL hsm_counters_t* Thread_Counters;
+
+static counter_block_t Counter_Blocks[HSM_COUNTER_MAX_THREADS];
+static uint32_t Counter_Block_Count;
+
+//! Counters of threads started after all the blocks are claimed.
+//! These threads share the block, their concurrent counts may be lost.
+static counter_block_t Overflow_Block;
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+//! Add the counters, reading them while they may be updated by their writer.
+static void add_counters(uint64_t* const pSum, const uint64_t* const pCounters, size_t count)
+{
+  for(size_t index = 0; index < count; index++)
+  {
+    pSum[index] += HSM_ATOMIC_LOAD_RELAXED(&pCounters[index]);
+  }
+}
+
+static void add_global_counters(hsm_counters_t* const pSum, const hsm_counters_t* const pCounters)
+{
+  add_counters((uint64_t*)&pSum->Machines, (const uint64_t*)&pCounters->Machines, MACHINE_COUNTERS);
+  pSum->Dispatcher_Calls += HSM_ATOMIC_LOAD_RELAXED(&pCounters->Dispatcher_Calls);
+  pSum->Restarts += HSM_ATOMIC_LOAD_RELAXED(&pCounters->Restarts);
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Claim the global counters for the calling thread.
+ *  It is called on the first count of each thread.
+ *
+ * \return hsm_counters_t*    global counters of calling thread
+ *
+ */
+hsm_counters_t* claim_thread_counters(void)
+{
+  uint32_t count = HSM_ATOMIC_LOAD(&Counter_Block_Count);
+  do
+  {
+    if(count >= HSM_COUNTER_MAX_THREADS)
+    {
+      Thread_Counters = &Overflow_Block.Counters;
+      return Thread_Counters;
+    }
+  }while(HSM_ATOMIC_CAS(&Counter_Block_Count, &count, count + 1) == 0);
+
+  Thread_Counters = &Counter_Blocks[count].Counters;
+  return Thread_Counters;
+}
+
+/** \brief Get the global counters, the sum of the counters of all threads.
+ *
+ * \param pSnapshot hsm_counters_t* const   copy of the global counters
+ *
+ */
+void get_global_counters(hsm_counters_t* const pSnapshot)
+{
+  static const hsm_counters_t zero;
+  *pSnapshot = zero;
+
+  const uint32_t count = HSM_ATOMIC_LOAD(&Counter_Block_Count);
+  for(uint32_t index = 0; index < count; index++)
+  {
+    add_global_counters(pSnapshot, &Counter_Blocks[index].Counters);
+  }
+  add_global_counters(pSnapshot, &Overflow_Block.Counters);
+}
+
+/** \brief Get the counters of state machine. It is safe to call while the state machine is dispatched.
+ *
+ * \param pState_Machine const state_machine_t* const   state machine
+ * \param pSnapshot state_machine_counters_t* const     copy of the counters
+ *
+ */
+void get_state_machine_counters(const state_machine_t* const pState_Machine,
+                                state_machine_counters_t* const pSnapshot)
+{
+  static const state_machine_counters_t zero;
+  *pSnapshot = zero;
+  add_counters((uint64_t*)pSnapshot, (const uint64_t*)&pState_Machine->Counters, MACHINE_COUNTERS);
+}
+
+#endif // HSM_RUNTIME_COUNTERS
@@ -0,0 +1,126 @@
+/**
+ * \file
+ * \brief Runtime counters of dispatcher and transitions
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_COUNTER_H
+#define HSM_COUNTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+
+#if HSM_RUNTIME_COUNTERS
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+// Instrumentation points used by the framework.
+// Each point counts in the state machine and in the global counters of calling thread.
+
+#define COUNT_DISPATCHER()                                                  \
+        increment_counter(&get_thread_counters()->Dispatcher_Calls)
+
+#define COUNT_RESTART()                                                     \
+        increment_counter(&get_thread_counters()->Restarts)
+
+#define COUNT_MACHINE(pState_Machine, counter)                              \
+do{                                                                         \
+  increment_counter(&(pState_Machine)->Counters.counter);                   \
+  increment_counter(&get_thread_counters()->Machines.counter);              \
+} while(0)
+
+#define COUNT_EVENT(pState_Machine)               COUNT_MACHINE(pState_Machine, Handler_Calls)
+#define COUNT_RESULT(pState_Machine, result)      count_result(pState_Machine, result)
+#define COUNT_BUBBLE(pState_Machine)              COUNT_MACHINE(pState_Machine, Bubbles)
+#define COUNT_UNHANDLED(pState_Machine)           COUNT_MACHINE(pState_Machine, Unhandled)
+#define COUNT_TRANSITION(pState_Machine)          COUNT_MACHINE(pState_Machine, Transitions)
+#define COUNT_EXIT(pState_Machine)                COUNT_MACHINE(pState_Machine, Exits)
+#define COUNT_ENTRY(pState_Machine)               COUNT_MACHINE(pState_Machine, Entries)
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Global counters, the sum of all the state machines and the dispatcher activity.
+typedef struct
+{
+  state_machine_counters_t Machines;    //!< Sum of the counters of all the state machines
+  uint64_t Dispatcher_Calls;            //!< dispatch_event calls
+  uint64_t Restarts;                    //!< Dispatcher restarts from the first state machine
+}hsm_counters_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+//! Global counters of the calling thread, NULL till its first count.
+extern HSM_THREAD_LOCAL hsm_counters_t* Thread_Counters;
+
+extern hsm_counters_t* claim_thread_counters(void);
+
+extern void get_global_counters(hsm_counters_t* const pSnapshot);
+
+extern void get_state_machine_counters(const state_machine_t* const pState_Machine,
+                                       state_machine_counters_t* const pSnapshot);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+/*
+ *  --------------------- Inline functions ---------------------
+ */
+
+//! Counters have a single writer, so increment doesn't need read-modify-write atomic instruction.
+static inline void increment_counter(uint64_t* const pCounter)
+{
+  HSM_ATOMIC_STORE_RELAXED(pCounter, HSM_ATOMIC_LOAD_RELAXED(pCounter) + 1);
+}
+
+static inline hsm_counters_t* get_thread_counters(void)
+{
+  hsm_counters_t* const pCounters = Thread_Counters;
+  return (pCounters != NULL) ? pCounters : claim_thread_counters();
+}
+
+static inline void count_result(state_machine_t* const pState_Machine, state_machine_result_t result)
+{
+  switch(result)
+  {
+  case EVENT_HANDLED:
+    COUNT_MACHINE(pState_Machine, Handled);
+    break;
+
+  case TRIGGERED_TO_SELF:
+    COUNT_MACHINE(pState_Machine, Triggered);
+    break;
+
+  case EVENT_PENDING:
+    COUNT_MACHINE(pState_Machine, Pending);
+    break;
+
+  default:
+    break;    // Unhandled events are counted when they reach the top state.
+  }
+}
+
+#endif // HSM_RUNTIME_COUNTERS
+
+#endif // HSM_COUNTER_H
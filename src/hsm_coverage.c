@@ -0,0 +1,392 @@
+/**
+ * \file
+ * \brief Transition coverage and handler time of states
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+#include "hsm_coverage.h"
+
+#if HSM_STATE_COVERAGE
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define HUE_COLD        0.666   //!< Hue of the cheapest edge and state, blue
+#define MAX_PEN_WIDTH   8.0     //!< Pen width of the most frequent edge
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+//! Registered state of each state Id, NULL if the Id is not registered
+static const state_t* Covered_States[HSM_COVERAGE_MAX_STATES];
+//! Name of each registered state, NULL if the state has no name
+static const char* State_Names[HSM_COVERAGE_MAX_STATES];
+
+static state_coverage_t State_Coverage[HSM_COVERAGE_MAX_STATES];
+static transition_coverage_t Transitions[HSM_COVERAGE_MAX_STATES][HSM_COVERAGE_MAX_STATES];
+
+//! Transitions from or to the states that are not registered
+static uint64_t Unregistered_Transitions;
+
+HSM_THREAD_LOCAL transition_coverage_t* Handler_Transition;
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+//! Print the name of state, or the state Id when it has no name. Quotes and backslashes of the name are escaped.
+static void print_state_name(FILE* const pFile, uint32_t index)
+{
+  const char* pName = State_Names[index];
+  if(pName == NULL)
+  {
+    fprintf(pFile, "state %lu", (unsigned long)index);
+    return;
+  }
+
+  for(; *pName != '\0'; pName++)
+  {
+    if((*pName == '"') || (*pName == '\\'))
+    {
+      fputc('\\', pFile);
+    }
+    fputc(*pName, pFile);
+  }
+}
+
+//! Hue from cold blue to hot red, as the fraction of the maximum value.
+static double get_heat_hue(uint64_t value, uint64_t max)
+{
+  return (max == 0) ? HUE_COLD : HUE_COLD * (1.0 - (double)value / (double)max);
+}
+
+static void print_state_node(FILE* const pFile, uint32_t index, uint64_t max_cycles, uint32_t depth)
+{
+  const uint64_t calls = HSM_ATOMIC_LOAD_RELAXED(&State_Coverage[index].Handler_Calls);
+  const uint64_t cycles = HSM_ATOMIC_LOAD_RELAXED(&State_Coverage[index].Handler_Cycles);
+
+  fprintf(pFile, "%*ss%lu [label=\"", (int)(depth * 2), "", (unsigned long)index);
+  print_state_name(pFile, index);
+  fprintf(pFile, "\\ncalls %llu\\ncycles %llu\", fillcolor=\"%.3f 0.500 1.000\"];\n",
+          (unsigned long long)calls, (unsigned long long)cycles, get_heat_hue(cycles, max_cycles));
+}
+
+#if HIERARCHICAL_STATES
+//! Print the state, and its child states in a cluster when it is a composite state.
+static void print_state_tree(FILE* const pFile, uint32_t index, uint64_t max_cycles, uint32_t depth)
+{
+  const state_t* const pState = Covered_States[index];
+
+  bool composite = false;
+  for(uint32_t child = 0; child < HSM_COVERAGE_MAX_STATES; child++)
+  {
+    if((Covered_States[child] != NULL) && (Covered_States[child]->Parent == pState))
+    {
+      composite = true;
+      break;
+    }
+  }
+
+  if(composite == false)
+  {
+    print_state_node(pFile, index, max_cycles, depth);
+    return;
+  }
+
+  fprintf(pFile, "%*ssubgraph cluster_s%lu {\n", (int)(depth * 2), "", (unsigned long)index);
+  fprintf(pFile, "%*slabel=\"", (int)(depth * 2 + 2), "");
+  print_state_name(pFile, index);
+  fprintf(pFile, "\";\n");
+
+  print_state_node(pFile, index, max_cycles, depth + 1);
+  for(uint32_t child = 0; child < HSM_COVERAGE_MAX_STATES; child++)
+  {
+    if((Covered_States[child] != NULL) && (Covered_States[child]->Parent == pState))
+    {
+      print_state_tree(pFile, child, max_cycles, depth + 1);
+    }
+  }
+  fprintf(pFile, "%*s}\n", (int)(depth * 2), "");
+}
+
+//! Top states have no parent, or their parent is not registered.
+static bool is_top_state(uint32_t index)
+{
+  const state_t* const pParent = Covered_States[index]->Parent;
+  return (pParent == NULL) || (get_coverage_state_index(pParent) == COVERAGE_UNKNOWN_STATE);
+}
+#endif // HIERARCHICAL_STATES
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Register an array of states for the coverage. The coverage of state is kept at its Id,
+ *  the states of all the registered tables must have distinct Ids from 0 to HSM_COVERAGE_MAX_STATES - 1.
+ *  Register all the state tables before dispatching the events, states that are not registered are not covered.
+ *  Registering the same table again has no effect.
+ *
+ * \param pStates const state_t* const      array of states
+ * \param count uint32_t                    number of states in the array
+ * \param pNames const char* const* const   names of the states used by the exporter, NULL to use the state Ids
+ * \return bool                             false if an Id is out of range or it is used by another registered state,
+ *                                          none of the states is registered then
+ *
+ */
+bool register_state_table(const state_t* const pStates, uint32_t count,
+                          const char* const* const pNames)
+{
+  for(uint32_t index = 0; index < count; index++)
+  {
+    const uint32_t id = pStates[index].Id;
+    if((id >= HSM_COVERAGE_MAX_STATES)
+       || ((Covered_States[id] != NULL) && (Covered_States[id] != &pStates[index])))
+    {
+      return false;
+    }
+  }
+
+  for(uint32_t index = 0; index < count; index++)
+  {
+    const uint32_t id = pStates[index].Id;
+    State_Names[id] = (pNames != NULL) ? pNames[index] : NULL;
+    // Publish the state to the dispatching threads.
+    HSM_ATOMIC_STORE(&Covered_States[id], &pStates[index]);
+  }
+  return true;
+}
+
+/** \brief Get the coverage index of state, that is its Id when the state is registered.
+ *
+ * \param pState const state_t* const   state
+ * \return uint32_t                     coverage index, COVERAGE_UNKNOWN_STATE if state is not registered
+ *
+ */
+uint32_t get_coverage_state_index(const state_t* const pState)
+{
+  const uint32_t id = pState->Id;
+  if((id < HSM_COVERAGE_MAX_STATES) && (HSM_ATOMIC_LOAD(&Covered_States[id]) == pState))
+  {
+    return id;
+  }
+  return COVERAGE_UNKNOWN_STATE;
+}
+
+/** \brief Count the handler call of state and its duration. It is called by the dispatcher.
+ *  The duration is also the cost of transition taken by the handler.
+ *
+ * \param pState const state_t* const   state of the handler
+ * \param cycles uint64_t               duration of the handler call
+ *
+ */
+void record_state_handler(const state_t* const pState, uint64_t cycles)
+{
+  if(Handler_Transition != NULL)
+  {
+    HSM_ATOMIC_ADD(&Handler_Transition->Cycles, cycles);
+  }
+
+  const uint32_t index = get_coverage_state_index(pState);
+  if(index != COVERAGE_UNKNOWN_STATE)
+  {
+    HSM_ATOMIC_ADD(&State_Coverage[index].Handler_Calls, 1);
+    HSM_ATOMIC_ADD(&State_Coverage[index].Handler_Cycles, cycles);
+  }
+}
+
+/** \brief Count the transition from source to target state. It is called by switch_state and traverse_state.
+ *
+ * \param pSource const state_t* const  source state
+ * \param pTarget const state_t* const  target state
+ *
+ */
+void record_state_transition(const state_t* const pSource, const state_t* const pTarget)
+{
+  const uint32_t source = get_coverage_state_index(pSource);
+  const uint32_t target = get_coverage_state_index(pTarget);
+  if((source != COVERAGE_UNKNOWN_STATE) && (target != COVERAGE_UNKNOWN_STATE))
+  {
+    HSM_ATOMIC_ADD(&Transitions[source][target].Count, 1);
+    Handler_Transition = &Transitions[source][target];
+  }
+  else
+  {
+    HSM_ATOMIC_ADD(&Unregistered_Transitions, 1);
+  }
+}
+
+/** \brief Get the handler calls and handler time of state.
+ *
+ * \param pState const state_t* const          state
+ * \param pSnapshot state_coverage_t* const    copy of the handler time
+ * \return bool                                false if state is not registered
+ *
+ */
+bool get_state_coverage(const state_t* const pState, state_coverage_t* const pSnapshot)
+{
+  const uint32_t index = get_coverage_state_index(pState);
+  if(index == COVERAGE_UNKNOWN_STATE)
+  {
+    return false;
+  }
+
+  pSnapshot->Handler_Calls = HSM_ATOMIC_LOAD_RELAXED(&State_Coverage[index].Handler_Calls);
+  pSnapshot->Handler_Cycles = HSM_ATOMIC_LOAD_RELAXED(&State_Coverage[index].Handler_Cycles);
+  return true;
+}
+
+/** \brief Get the number of transitions from source to target state.
+ *
+ * \param pSource const state_t* const  source state
+ * \param pTarget const state_t* const  target state
+ * \return uint64_t                     number of transitions, 0 if any of the states is not registered
+ *
+ */
+uint64_t get_transition_count(const state_t* const pSource, const state_t* const pTarget)
+{
+  const uint32_t source = get_coverage_state_index(pSource);
+  const uint32_t target = get_coverage_state_index(pTarget);
+  if((source == COVERAGE_UNKNOWN_STATE) || (target == COVERAGE_UNKNOWN_STATE))
+  {
+    return 0;
+  }
+  return HSM_ATOMIC_LOAD_RELAXED(&Transitions[source][target].Count);
+}
+
+/** \brief Get the number of transitions from source to target state and the time of handler calls that took them.
+ *
+ * \param pSource const state_t* const             source state
+ * \param pTarget const state_t* const             target state
+ * \param pSnapshot transition_coverage_t* const   copy of the count and cost of transition
+ * \return bool                                    false if any of the states is not registered
+ *
+ */
+bool get_transition_coverage(const state_t* const pSource, const state_t* const pTarget,
+                             transition_coverage_t* const pSnapshot)
+{
+  const uint32_t source = get_coverage_state_index(pSource);
+  const uint32_t target = get_coverage_state_index(pTarget);
+  if((source == COVERAGE_UNKNOWN_STATE) || (target == COVERAGE_UNKNOWN_STATE))
+  {
+    return false;
+  }
+
+  pSnapshot->Count = HSM_ATOMIC_LOAD_RELAXED(&Transitions[source][target].Count);
+  pSnapshot->Cycles = HSM_ATOMIC_LOAD_RELAXED(&Transitions[source][target].Cycles);
+  return true;
+}
+
+/** \brief Get the number of transitions from or to the states that are not registered.
+ *
+ * \return uint64_t   number of transitions
+ *
+ */
+uint64_t get_unregistered_transitions(void)
+{
+  return HSM_ATOMIC_LOAD_RELAXED(&Unregistered_Transitions);
+}
+
+/** \brief Clear the transition counts and handler time of all the states.
+ */
+void reset_state_coverage(void)
+{
+  for(uint32_t source = 0; source < HSM_COVERAGE_MAX_STATES; source++)
+  {
+    HSM_ATOMIC_STORE_RELAXED(&State_Coverage[source].Handler_Calls, 0);
+    HSM_ATOMIC_STORE_RELAXED(&State_Coverage[source].Handler_Cycles, 0);
+    for(uint32_t target = 0; target < HSM_COVERAGE_MAX_STATES; target++)
+    {
+      HSM_ATOMIC_STORE_RELAXED(&Transitions[source][target].Count, 0);
+      HSM_ATOMIC_STORE_RELAXED(&Transitions[source][target].Cycles, 0);
+    }
+  }
+  HSM_ATOMIC_STORE_RELAXED(&Unregistered_Transitions, 0);
+}
+
+/** \brief Write the registered states as a Graphviz DOT graph.
+ *  Composite states are the clusters of their child states. States are coloured by their handler time.
+ *  Transition edges are labelled with their count and cost, they are weighted by the count and coloured by the cost.
+ *
+ * \param pFile FILE* const   output file
+ *
+ */
+void export_state_coverage_dot(FILE* const pFile)
+{
+  uint64_t max_cycles = 0;
+  uint64_t max_count = 0;
+  uint64_t max_cost = 0;
+
+  for(uint32_t source = 0; source < HSM_COVERAGE_MAX_STATES; source++)
+  {
+    const uint64_t cycles = HSM_ATOMIC_LOAD_RELAXED(&State_Coverage[source].Handler_Cycles);
+    max_cycles = (cycles > max_cycles) ? cycles : max_cycles;
+    for(uint32_t target = 0; target < HSM_COVERAGE_MAX_STATES; target++)
+    {
+      const uint64_t count = HSM_ATOMIC_LOAD_RELAXED(&Transitions[source][target].Count);
+      const uint64_t cost = HSM_ATOMIC_LOAD_RELAXED(&Transitions[source][target].Cycles);
+      max_count = (count > max_count) ? count : max_count;
+      max_cost = (cost > max_cost) ? cost : max_cost;
+    }
+  }
+
+  fprintf(pFile, "digraph hsm {\n");
+  fprintf(pFile, "  compound=true;\n");
+  fprintf(pFile, "  node [shape=box, style=\"rounded,filled\"];\n");
+
+  for(uint32_t index = 0; index < HSM_COVERAGE_MAX_STATES; index++)
+  {
+    if(Covered_States[index] == NULL)
+    {
+      continue;
+    }
+#if HIERARCHICAL_STATES
+    if(is_top_state(index))
+    {
+      print_state_tree(pFile, index, max_cycles, 1);
+    }
+#else
+    print_state_node(pFile, index, max_cycles, 1);
+#endif // HIERARCHICAL_STATES
+  }
+
+  for(uint32_t source = 0; source < HSM_COVERAGE_MAX_STATES; source++)
+  {
+    for(uint32_t target = 0; target < HSM_COVERAGE_MAX_STATES; target++)
+    {
+      const uint64_t count = HSM_ATOMIC_LOAD_RELAXED(&Transitions[source][target].Count);
+      const uint64_t cost = HSM_ATOMIC_LOAD_RELAXED(&Transitions[source][target].Cycles);
+      if(count != 0)
+      {
+        fprintf(pFile, "  s%lu -> s%lu [label=\"%llu\\ncycles %llu\", penwidth=%.2f, color=\"%.3f 1.000 0.900\"];\n",
+                (unsigned long)source, (unsigned long)target, (unsigned long long)count, (unsigned long long)cost,
+                1.0 + (MAX_PEN_WIDTH - 1.0) * (double)count / (double)max_count,
+                get_heat_hue(cost, max_cost));
+      }
+    }
+  }
+  fprintf(pFile, "}\n");
+}
+
+#endif // HSM_STATE_COVERAGE
@@ -0,0 +1,103 @@
+/**
+ * \file
+ * \brief Transition coverage and handler time of states
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_COVERAGE_H
+#define HSM_COVERAGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+
+#if HSM_STATE_COVERAGE
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+//! Index of the states that are not in the registered state tables
+#define COVERAGE_UNKNOWN_STATE      0xFFFFFFFFu
+
+// Instrumentation points used by the framework.
+// Cycles is the duration of handler call measured by the dispatcher.
+
+#define COVERAGE_START_HANDLER()                                    \
+        (Handler_Transition = NULL)
+
+#define COVERAGE_RECORD_HANDLER(cycles, pState)                     \
+        record_state_handler(pState, cycles)
+
+#define COVERAGE_RECORD_TRANSITION(pSource, pTarget)                \
+        record_state_transition(pSource, pTarget)
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Handler time of a state
+typedef struct
+{
+  uint64_t Handler_Calls;     //!< Number of handler calls
+  uint64_t Handler_Cycles;    //!< Sum of the handler call durations in ticks of HSM_CYCLE_COUNTER()
+}state_coverage_t;
+
+//! Count and cost of a transition
+typedef struct
+{
+  uint64_t Count;             //!< Number of transitions
+  uint64_t Cycles;            //!< Sum of the durations of handler calls that took the transition
+}transition_coverage_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+//! Transition taken by the running handler of the calling thread, NULL if none
+extern HSM_THREAD_LOCAL transition_coverage_t* Handler_Transition;
+
+extern bool register_state_table(const state_t* const pStates, uint32_t count,
+                                 const char* const* const pNames);
+
+extern uint32_t get_coverage_state_index(const state_t* const pState);
+
+extern void record_state_handler(const state_t* const pState, uint64_t cycles);
+
+extern void record_state_transition(const state_t* const pSource, const state_t* const pTarget);
+
+extern bool get_state_coverage(const state_t* const pState, state_coverage_t* const pSnapshot);
+
+extern uint64_t get_transition_count(const state_t* const pSource, const state_t* const pTarget);
+
+extern bool get_transition_coverage(const state_t* const pSource, const state_t* const pTarget,
+                                    transition_coverage_t* const pSnapshot);
+
+extern uint64_t get_unregistered_transitions(void);
+
+extern void reset_state_coverage(void);
+
+extern void export_state_coverage_dot(FILE* const pFile);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // HSM_STATE_COVERAGE
+
+#endif // HSM_COVERAGE_H
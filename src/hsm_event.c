@@ -0,0 +1,185 @@
+/**
+ * \file
+ * \brief Pool backed event objects for state machine
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+#include "hsm_event.h"
+
+#if HSM_TRACE_BUFFER
+#include "hsm_trace.h"
+#endif // HSM_TRACE_BUFFER
+
+#if HSM_QUEUE_METRICS
+#include "hsm_queue.h"
+#endif // HSM_QUEUE_METRICS
+
+#if HSM_EVENT_OBJECTS
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define GET_BLOCK(pPool, index)    ((event_t*)((pPool)->Buffer + ((size_t)(index) * (pPool)->Block_Size)))
+
+#define NEXT_FREE_LIST(head, index)  ((((head) >> 32) + 1) << 32 | (uint64_t)(index))
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Initialize the event pool.
+ *
+ * \param pPool event_pool_t* const   pool to initialize
+ * \param pBuffer void* const         storage for capacity number of event objects
+ * \param blockSize uint32_t          size of the user event structure (including event_t header)
+ * \param capacity uint32_t           number of event objects in the storage
+ *
+ */
+void init_event_pool(event_pool_t* const pPool, void* const pBuffer,
+                     uint32_t blockSize, uint32_t capacity)
+{
+  pPool->Buffer = (uint8_t*)pBuffer;
+  pPool->Block_Size = blockSize;
+  pPool->Capacity = capacity;
+
+  // Link all the blocks in the free list. Block index stored in the list is 1-based,
+  // zero terminates the list.
+  for(uint32_t index = 0; index < capacity; index++)
+  {
+    event_t* const pEvent = GET_BLOCK(pPool, index);
+    pEvent->Pool = pPool;
+    pEvent->Free_Next = (index + 1 < capacity) ? index + 2 : 0;
+  }
+  pPool->Free_List = (capacity != 0) ? 1 : 0;
+}
+
+/** \brief Take an event object from the pool. It is safe to call from any thread.
+ *
+ * \param pPool event_pool_t* const   pool of event objects
+ * \param event uint32_t              non-zero event value
+ * \return event_t*                   event object or NULL if pool is exhausted
+ *
+ */
+event_t* allocate_event(event_pool_t* const pPool, uint32_t event)
+{
+  uint64_t head = HSM_ATOMIC_LOAD(&pPool->Free_List);
+  event_t* pEvent;
+
+  do
+  {
+    uint32_t index = (uint32_t)head;
+    if(index == 0)
+    {
+      return NULL;
+    }
+
+    pEvent = GET_BLOCK(pPool, index - 1);
+    // The tag in the list head protects against the block being taken and returned
+    // by another thread between the load of Free_Next and the exchange.
+  }while(!HSM_ATOMIC_CAS(&pPool->Free_List, &head,
+                        NEXT_FREE_LIST(head, HSM_ATOMIC_LOAD(&pEvent->Free_Next))));
+
+  pEvent->Id = event;
+  pEvent->Pool = pPool;
+  pEvent->Next = NULL;
+  return pEvent;
+}
+
+/** \brief Return the event object to its pool. It is safe to call from any thread.
+ *
+ * \param pEvent event_t* const   event object allocated by allocate_event
+ *
+ */
+void release_event(event_t* const pEvent)
+{
+  event_pool_t* const pPool = pEvent->Pool;
+  const uint32_t index = (uint32_t)(((uint8_t*)pEvent - pPool->Buffer) / pPool->Block_Size) + 1;
+  uint64_t head = HSM_ATOMIC_LOAD(&pPool->Free_List);
+
+  do
+  {
+    HSM_ATOMIC_STORE(&pEvent->Free_Next, (uint32_t)head);
+  }while(!HSM_ATOMIC_CAS(&pPool->Free_List, &head, NEXT_FREE_LIST(head, index)));
+}
+
+/** \brief Post an event object to the state machine. It is safe to call from any thread.
+ *  The state machine owns the event object after this call and releases it,
+ *  once the event is handled by the state machine.
+ *
+ * \param pState_Machine state_machine_t* const   target state machine
+ * \param pEvent event_t* const                   event object allocated by allocate_event
+ *
+ */
+void post_event(state_machine_t* const pState_Machine, event_t* const pEvent)
+{
+  HSM_TRACE_POST(pState_Machine, pEvent);
+#if HSM_TRACE_BUFFER
+  TRACE_RECORD_POST(pEvent);
+#endif // HSM_TRACE_BUFFER
+#if HSM_QUEUE_METRICS
+  QUEUE_RECORD_POST(pState_Machine, pEvent);
+#endif // HSM_QUEUE_METRICS
+
+  event_t* pHead = HSM_ATOMIC_LOAD(&pState_Machine->Inbox);
+  do
+  {
+    pEvent->Next = pHead;
+  }while(!HSM_ATOMIC_CAS(&pState_Machine->Inbox, &pHead, pEvent));
+}
+
+/** \brief Load the oldest posted event in to the state machine.
+ *  Only the dispatcher of the state machine calls this function.
+ *
+ * \param pState_Machine state_machine_t* const   state machine
+ * \return bool                                   true if an event is loaded
+ *
+ */
+bool load_posted_event(state_machine_t* const pState_Machine)
+{
+  if(pState_Machine->Queue == NULL)
+  {
+    if(HSM_ATOMIC_LOAD(&pState_Machine->Inbox) == NULL)
+    {
+      return false;
+    }
+
+    // Take all the posted events at once and reverse them in to posting order.
+    event_t* pEvent = HSM_ATOMIC_EXCHANGE(&pState_Machine->Inbox, (event_t*)NULL);
+    while(pEvent != NULL)
+    {
+      event_t* const pNext = pEvent->Next;
+      pEvent->Next = pState_Machine->Queue;
+      pState_Machine->Queue = pEvent;
+      pEvent = pNext;
+    }
+  }
+
+  event_t* const pEvent = pState_Machine->Queue;
+  pState_Machine->Queue = pEvent->Next;
+  pEvent->Next = NULL;
+
+  pState_Machine->Event_Object = pEvent;
+  pState_Machine->Event = pEvent->Id;
+  return true;
+}
+
+#endif // HSM_EVENT_OBJECTS
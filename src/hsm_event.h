@@ -0,0 +1,64 @@
+/**
+ * \file
+ * \brief Pool backed event objects for state machine
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_EVENT_H
+#define HSM_EVENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hsm.h"
+
+#if HSM_EVENT_OBJECTS
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Fixed size block pool of event objects of a single type.
+typedef struct event_pool_t
+{
+  uint8_t* Buffer;        //!< Storage of event objects
+  uint32_t Block_Size;    //!< Size of single event object including event_t header
+  uint32_t Capacity;      //!< Number of event objects in the pool
+  //! Head of free list. Upper 32 bits are a modification tag, lower 32 bits are 1-based block index.
+  uint64_t Free_List;
+}event_pool_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+extern void init_event_pool(event_pool_t* const pPool, void* const pBuffer,
+                            uint32_t blockSize, uint32_t capacity);
+
+extern event_t* allocate_event(event_pool_t* const pPool, uint32_t event);
+
+extern void release_event(event_t* const pEvent);
+
+extern void post_event(state_machine_t* const pState_Machine, event_t* const pEvent);
+
+extern bool load_posted_event(state_machine_t* const pState_Machine);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // HSM_EVENT_OBJECTS
+
+#endif // HSM_EVENT_H
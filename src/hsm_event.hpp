@@ -0,0 +1,146 @@
+/**
+ * \file
+ * \brief C++ wrapper of pool backed event objects
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_EVENT_HPP
+#define HSM_EVENT_HPP
+
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "hsm_event.h"
+
+#if HSM_EVENT_OBJECTS
+
+namespace hsm
+{
+
+/** \brief Move-only owner of an event object.
+ *
+ * The user event type must be a standard layout type with event_t as first member.
+ * Ownership is passed to the state machine by post(), the framework then returns
+ * the object to its pool once the event is handled.
+ */
+template<typename T>
+class event_ptr
+{
+  static_assert(std::is_standard_layout<T>::value, "event type must be standard layout");
+  static_assert(std::is_trivially_destructible<T>::value, "event type must be trivially destructible");
+
+public:
+  event_ptr() noexcept : pEvent_(nullptr) {}
+  explicit event_ptr(T* pEvent) noexcept : pEvent_(pEvent) {}
+
+  event_ptr(const event_ptr&) = delete;
+  event_ptr& operator=(const event_ptr&) = delete;
+
+  event_ptr(event_ptr&& other) noexcept : pEvent_(other.release()) {}
+
+  event_ptr& operator=(event_ptr&& other) noexcept
+  {
+    reset(other.release());
+    return *this;
+  }
+
+  ~event_ptr() { reset(); }
+
+  //! Release the ownership without returning the object to the pool.
+  T* release() noexcept
+  {
+    T* const pEvent = pEvent_;
+    pEvent_ = nullptr;
+    return pEvent;
+  }
+
+  //! Return the owned object to its pool and take ownership of pEvent.
+  void reset(T* pEvent = nullptr) noexcept
+  {
+    if(pEvent_ != nullptr)
+    {
+      release_event(header(pEvent_));
+    }
+    pEvent_ = pEvent;
+  }
+
+  T* get() const noexcept { return pEvent_; }
+  T* operator->() const noexcept { return pEvent_; }
+  T& operator*() const noexcept { return *pEvent_; }
+  explicit operator bool() const noexcept { return pEvent_ != nullptr; }
+
+  static event_t* header(T* pEvent) noexcept { return reinterpret_cast<event_t*>(pEvent); }
+
+private:
+  T* pEvent_;
+};
+
+//! Pool of Capacity event objects of type T with static storage.
+template<typename T, std::uint32_t Capacity>
+class event_pool
+{
+public:
+  event_pool() noexcept
+  {
+    init_event_pool(&pool_, storage_, sizeof(T), Capacity);
+  }
+
+  event_pool(const event_pool&) = delete;
+  event_pool& operator=(const event_pool&) = delete;
+
+  /** \brief Construct an event object in the pool. Never allocates from heap.
+   *
+   * \param event std::uint32_t   non-zero event value
+   * \param args                  arguments of T constructor
+   * \return event_ptr<T>         owner of event object, empty if the pool is exhausted
+   */
+  template<typename... Args>
+  event_ptr<T> make(std::uint32_t event, Args&&... args) noexcept
+  {
+    event_t* const pHeader = allocate_event(&pool_, event);
+    if(pHeader == nullptr)
+    {
+      return event_ptr<T>();
+    }
+
+    const event_t header = *pHeader;
+    T* const pEvent = ::new(static_cast<void*>(pHeader)) T{header, std::forward<Args>(args)...};
+    return event_ptr<T>(pEvent);
+  }
+
+  event_pool_t* get() noexcept { return &pool_; }
+
+private:
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_[Capacity];
+  event_pool_t pool_;
+};
+
+//! Post the event object to state machine, the state machine takes the ownership.
+template<typename T>
+inline void post(state_machine_t* const pState_Machine, event_ptr<T>&& event) noexcept
+{
+  post_event(pState_Machine, event_ptr<T>::header(event.release()));
+}
+
+//! Payload of the event under dispatch. Call only from the handlers of pState_Machine.
+template<typename T>
+inline const T* event_cast(const state_machine_t* const pState_Machine) noexcept
+{
+  return reinterpret_cast<const T*>(pState_Machine->Event_Object);
+}
+
+} // namespace hsm
+
+#endif // HSM_EVENT_OBJECTS
+
+#endif // HSM_EVENT_HPP
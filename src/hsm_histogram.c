@@ -0,0 +1,292 @@
+/**
+ * \file
+ * \brief Log-bucketed latency histograms of state handlers
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+#include "hsm_histogram.h"
+
+#if HSM_HISTOGRAMS
+
+#if HSM_LATENCY_HISTOGRAM
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+static latency_histogram_t State_Latency[HSM_HISTOGRAM_MAX_STATES][HSM_HISTOGRAM_MAX_EVENTS];
+
+//! Handler calls of states and events outside of the State_Latency table.
+static latency_histogram_t Other_State_Latency;
+
+static latency_histogram_t Machine_Latency[HSM_HISTOGRAM_MAX_MACHINES];
+#endif // HSM_LATENCY_HISTOGRAM
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+//! Index of the most significant set bit, value must be non-zero.
+static inline uint32_t most_significant_bit(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return 63u - (uint32_t)__builtin_clzll(value);
+#else
+  uint32_t bit = 0;
+  while(value >>= 1)
+  {
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+#if HSM_LATENCY_HISTOGRAM
+
+/** \brief Record the latency of a state handler call. It is called by the dispatcher
+ *  and is safe to call from any thread.
+ *
+ * \param index uint32_t      index of state machine in the array passed to dispatch_event
+ * \param state uint32_t      Id of state whose handler is called
+ * \param event uint32_t      event handled
+ * \param cycles uint64_t     latency in cycle counter ticks
+ *
+ */
+void record_handler_latency(uint32_t index, uint32_t state, uint32_t event, uint64_t cycles)
+{
+  const uint32_t bucket = get_latency_bucket(cycles);
+
+  if((state < HSM_HISTOGRAM_MAX_STATES) && (event < HSM_HISTOGRAM_MAX_EVENTS))
+  {
+    HSM_ATOMIC_ADD(&State_Latency[state][event].Buckets[bucket], 1);
+  }
+  else
+  {
+    HSM_ATOMIC_ADD(&Other_State_Latency.Buckets[bucket], 1);
+  }
+
+  if(index < HSM_HISTOGRAM_MAX_MACHINES)
+  {
+    HSM_ATOMIC_ADD(&Machine_Latency[index].Buckets[bucket], 1);
+  }
+}
+
+/** \brief Copy the latency histogram of a state handler for an event.
+ *
+ * \param state uint32_t                        Id of state
+ * \param event uint32_t                        event
+ * \param pSnapshot latency_histogram_t* const  copy of the histogram
+ * \param reset bool                            true to clear the histogram while copying it
+ * \return bool                                 false if state or event is out of range of the table
+ *
+ */
+bool snapshot_state_latency(uint32_t state, uint32_t event,
+                            latency_histogram_t* const pSnapshot, bool reset)
+{
+  if((state >= HSM_HISTOGRAM_MAX_STATES) || (event >= HSM_HISTOGRAM_MAX_EVENTS))
+  {
+    return false;
+  }
+
+  copy_latency_histogram(&State_Latency[state][event], pSnapshot, reset);
+  return true;
+}
+
+/** \brief Copy the latency histogram of the states and events out of range of the table.
+ *
+ * \param pSnapshot latency_histogram_t* const  copy of the histogram
+ * \param reset bool                            true to clear the histogram while copying it
+ *
+ */
+void snapshot_other_state_latency(latency_histogram_t* const pSnapshot, bool reset)
+{
+  copy_latency_histogram(&Other_State_Latency, pSnapshot, reset);
+}
+
+/** \brief Copy the latency histogram of all handler calls of a state machine.
+ *
+ * \param index uint32_t                        index of state machine in the array passed to dispatch_event
+ * \param pSnapshot latency_histogram_t* const  copy of the histogram
+ * \param reset bool                            true to clear the histogram while copying it
+ * \return bool                                 false if index is out of range
+ *
+ */
+bool snapshot_machine_latency(uint32_t index, latency_histogram_t* const pSnapshot, bool reset)
+{
+  if(index >= HSM_HISTOGRAM_MAX_MACHINES)
+  {
+    return false;
+  }
+
+  copy_latency_histogram(&Machine_Latency[index], pSnapshot, reset);
+  return true;
+}
+
+//! Clear all the latency histograms.
+void reset_latency_histograms(void)
+{
+  latency_histogram_t discard;
+
+  for(uint32_t state = 0; state < HSM_HISTOGRAM_MAX_STATES; state++)
+  {
+    for(uint32_t event = 0; event < HSM_HISTOGRAM_MAX_EVENTS; event++)
+    {
+      copy_latency_histogram(&State_Latency[state][event], &discard, true);
+    }
+  }
+
+  copy_latency_histogram(&Other_State_Latency, &discard, true);
+
+  for(uint32_t index = 0; index < HSM_HISTOGRAM_MAX_MACHINES; index++)
+  {
+    copy_latency_histogram(&Machine_Latency[index], &discard, true);
+  }
+}
+
+#endif // HSM_LATENCY_HISTOGRAM
+
+/** \brief Copy the histogram. It is safe to call while the histogram is recorded.
+ *
+ * \param pHistogram latency_histogram_t* const  histogram
+ * \param pSnapshot latency_histogram_t* const   copy of the histogram
+ * \param reset bool                             true to clear the histogram while copying it
+ *
+ */
+void copy_latency_histogram(latency_histogram_t* const pHistogram,
+                            latency_histogram_t* const pSnapshot, bool reset)
+{
+  for(uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+  {
+    pSnapshot->Buckets[bucket] = reset ? HSM_ATOMIC_EXCHANGE(&pHistogram->Buckets[bucket], 0)
+                                       : HSM_ATOMIC_LOAD(&pHistogram->Buckets[bucket]);
+  }
+}
+
+/** \brief Get the histogram bucket of the latency.
+ *
+ * \param cycles uint64_t   latency in cycle counter ticks
+ * \return uint32_t         bucket index
+ *
+ */
+uint32_t get_latency_bucket(uint64_t cycles)
+{
+  if(cycles < HISTOGRAM_SUB_BUCKETS)
+  {
+    return (uint32_t)cycles;
+  }
+
+  const uint32_t bit = most_significant_bit(cycles);
+  if(bit >= HSM_HISTOGRAM_MAX_BITS)
+  {
+    return HISTOGRAM_BUCKETS - 1;
+  }
+
+  // The bits following the most significant bit select the sub bucket.
+  const uint32_t shift = bit - HSM_HISTOGRAM_SUB_BUCKET_BITS;
+  return (shift + 1) * HISTOGRAM_SUB_BUCKETS + (uint32_t)((cycles >> shift) & (HISTOGRAM_SUB_BUCKETS - 1));
+}
+
+/** \brief Get the highest latency that falls in the bucket.
+ *
+ * \param bucket uint32_t   bucket index
+ * \return uint64_t         latency in cycle counter ticks
+ *
+ */
+uint64_t get_bucket_latency(uint32_t bucket)
+{
+  if(bucket < HISTOGRAM_SUB_BUCKETS)
+  {
+    return bucket;
+  }
+
+  const uint32_t shift = bucket / HISTOGRAM_SUB_BUCKETS - 1;
+  const uint64_t sub_bucket = bucket % HISTOGRAM_SUB_BUCKETS;
+  return ((HISTOGRAM_SUB_BUCKETS + sub_bucket + 1) << shift) - 1;
+}
+
+/** \brief Get the latency below which the given percentage of handler calls fall.
+ *
+ * \param pHistogram const latency_histogram_t* const   latency histogram
+ * \param percentile double                             percentile from 0 to 100
+ * \return uint64_t                                     latency in cycle counter ticks, 0 for empty histogram
+ *
+ */
+uint64_t get_latency_percentile(const latency_histogram_t* const pHistogram, double percentile)
+{
+  uint64_t count = 0;
+  for(uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+  {
+    count += pHistogram->Buckets[bucket];
+  }
+
+  if(count == 0)
+  {
+    return 0;
+  }
+
+  // Rank of the handler call at the percentile, rounded up.
+  const double exact = (double)count * percentile / 100.0;
+  uint64_t rank = (uint64_t)exact;
+  if(((double)rank < exact) || (rank == 0))
+  {
+    rank++;
+  }
+
+  uint64_t cumulative = 0;
+  for(uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+  {
+    cumulative += pHistogram->Buckets[bucket];
+    if(cumulative >= rank)
+    {
+      return get_bucket_latency(bucket);
+    }
+  }
+  return get_bucket_latency(HISTOGRAM_BUCKETS - 1);
+}
+
+/** \brief Summarize the latency histogram.
+ *
+ * \param pHistogram const latency_histogram_t* const   latency histogram
+ * \param pSummary latency_summary_t* const             summary of the histogram
+ *
+ */
+void summarize_latency(const latency_histogram_t* const pHistogram, latency_summary_t* const pSummary)
+{
+  pSummary->Count = 0;
+  pSummary->Max = 0;
+  for(uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+  {
+    if(pHistogram->Buckets[bucket] != 0)
+    {
+      pSummary->Count += pHistogram->Buckets[bucket];
+      pSummary->Max = get_bucket_latency(bucket);
+    }
+  }
+
+  pSummary->P50 = get_latency_percentile(pHistogram, 50.0);
+  pSummary->P99 = get_latency_percentile(pHistogram, 99.0);
+  pSummary->P999 = get_latency_percentile(pHistogram, 99.9);
+}
+
+#endif // HSM_HISTOGRAMS
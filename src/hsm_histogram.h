@@ -0,0 +1,121 @@
+/**
+ * \file
+ * \brief Log-bucketed latency histograms of state handlers
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_HISTOGRAM_H
+#define HSM_HISTOGRAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+
+#if HSM_HISTOGRAMS
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+//! Number of buckets in each power of 2 range
+#define HISTOGRAM_SUB_BUCKETS   (1u << HSM_HISTOGRAM_SUB_BUCKET_BITS)
+
+//! Values below HISTOGRAM_SUB_BUCKETS have a bucket each,
+//! every power of 2 range above has HISTOGRAM_SUB_BUCKETS buckets.
+#define HISTOGRAM_BUCKETS       ((HSM_HISTOGRAM_MAX_BITS - HSM_HISTOGRAM_SUB_BUCKET_BITS + 1) * HISTOGRAM_SUB_BUCKETS)
+
+#if (HSM_HISTOGRAM_MAX_BITS > 63) || (HSM_HISTOGRAM_MAX_BITS <= HSM_HISTOGRAM_SUB_BUCKET_BITS)
+#error "HSM_HISTOGRAM_MAX_BITS must be greater than HSM_HISTOGRAM_SUB_BUCKET_BITS and less than 64"
+#endif
+
+#if HSM_LATENCY_HISTOGRAM
+// Instrumentation points used by the framework. Event is a local variable of the dispatcher,
+// it is saved at the start, as the handler may change it by triggering to self.
+// Cycles is the duration of handler call measured by the dispatcher.
+
+#define HISTOGRAM_START(event, pState_Machine)                  \
+        ((event) = (pState_Machine)->Event)
+
+#define HISTOGRAM_RECORD(cycles, event, index, pState)          \
+        record_handler_latency(index, (pState)->Id, event, cycles)
+#endif // HSM_LATENCY_HISTOGRAM
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Latency histogram, the value of each bucket is the number of measured latencies.
+typedef struct
+{
+  uint32_t Buckets[HISTOGRAM_BUCKETS];
+}latency_histogram_t;
+
+//! Summary of latency histogram in cycle counter ticks.
+typedef struct
+{
+  uint64_t Count;     //!< Number of measured latencies
+  uint64_t Max;       //!< Highest latency
+  uint64_t P50;       //!< Median latency
+  uint64_t P99;       //!< 99th percentile latency
+  uint64_t P999;      //!< 99.9th percentile latency
+}latency_summary_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+#if HSM_LATENCY_HISTOGRAM
+extern void record_handler_latency(uint32_t index, uint32_t state, uint32_t event, uint64_t cycles);
+
+extern bool snapshot_state_latency(uint32_t state, uint32_t event,
+                                   latency_histogram_t* const pSnapshot, bool reset);
+
+extern void snapshot_other_state_latency(latency_histogram_t* const pSnapshot, bool reset);
+
+extern bool snapshot_machine_latency(uint32_t index, latency_histogram_t* const pSnapshot, bool reset);
+
+extern void reset_latency_histograms(void);
+#endif // HSM_LATENCY_HISTOGRAM
+
+extern void copy_latency_histogram(latency_histogram_t* const pHistogram,
+                                   latency_histogram_t* const pSnapshot, bool reset);
+
+extern uint32_t get_latency_bucket(uint64_t cycles);
+
+extern uint64_t get_bucket_latency(uint32_t bucket);
+
+extern uint64_t get_latency_percentile(const latency_histogram_t* const pHistogram, double percentile);
+
+extern void summarize_latency(const latency_histogram_t* const pHistogram, latency_summary_t* const pSummary);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+/*
+ *  --------------------- Inline functions ---------------------
+ */
+
+//! Count the latency in the histogram, it is safe to call from any thread.
+static inline void record_latency(latency_histogram_t* const pHistogram, uint64_t latency)
+{
+  HSM_ATOMIC_ADD(&pHistogram->Buckets[get_latency_bucket(latency)], 1);
+}
+
+#endif // HSM_HISTOGRAMS
+
+#endif // HSM_HISTOGRAM_H
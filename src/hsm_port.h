@@ -0,0 +1,132 @@
+/**
+ * \file
+ * \brief Compiler and platform abstraction used by the optional framework modules
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_PORT_H
+#define HSM_PORT_H
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+// The atomic operations work on plain integer and pointer objects so that the
+// framework structures stay usable from C++ and from pre-C11 compilers.
+// Provide your own definitions in hsm_config.h for compilers other than GCC/Clang.
+#ifndef HSM_ATOMIC_LOAD
+
+#if defined(__GNUC__) || defined(__clang__)
+
+#define HSM_ATOMIC_LOAD(pObject)                  __atomic_load_n(pObject, __ATOMIC_ACQUIRE)
+#define HSM_ATOMIC_STORE(pObject, value)          __atomic_store_n(pObject, value, __ATOMIC_RELEASE)
+#define HSM_ATOMIC_EXCHANGE(pObject, value)       __atomic_exchange_n(pObject, value, __ATOMIC_ACQ_REL)
+#define HSM_ATOMIC_CAS(pObject, pExpected, value) \
+        __atomic_compare_exchange_n(pObject, pExpected, value, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define HSM_ATOMIC_ADD(pObject, value)            __atomic_fetch_add(pObject, value, __ATOMIC_RELAXED)
+#define HSM_ATOMIC_LOAD_RELAXED(pObject)          __atomic_load_n(pObject, __ATOMIC_RELAXED)
+#define HSM_ATOMIC_STORE_RELAXED(pObject, value)  __atomic_store_n(pObject, value, __ATOMIC_RELAXED)
+
+#else
+#error "Atomic operations are not defined for this compiler. "\
+       "Define HSM_ATOMIC_LOAD, HSM_ATOMIC_STORE, HSM_ATOMIC_EXCHANGE, HSM_ATOMIC_CAS, HSM_ATOMIC_ADD, "\
+       "HSM_ATOMIC_LOAD_RELAXED and HSM_ATOMIC_STORE_RELAXED in hsm_config.h"
+#endif
+
+#endif // HSM_ATOMIC_LOAD
+
+// Storage class of per-thread variables. Define it empty in hsm_config.h for single threaded systems.
+#ifndef HSM_THREAD_LOCAL
+
+#if defined(__cplusplus)
+#define HSM_THREAD_LOCAL      thread_local
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define HSM_THREAD_LOCAL      _Thread_local
+#elif defined(__GNUC__) || defined(__clang__)
+#define HSM_THREAD_LOCAL      __thread
+#elif defined(_MSC_VER)
+#define HSM_THREAD_LOCAL      __declspec(thread)
+#else
+#define HSM_THREAD_LOCAL
+#endif
+
+#endif // HSM_THREAD_LOCAL
+
+// Minimum alignment of a type or an object, used to keep the per-thread data in their own cache lines.
+// Define it empty in hsm_config.h if the compiler has no alignment attribute.
+#ifndef HSM_ALIGNAS
+
+#if defined(__GNUC__) || defined(__clang__)
+#define HSM_ALIGNAS(alignment)    __attribute__((aligned(alignment)))
+#elif defined(_MSC_VER)
+#define HSM_ALIGNAS(alignment)    __declspec(align(alignment))
+#else
+#define HSM_ALIGNAS(alignment)
+#endif
+
+#endif // HSM_ALIGNAS
+
+// Compile time check usable from C99 and C++ at file scope, fails to compile with a negative array size.
+#define HSM_STATIC_ASSERT(condition, name)    typedef char name[(condition) ? 1 : -1]
+
+// Monotonic timestamp used by the instrumentation. HSM_TIMESTAMP_FREQUENCY is the number of ticks per second.
+// Provide your own definitions in hsm_config.h for other platforms, e.g. a hardware timer of the MCU.
+#ifndef HSM_TIMESTAMP
+
+#include <stdint.h>
+#include <time.h>
+
+#if defined(CLOCK_MONOTONIC) || (defined(TIME_UTC) && !defined(__cplusplus))
+
+static inline uint64_t hsm_timestamp(void)
+{
+  struct timespec time;
+#if defined(CLOCK_MONOTONIC)
+  clock_gettime(CLOCK_MONOTONIC, &time);
+#else
+  timespec_get(&time, TIME_UTC);    // Strict ISO C build, POSIX clocks are not visible.
+#endif
+  return (uint64_t)time.tv_sec * 1000000000u + (uint64_t)time.tv_nsec;
+}
+
+#define HSM_TIMESTAMP()             hsm_timestamp()
+#define HSM_TIMESTAMP_FREQUENCY     1000000000u
+#else
+#define HSM_TIMESTAMP()             0u
+#define HSM_TIMESTAMP_FREQUENCY     1u
+#endif
+
+#endif // HSM_TIMESTAMP
+
+// Free running counter with the lowest read cost, used to measure short durations.
+// Its frequency is unspecified, define it as HSM_TIMESTAMP() in hsm_config.h to measure in nanoseconds.
+#ifndef HSM_CYCLE_COUNTER
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HSM_CYCLE_COUNTER()         __builtin_ia32_rdtsc()
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#include <stdint.h>
+
+static inline uint64_t hsm_cycle_counter(void)
+{
+  uint64_t counter;
+  __asm__ volatile("mrs %0, cntvct_el0" : "=r"(counter));
+  return counter;
+}
+
+#define HSM_CYCLE_COUNTER()         hsm_cycle_counter()
+#else
+#define HSM_CYCLE_COUNTER()         HSM_TIMESTAMP()
+#endif
+
+#endif // HSM_CYCLE_COUNTER
+
+#endif // HSM_PORT_H
@@ -0,0 +1,90 @@
+/**
+ * \file
+ * \brief USDT static probes of the state machine framework
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_PROBE_H
+#define HSM_PROBE_H
+
+#include <stdint.h>
+
+#include "hsm.h"
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+// Probes of provider "hsm". State and state machine arguments are pointers.
+//
+//  dispatcher(pState_Machine[], quantity)            dispatch_event is called
+//  dispatch(index, pState_Machine, pState, event)    before the handler of pState is called
+//  result(index, pState_Machine, pState, result)     after the handler of pState has returned
+//  bubble(index, pState_Machine, pState, pParent)    unhandled event is passed to the parent state
+//  transition(pState_Machine, pSource, pTarget)      switch_state or traverse_state begins
+//  exit(pState_Machine, pState)                      before the exit action of pState
+//  entry(pState_Machine, pState)                     before the entry action of pState
+
+#if HSM_USDT_PROBES
+
+// Use sys/sdt.h of SystemTap when it is available, otherwise the minimal fallback.
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define HSM_HAS_SYS_SDT   1
+#endif
+#endif
+
+#if defined(HSM_HAS_SYS_SDT)
+#include <sys/sdt.h>
+
+#define HSM_PROBE2(name, a1, a2)            STAP_PROBE2(hsm, name, a1, a2)
+#define HSM_PROBE3(name, a1, a2, a3)        STAP_PROBE3(hsm, name, a1, a2, a3)
+#define HSM_PROBE4(name, a1, a2, a3, a4)    STAP_PROBE4(hsm, name, a1, a2, a3, a4)
+#else
+#include "hsm_sdt.h"
+
+#define HSM_PROBE2(name, a1, a2)            HSM_SDT_PROBE2(hsm, name, a1, a2)
+#define HSM_PROBE3(name, a1, a2, a3)        HSM_SDT_PROBE3(hsm, name, a1, a2, a3)
+#define HSM_PROBE4(name, a1, a2, a3, a4)    HSM_SDT_PROBE4(hsm, name, a1, a2, a3, a4)
+#endif
+
+#else
+
+#define HSM_PROBE2(name, a1, a2)            ((void)0)
+#define HSM_PROBE3(name, a1, a2, a3)        ((void)0)
+#define HSM_PROBE4(name, a1, a2, a3, a4)    ((void)0)
+
+#endif // HSM_USDT_PROBES
+
+// Instrumentation points used by the framework.
+
+#define PROBE_DISPATCHER(pState_Machine, quantity)                    \
+        HSM_PROBE2(dispatcher, pState_Machine, quantity)
+
+#define PROBE_EVENT(index, pState_Machine, pState)                    \
+        HSM_PROBE4(dispatch, index, pState_Machine, pState, (pState_Machine)->Event)
+
+#define PROBE_RESULT(index, pState_Machine, pState, result_)          \
+        HSM_PROBE4(result, index, pState_Machine, pState, result_)
+
+#define PROBE_BUBBLE(index, pState_Machine, pState, pParent)          \
+        HSM_PROBE4(bubble, index, pState_Machine, pState, pParent)
+
+#define PROBE_TRANSITION(pState_Machine, pSource, pTarget)            \
+        HSM_PROBE3(transition, pState_Machine, pSource, pTarget)
+
+#define PROBE_EXIT(pState_Machine, pState)                            \
+        HSM_PROBE2(exit, pState_Machine, pState)
+
+#define PROBE_ENTRY(pState_Machine, pState)                           \
+        HSM_PROBE2(entry, pState_Machine, pState)
+
+#endif // HSM_PROBE_H
@@ -0,0 +1,247 @@
+/**
+ * \file
+ * \brief Sampling profiler of the active state machine, state and event
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#if !defined(_XOPEN_SOURCE) && !defined(_GNU_SOURCE)
+#define _XOPEN_SOURCE 700     // sigaction and setitimer are not visible in strict ISO C build
+#endif
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+#include "hsm_profiler.h"
+
+#if HSM_SAMPLING_PROFILER
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+#define HSM_PROFILER_TIMER    1     //!< SIGPROF timer is available
+#else
+#define HSM_PROFILER_TIMER    0
+#endif
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+HSM_THREAD_LOCAL uint64_t Profile_Word;
+
+//! Open addressing hash table of the activity words, key 0 is a free bucket.
+static uint64_t Bucket_Word[HSM_PROFILER_BUCKETS];
+static uint64_t Bucket_Samples[HSM_PROFILER_BUCKETS];
+
+static uint64_t Total_Samples;
+static uint64_t Idle_Samples;
+static uint64_t Lost_Samples;
+
+#if HSM_PROFILER_TIMER
+static struct sigaction Previous_Action;
+static uint32_t Profiler_Running;     //!< 1 from the start to the stop of the profiler
+#endif // HSM_PROFILER_TIMER
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+static uint32_t get_bucket_hash(uint64_t word)
+{
+  word ^= word >> 31;
+  word *= 0x9E3779B97F4A7C15ull;
+  return (uint32_t)(word >> 40);
+}
+
+#if HSM_PROFILER_TIMER
+static void profiler_signal_handler(int signal)
+{
+  (void)signal;
+  sample_profiler();
+}
+#endif // HSM_PROFILER_TIMER
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Count a sample of the activity of calling thread.
+ *  It is called by the SIGPROF handler, it is async signal safe.
+ */
+void sample_profiler(void)
+{
+  const uint64_t word = HSM_ATOMIC_LOAD_RELAXED(&Profile_Word);
+  HSM_ATOMIC_ADD(&Total_Samples, 1);
+
+  if(word == PROFILE_IDLE)
+  {
+    HSM_ATOMIC_ADD(&Idle_Samples, 1);
+    return;
+  }
+
+  uint32_t bucket = get_bucket_hash(word);
+  for(uint32_t probe = 0; probe < HSM_PROFILER_BUCKETS; probe++, bucket++)
+  {
+    bucket &= HSM_PROFILER_BUCKETS - 1;
+    uint64_t key = HSM_ATOMIC_LOAD(&Bucket_Word[bucket]);
+    if(key == PROFILE_IDLE)
+    {
+      // Claim the free bucket, unless other thread has claimed it meanwhile.
+      HSM_ATOMIC_CAS(&Bucket_Word[bucket], &key, word);
+      key = HSM_ATOMIC_LOAD(&Bucket_Word[bucket]);
+    }
+
+    if(key == word)
+    {
+      HSM_ATOMIC_ADD(&Bucket_Samples[bucket], 1);
+      return;
+    }
+  }
+  HSM_ATOMIC_ADD(&Lost_Samples, 1);
+}
+
+/** \brief Start sampling the CPU time of the process with SIGPROF.
+ *  Each sample is attributed to the state handler running in the thread that receives the signal.
+ *  The SIGPROF handler of application is restored when the profiler is stopped.
+ *
+ * \param frequency uint32_t    samples per second of CPU time
+ * \return bool                 false if the profiler is already running,
+ *                              the timer is not available or could not be started
+ *
+ */
+bool start_sampling_profiler(uint32_t frequency)
+{
+#if HSM_PROFILER_TIMER
+  if((frequency == 0) || (frequency > 1000000))
+  {
+    return false;
+  }
+
+  // A second start would save the handler of profiler as the handler of application.
+  uint32_t running = 0;
+  if(HSM_ATOMIC_CAS(&Profiler_Running, &running, 1u) == 0)
+  {
+    return false;
+  }
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = profiler_signal_handler;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if(sigaction(SIGPROF, &action, &Previous_Action) != 0)
+  {
+    HSM_ATOMIC_STORE(&Profiler_Running, 0u);
+    return false;
+  }
+
+  struct itimerval timer;
+  timer.it_interval.tv_sec = (time_t)(1u / frequency);       // 1 s at 1 Hz, tv_usec must stay below 1 s.
+  timer.it_interval.tv_usec = (suseconds_t)((1000000u / frequency) % 1000000u);
+  timer.it_value = timer.it_interval;
+  if(setitimer(ITIMER_PROF, &timer, NULL) != 0)
+  {
+    sigaction(SIGPROF, &Previous_Action, NULL);
+    HSM_ATOMIC_STORE(&Profiler_Running, 0u);
+    return false;
+  }
+  return true;
+#else
+  (void)frequency;
+  return false;
+#endif // HSM_PROFILER_TIMER
+}
+
+/** \brief Stop the SIGPROF timer and restore the previous SIGPROF handler.
+ *
+ * \return bool   false if the profiler is not running
+ *
+ */
+bool stop_sampling_profiler(void)
+{
+#if HSM_PROFILER_TIMER
+  // Without a start, there is no handler of application to restore.
+  uint32_t running = 1;
+  if(HSM_ATOMIC_CAS(&Profiler_Running, &running, 0u) == 0)
+  {
+    return false;
+  }
+
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, NULL);
+  sigaction(SIGPROF, &Previous_Action, NULL);
+  return true;
+#else
+  return false;
+#endif // HSM_PROFILER_TIMER
+}
+
+/** \brief Copy the samples of each (state machine, state, event).
+ *
+ * \param pSamples profile_sample_t* const  buffer to store the samples
+ * \param count uint32_t                    capacity of the buffer
+ * \return uint32_t                         number of copied samples
+ *
+ */
+uint32_t read_profile_samples(profile_sample_t* const pSamples, uint32_t count)
+{
+  uint32_t samples = 0;
+  for(uint32_t bucket = 0; (bucket < HSM_PROFILER_BUCKETS) && (samples < count); bucket++)
+  {
+    const uint64_t word = HSM_ATOMIC_LOAD(&Bucket_Word[bucket]);
+    if(word != PROFILE_IDLE)
+    {
+      pSamples[samples].Machine = (uint32_t)(word >> (PROFILE_STATE_BITS + PROFILE_EVENT_BITS));
+      pSamples[samples].State = (uint32_t)(word >> PROFILE_EVENT_BITS) & PROFILE_STATE_MAX;
+      pSamples[samples].Event = (uint32_t)word & PROFILE_EVENT_MAX;
+      pSamples[samples].Samples = HSM_ATOMIC_LOAD_RELAXED(&Bucket_Samples[bucket]);
+      samples++;
+    }
+  }
+  return samples;
+}
+
+/** \brief Get the total, idle and lost samples.
+ *
+ * \param pTotals profile_totals_t* const   copy of the totals
+ *
+ */
+void get_profile_totals(profile_totals_t* const pTotals)
+{
+  pTotals->Samples = HSM_ATOMIC_LOAD_RELAXED(&Total_Samples);
+  pTotals->Idle = HSM_ATOMIC_LOAD_RELAXED(&Idle_Samples);
+  pTotals->Lost = HSM_ATOMIC_LOAD_RELAXED(&Lost_Samples);
+}
+
+/** \brief Clear all the samples. Call it while the profiler is stopped.
+ */
+void reset_sampling_profiler(void)
+{
+  for(uint32_t bucket = 0; bucket < HSM_PROFILER_BUCKETS; bucket++)
+  {
+    HSM_ATOMIC_STORE(&Bucket_Word[bucket], (uint64_t)PROFILE_IDLE);
+    HSM_ATOMIC_STORE_RELAXED(&Bucket_Samples[bucket], 0);
+  }
+  HSM_ATOMIC_STORE_RELAXED(&Total_Samples, 0);
+  HSM_ATOMIC_STORE_RELAXED(&Idle_Samples, 0);
+  HSM_ATOMIC_STORE_RELAXED(&Lost_Samples, 0);
+}
+
+#endif // HSM_SAMPLING_PROFILER
@@ -0,0 +1,127 @@
+/**
+ * \file
+ * \brief Sampling profiler of the active state machine, state and event
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_PROFILER_H
+#define HSM_PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+
+#if HSM_SAMPLING_PROFILER
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#if (HSM_PROFILER_BUCKETS & (HSM_PROFILER_BUCKETS - 1)) != 0
+#error "HSM_PROFILER_BUCKETS must be power of 2"
+#endif
+
+// The activity word of a thread packs the state machine index, state Id and event.
+// Values beyond the width of their field are saturated to the highest value.
+// Event 0 is never dispatched, hence the word 0 means that no handler is running.
+
+#define PROFILE_MACHINE_BITS      16
+#define PROFILE_STATE_BITS        24
+#define PROFILE_EVENT_BITS        24
+
+#define PROFILE_MACHINE_MAX       ((1u << PROFILE_MACHINE_BITS) - 1)
+#define PROFILE_STATE_MAX         ((1u << PROFILE_STATE_BITS) - 1)
+#define PROFILE_EVENT_MAX         ((1u << PROFILE_EVENT_BITS) - 1)
+
+#define PROFILE_IDLE              0
+
+// Instrumentation points used by the framework, a single store each.
+// The word of the caller is saved in the dispatcher and restored after the handler, so that
+// the handler calling dispatch_event for other state machines is still attributed once they return.
+
+#define PROFILE_EVENT(saved, index, pState_Machine, pState)                     \
+do{                                                                             \
+  (saved) = HSM_ATOMIC_LOAD_RELAXED(&Profile_Word);                             \
+  HSM_ATOMIC_STORE_RELAXED(&Profile_Word,                                       \
+                           make_profile_word(index, (pState)->Id, (pState_Machine)->Event)); \
+} while(0)
+
+#define PROFILE_RESULT(saved)                                                   \
+        HSM_ATOMIC_STORE_RELAXED(&Profile_Word, saved)
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Number of samples taken while the handler of State was processing the Event of the state machine
+typedef struct
+{
+  uint32_t Machine;     //!< Index of the state machine in the array passed to dispatch_event
+  uint32_t State;       //!< State Id
+  uint32_t Event;       //!< Event
+  uint64_t Samples;     //!< Number of samples
+}profile_sample_t;
+
+//! Total samples of the profiler
+typedef struct
+{
+  uint64_t Samples;     //!< Samples taken by the profiler
+  uint64_t Idle;        //!< Samples taken while no state handler was running
+  uint64_t Lost;        //!< Samples not counted as all the buckets are in use
+}profile_totals_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+//! Activity word of the calling thread
+extern HSM_THREAD_LOCAL uint64_t Profile_Word;
+
+extern bool start_sampling_profiler(uint32_t frequency);
+
+extern bool stop_sampling_profiler(void);
+
+extern void sample_profiler(void);
+
+extern uint32_t read_profile_samples(profile_sample_t* const pSamples, uint32_t count);
+
+extern void get_profile_totals(profile_totals_t* const pTotals);
+
+extern void reset_sampling_profiler(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+/*
+ *  --------------------- Inline functions ---------------------
+ */
+
+static inline uint64_t make_profile_word(uint32_t index, uint32_t state, uint32_t event)
+{
+  index = (index < PROFILE_MACHINE_MAX) ? index : PROFILE_MACHINE_MAX;
+  state = (state < PROFILE_STATE_MAX) ? state : PROFILE_STATE_MAX;
+  event = (event < PROFILE_EVENT_MAX) ? event : PROFILE_EVENT_MAX;
+
+  return ((uint64_t)index << (PROFILE_STATE_BITS + PROFILE_EVENT_BITS))
+         | ((uint64_t)state << PROFILE_EVENT_BITS)
+         | (uint64_t)event;
+}
+
+#endif // HSM_SAMPLING_PROFILER
+
+#endif // HSM_PROFILER_H
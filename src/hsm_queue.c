@@ -0,0 +1,158 @@
+/**
+ * \file
+ * \brief Queue depth and event wait time metrics
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+#include "hsm_histogram.h"
+#include "hsm_queue.h"
+
+#if HSM_QUEUE_METRICS
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+static latency_histogram_t Queue_Wait[HSM_QUEUE_MAX_MACHINES];
+
+//! Wait time of the state machines with index out of the Queue_Wait table.
+static latency_histogram_t Other_Queue_Wait;
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Timestamp the event and count it in the queue depth. It is called by post_event
+ *  before the event is visible to the dispatcher, from any thread.
+ *
+ * \param pState_Machine state_machine_t* const   target state machine
+ * \param pEvent event_t* const                   posted event object
+ *
+ */
+void record_queue_post(state_machine_t* const pState_Machine, event_t* const pEvent)
+{
+  pEvent->Post_Time = HSM_TIMESTAMP();
+
+  const uint32_t depth = HSM_ATOMIC_ADD(&pState_Machine->Queue_Depth.Depth, 1) + 1;
+  uint32_t high_water = HSM_ATOMIC_LOAD_RELAXED(&pState_Machine->Queue_Depth.High_Water);
+  while(depth > high_water)
+  {
+    if(HSM_ATOMIC_CAS(&pState_Machine->Queue_Depth.High_Water, &high_water, depth))
+    {
+      break;
+    }
+  }
+}
+
+/** \brief Record the wait time of the event loaded by the dispatcher and remove it from the queue depth.
+ *
+ * \param index uint32_t                          index of state machine in the array passed to dispatch_event
+ * \param pState_Machine state_machine_t* const   state machine with the loaded event object
+ *
+ */
+void record_queue_dispatch(uint32_t index, state_machine_t* const pState_Machine)
+{
+  const uint64_t wait = HSM_TIMESTAMP() - pState_Machine->Event_Object->Post_Time;
+  record_latency((index < HSM_QUEUE_MAX_MACHINES) ? &Queue_Wait[index] : &Other_Queue_Wait, wait);
+
+  HSM_ATOMIC_ADD(&pState_Machine->Queue_Depth.Depth, (uint32_t)-1);
+}
+
+/** \brief Get the queue depth of state machine. It is safe to call from any thread.
+ *
+ * \param pState_Machine state_machine_t* const   state machine
+ * \param pSnapshot queue_depth_t* const          copy of the queue depth
+ * \param reset bool                              true to restart the high water mark from the current depth
+ *
+ */
+void get_queue_depth(state_machine_t* const pState_Machine, queue_depth_t* const pSnapshot,
+                     bool reset)
+{
+  pSnapshot->Depth = HSM_ATOMIC_LOAD(&pState_Machine->Queue_Depth.Depth);
+  pSnapshot->High_Water = reset ? HSM_ATOMIC_EXCHANGE(&pState_Machine->Queue_Depth.High_Water, pSnapshot->Depth)
+                                : HSM_ATOMIC_LOAD(&pState_Machine->Queue_Depth.High_Water);
+}
+
+/** \brief Copy the wait time histogram of a state machine.
+ *
+ * \param index uint32_t                        index of state machine in the array passed to dispatch_event
+ * \param pSnapshot latency_histogram_t* const  copy of the histogram
+ * \param reset bool                            true to clear the histogram while copying it
+ * \return bool                                 false if index is out of range
+ *
+ */
+bool snapshot_queue_wait(uint32_t index, latency_histogram_t* const pSnapshot, bool reset)
+{
+  if(index >= HSM_QUEUE_MAX_MACHINES)
+  {
+    return false;
+  }
+
+  copy_latency_histogram(&Queue_Wait[index], pSnapshot, reset);
+  return true;
+}
+
+/** \brief Copy the wait time histogram of the state machines out of range of the table.
+ *
+ * \param pSnapshot latency_histogram_t* const  copy of the histogram
+ * \param reset bool                            true to clear the histogram while copying it
+ *
+ */
+void snapshot_other_queue_wait(latency_histogram_t* const pSnapshot, bool reset)
+{
+  copy_latency_histogram(&Other_Queue_Wait, pSnapshot, reset);
+}
+
+/** \brief Get the queue depth and the summary of wait time of a state machine.
+ *
+ * \param index uint32_t                          index of state machine in the array passed to dispatch_event
+ * \param pState_Machine state_machine_t* const   state machine
+ * \param pMetrics queue_metrics_t* const         queue metrics
+ * \param reset bool                              true to restart the high water mark and the wait histogram
+ * \return bool                                   false if index is out of range, the wait summary is empty
+ *
+ */
+bool get_queue_metrics(uint32_t index, state_machine_t* const pState_Machine,
+                       queue_metrics_t* const pMetrics, bool reset)
+{
+  static const latency_histogram_t empty;
+  latency_histogram_t histogram;
+
+  get_queue_depth(pState_Machine, &pMetrics->Depth, reset);
+
+  const bool valid = snapshot_queue_wait(index, &histogram, reset);
+  summarize_latency(valid ? &histogram : &empty, &pMetrics->Wait);
+  return valid;
+}
+
+//! Clear all the wait time histograms.
+void reset_queue_wait(void)
+{
+  latency_histogram_t discard;
+
+  for(uint32_t index = 0; index < HSM_QUEUE_MAX_MACHINES; index++)
+  {
+    copy_latency_histogram(&Queue_Wait[index], &discard, true);
+  }
+  copy_latency_histogram(&Other_Queue_Wait, &discard, true);
+}
+
+#endif // HSM_QUEUE_METRICS
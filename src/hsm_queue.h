@@ -0,0 +1,79 @@
+/**
+ * \file
+ * \brief Queue depth and event wait time metrics
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_QUEUE_H
+#define HSM_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hsm.h"
+#include "hsm_histogram.h"
+
+#if HSM_QUEUE_METRICS
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+// Instrumentation points used by the framework.
+
+#define QUEUE_RECORD_POST(pState_Machine, pEvent)               \
+        record_queue_post(pState_Machine, pEvent)
+
+#define QUEUE_RECORD_DISPATCH(index, pState_Machine)            \
+        record_queue_dispatch(index, pState_Machine)
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Queue metrics of a state machine
+typedef struct
+{
+  queue_depth_t Depth;        //!< Current and highest depth of the event queue
+  latency_summary_t Wait;     //!< Time from the post to the dispatch of events, in ticks of HSM_TIMESTAMP()
+}queue_metrics_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+extern void record_queue_post(state_machine_t* const pState_Machine, event_t* const pEvent);
+
+extern void record_queue_dispatch(uint32_t index, state_machine_t* const pState_Machine);
+
+extern void get_queue_depth(state_machine_t* const pState_Machine, queue_depth_t* const pSnapshot,
+                            bool reset);
+
+extern bool snapshot_queue_wait(uint32_t index, latency_histogram_t* const pSnapshot, bool reset);
+
+extern void snapshot_other_queue_wait(latency_histogram_t* const pSnapshot, bool reset);
+
+extern bool get_queue_metrics(uint32_t index, state_machine_t* const pState_Machine,
+                              queue_metrics_t* const pMetrics, bool reset);
+
+extern void reset_queue_wait(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // HSM_QUEUE_METRICS
+
+#endif // HSM_QUEUE_H
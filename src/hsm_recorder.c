@@ -0,0 +1,150 @@
+/**
+ * \file
+ * \brief Flight recorder of the recent state machine activity
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+#include "hsm_recorder.h"
+
+#if HSM_FLIGHT_RECORDER
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+static flight_recorder_handler_t Unhandled_Event_Handler;
+
+static const char* const Record_Name[] =
+{
+  [FLIGHT_DISPATCH]   = "dispatch",
+  [FLIGHT_RESULT]     = "result",
+  [FLIGHT_TRANSITION] = "transition",
+};
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+//! Print the state Id, or the address of state when the states have no Id.
+static void print_state(FILE* const pFile, const state_t* const pState)
+{
+#if HSM_STATE_ID
+  fprintf(pFile, "%lu", (unsigned long)pState->Id);
+#else
+  fprintf(pFile, "%p", (const void*)pState);
+#endif // HSM_STATE_ID
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Set the handler called when an unhandled event reaches the top state.
+ *
+ * \param handler flight_recorder_handler_t   handler, NULL to remove it
+ *
+ */
+void set_flight_recorder_handler(flight_recorder_handler_t handler)
+{
+  HSM_ATOMIC_STORE(&Unhandled_Event_Handler, handler);
+}
+
+/** \brief Report the unhandled event to the flight recorder handler.
+ *  It is called by the dispatcher when the unhandled event reaches the top state.
+ *
+ * \param index uint32_t    index of the state machine
+ * \param pState_Machine const state_machine_t* const   state machine
+ * \param pState const state_t* const                   top state
+ *
+ */
+void report_unhandled_event(uint32_t index, const state_machine_t* const pState_Machine,
+                            const state_t* const pState)
+{
+  const flight_recorder_handler_t handler = HSM_ATOMIC_LOAD(&Unhandled_Event_Handler);
+  if(handler != NULL)
+  {
+    handler(index, pState_Machine, pState);
+  }
+}
+
+/** \brief Copy the recent records of state machine, oldest first.
+ *  The state machine must not be dispatched while it is read, e.g. read from the recorder handler.
+ *
+ * \param pState_Machine const state_machine_t* const   state machine
+ * \param pRecords flight_record_t* const               buffer to store the records
+ * \param count uint32_t                                capacity of the buffer
+ * \return uint32_t                                     number of copied records
+ *
+ */
+uint32_t read_flight_recorder(const state_machine_t* const pState_Machine,
+                              flight_record_t* const pRecords, uint32_t count)
+{
+  const flight_recorder_t* const pRecorder = &pState_Machine->Recorder;
+  uint32_t available = (pRecorder->Count < HSM_FLIGHT_RECORDER_SIZE) ? pRecorder->Count
+                                                                     : HSM_FLIGHT_RECORDER_SIZE;
+  if(available > count)
+  {
+    available = count;  // Keep the newest records
+  }
+
+  const uint32_t first = pRecorder->Count - available;
+  for(uint32_t index = 0; index < available; index++)
+  {
+    pRecords[index] = pRecorder->Records[(first + index) & (HSM_FLIGHT_RECORDER_SIZE - 1)];
+  }
+  return available;
+}
+
+/** \brief Print the recent records of state machine as text, one record per line.
+ *
+ * \param pFile FILE* const                             output file, e.g. stderr
+ * \param pState_Machine const state_machine_t* const   state machine
+ *
+ */
+void print_flight_recorder(FILE* const pFile, const state_machine_t* const pState_Machine)
+{
+  flight_record_t records[HSM_FLIGHT_RECORDER_SIZE];
+  const uint32_t count = read_flight_recorder(pState_Machine, records, HSM_FLIGHT_RECORDER_SIZE);
+
+  fprintf(pFile, "flight recorder of state machine %p, last %lu of %lu records\n",
+          (const void*)pState_Machine, (unsigned long)count, (unsigned long)pState_Machine->Recorder.Count);
+
+  for(uint32_t index = 0; index < count; index++)
+  {
+    const flight_record_t* const pRecord = &records[index];
+    fprintf(pFile, "%-10s state ", Record_Name[pRecord->Type]);
+    print_state(pFile, pRecord->State);
+    fprintf(pFile, " event %lu", (unsigned long)pRecord->Event);
+
+    if(pRecord->Type == FLIGHT_RESULT)
+    {
+      fprintf(pFile, " result %u", (unsigned)pRecord->Result);
+    }
+    else if(pRecord->Type == FLIGHT_TRANSITION)
+    {
+      fprintf(pFile, " target ");
+      print_state(pFile, pRecord->Target);
+    }
+    fprintf(pFile, "\n");
+  }
+}
+
+#endif // HSM_FLIGHT_RECORDER
@@ -0,0 +1,105 @@
+/**
+ * \file
+ * \brief Flight recorder of the recent state machine activity
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_RECORDER_H
+#define HSM_RECORDER_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "hsm.h"
+
+#if HSM_FLIGHT_RECORDER
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#if (HSM_FLIGHT_RECORDER_SIZE & (HSM_FLIGHT_RECORDER_SIZE - 1)) != 0
+#error "HSM_FLIGHT_RECORDER_SIZE must be power of 2"
+#endif
+
+// Instrumentation points used by the framework.
+
+#define FLIGHT_RECORD_EVENT(pState_Machine, pState)                         \
+        record_flight(pState_Machine, FLIGHT_DISPATCH, pState, NULL, EVENT_HANDLED)
+
+#define FLIGHT_RECORD_RESULT(pState_Machine, pState, result)                \
+        record_flight(pState_Machine, FLIGHT_RESULT, pState, NULL, result)
+
+#define FLIGHT_RECORD_TRANSITION(pState_Machine, pSource, pTarget)          \
+        record_flight(pState_Machine, FLIGHT_TRANSITION, pSource, pTarget, EVENT_HANDLED)
+
+#define FLIGHT_RECORD_UNHANDLED(index, pState_Machine, pState)              \
+        report_unhandled_event(index, pState_Machine, pState)
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+/** \brief Called when an unhandled event reaches the top state of the state machine.
+ *
+ * \param index uint32_t    index of the state machine in the array passed to dispatch_event
+ * \param pState_Machine const state_machine_t* const   state machine, its Recorder holds the recent history
+ * \param pState const state_t* const                   top state that could not handle the event
+ *
+ */
+typedef void (*flight_recorder_handler_t)(uint32_t index, const state_machine_t* const pState_Machine,
+                                          const state_t* const pState);
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+extern void set_flight_recorder_handler(flight_recorder_handler_t handler);
+
+extern void report_unhandled_event(uint32_t index, const state_machine_t* const pState_Machine,
+                                   const state_t* const pState);
+
+extern uint32_t read_flight_recorder(const state_machine_t* const pState_Machine,
+                                     flight_record_t* const pRecords, uint32_t count);
+
+extern void print_flight_recorder(FILE* const pFile, const state_machine_t* const pState_Machine);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+/*
+ *  --------------------- Inline functions ---------------------
+ */
+
+//! Only the dispatching thread writes the recorder, a record is a few plain stores.
+static inline void record_flight(state_machine_t* const pState_Machine, flight_record_type_t type,
+                                 const state_t* const pState, const state_t* const pTarget,
+                                 state_machine_result_t result)
+{
+  flight_recorder_t* const pRecorder = &pState_Machine->Recorder;
+  flight_record_t* const pRecord = &pRecorder->Records[pRecorder->Count & (HSM_FLIGHT_RECORDER_SIZE - 1)];
+
+  pRecord->State = pState;
+  pRecord->Target = pTarget;
+  pRecord->Event = pState_Machine->Event;
+  pRecord->Type = (uint8_t)type;
+  pRecord->Result = (uint8_t)result;
+  pRecorder->Count++;
+}
+
+#endif // HSM_FLIGHT_RECORDER
+
+#endif // HSM_RECORDER_H
@@ -0,0 +1,168 @@
+/**
+ * \file
+ * \brief Time in state accounting
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+#include "hsm_residency.h"
+
+#if HSM_STATE_RESIDENCY
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+//! Parent state, NULL for the top states and in the finite state machine.
+static const state_t* get_parent(const state_t* const pState)
+{
+#if HIERARCHICAL_STATES
+  return pState->Parent;
+#else
+  (void)pState;
+  return NULL;
+#endif // HIERARCHICAL_STATES
+}
+
+/** \brief Add the time in state of a state machine, including the time since the start of its current state.
+ *  It reads the time while it may be updated by the dispatching thread, so the time of the current state
+ *  may be off by the last transition.
+ *
+ * \param pState_Machine const state_machine_t* const  state machine
+ * \param pResidency uint64_t[]                        time of each state Id
+ * \param now uint64_t                                 HSM_TIMESTAMP() of the query
+ *
+ */
+static void add_residency(const state_machine_t* const pState_Machine,
+                          uint64_t pResidency[HSM_RESIDENCY_MAX_STATES], uint64_t now)
+{
+  for(uint32_t state = 0; state < HSM_RESIDENCY_MAX_STATES; state++)
+  {
+    pResidency[state] += HSM_ATOMIC_LOAD_RELAXED(&pState_Machine->Residency.Time[state]);
+  }
+
+  const uint64_t enter_time = HSM_ATOMIC_LOAD_RELAXED(&pState_Machine->Residency.Enter_Time);
+  const state_t* pState = HSM_ATOMIC_LOAD_RELAXED(&pState_Machine->State);
+  if((enter_time == 0) || (now <= enter_time))
+  {
+    return;
+  }
+
+  for(; pState != NULL; pState = get_parent(pState))
+  {
+    if(pState->Id < HSM_RESIDENCY_MAX_STATES)
+    {
+      pResidency[pState->Id] += now - enter_time;
+    }
+  }
+}
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Clear the time in state and start the accounting from the current state.
+ *  Call it from the dispatching thread after setting the initial state. Otherwise,
+ *  the accounting starts at the first transition and the time in the initial state is not counted.
+ *
+ * \param pState_Machine state_machine_t* const   state machine
+ *
+ */
+void start_state_residency(state_machine_t* const pState_Machine)
+{
+  for(uint32_t state = 0; state < HSM_RESIDENCY_MAX_STATES; state++)
+  {
+    HSM_ATOMIC_STORE_RELAXED(&pState_Machine->Residency.Time[state], (uint64_t)0);
+  }
+  HSM_ATOMIC_STORE_RELAXED(&pState_Machine->Residency.Enter_Time, HSM_TIMESTAMP());
+}
+
+/** \brief Add the time since the last transition to the source state and its parent states.
+ *  It is called by the framework at the start of each transition, by the dispatching thread.
+ *
+ * \param pState_Machine state_machine_t* const   state machine
+ * \param pSource const state_t* const            state that is left
+ *
+ */
+void record_state_residency(state_machine_t* const pState_Machine, const state_t* const pSource)
+{
+  const uint64_t now = HSM_TIMESTAMP();
+  const uint64_t enter_time = pState_Machine->Residency.Enter_Time;
+  HSM_ATOMIC_STORE_RELAXED(&pState_Machine->Residency.Enter_Time, now);
+  if(enter_time == 0)
+  {
+    return;   // Accounting starts now.
+  }
+
+  // Single writer, the time doesn't need read-modify-write atomic instruction.
+  const uint64_t elapsed = now - enter_time;
+  for(const state_t* pState = pSource; pState != NULL; pState = get_parent(pState))
+  {
+    if(pState->Id < HSM_RESIDENCY_MAX_STATES)
+    {
+      uint64_t* const pTime = &pState_Machine->Residency.Time[pState->Id];
+      HSM_ATOMIC_STORE_RELAXED(pTime, *pTime + elapsed);
+    }
+  }
+}
+
+/** \brief Get the time spent by a state machine in a state, including its child states and the current state.
+ *
+ * \param pState_Machine const state_machine_t* const  state machine
+ * \param state uint32_t                               state Id
+ * \return uint64_t                                    time in ticks of HSM_TIMESTAMP(), 0 if Id is out of range
+ *
+ */
+uint64_t get_state_residency(const state_machine_t* const pState_Machine, uint32_t state)
+{
+  if(state >= HSM_RESIDENCY_MAX_STATES)
+  {
+    return 0;
+  }
+
+  uint64_t residency[HSM_RESIDENCY_MAX_STATES] = {0};
+  add_residency(pState_Machine, residency, HSM_TIMESTAMP());
+  return residency[state];
+}
+
+/** \brief Get the total time spent in each state by a fleet of state machines.
+ *  All the state machines are measured at the same time stamp.
+ *
+ * \param pState_Machine state_machine_t* const[]   array of state machines
+ * \param count uint32_t                            number of state machines
+ * \param pResidency uint64_t[]                     total time of each state Id, in ticks of HSM_TIMESTAMP()
+ *
+ */
+void get_fleet_residency(state_machine_t* const pState_Machine[], uint32_t count,
+                         uint64_t pResidency[HSM_RESIDENCY_MAX_STATES])
+{
+  const uint64_t now = HSM_TIMESTAMP();
+
+  for(uint32_t state = 0; state < HSM_RESIDENCY_MAX_STATES; state++)
+  {
+    pResidency[state] = 0;
+  }
+
+  for(uint32_t index = 0; index < count; index++)
+  {
+    add_residency(pState_Machine[index], pResidency, now);
+  }
+}
+
+#endif // HSM_STATE_RESIDENCY
@@ -0,0 +1,56 @@
+/**
+ * \file
+ * \brief Time in state accounting
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_RESIDENCY_H
+#define HSM_RESIDENCY_H
+
+#include <stdint.h>
+
+#include "hsm.h"
+
+#if HSM_STATE_RESIDENCY
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+// Instrumentation point used by the framework, at the start of switch_state and traverse_state.
+
+#define RESIDENCY_RECORD(pState_Machine, pSource)           \
+        record_state_residency(pState_Machine, pSource)
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+extern void start_state_residency(state_machine_t* const pState_Machine);
+
+extern void record_state_residency(state_machine_t* const pState_Machine, const state_t* const pSource);
+
+extern uint64_t get_state_residency(const state_machine_t* const pState_Machine, uint32_t state);
+
+extern void get_fleet_residency(state_machine_t* const pState_Machine[], uint32_t count,
+                                uint64_t pResidency[HSM_RESIDENCY_MAX_STATES]);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // HSM_STATE_RESIDENCY
+
+#endif // HSM_RESIDENCY_H
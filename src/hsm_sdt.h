@@ -0,0 +1,87 @@
+/**
+ * \file
+ * \brief Minimal USDT probe implementation for platforms without sys/sdt.h
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_SDT_H
+#define HSM_SDT_H
+
+#include <stdint.h>
+
+// Each probe is a single nop instruction. Its address and the location of its arguments
+// are described in the .note.stapsdt section in the format of SystemTap sys/sdt.h,
+// so that bpftrace, perf and SystemTap can attach to it.
+// Arguments are passed in 64 bit registers. Probes don't use semaphores, they are always armed.
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__ELF__) \
+    && (defined(__x86_64__) || defined(__aarch64__))
+
+#define HSM_SDT_SUPPORTED   1
+
+#define HSM_SDT_PROBE(provider, name, arguments, ...)                 \
+  __asm__ __volatile__(                                               \
+    "990: nop\n"                                                      \
+    ".pushsection .note.stapsdt,\"?\",\"note\"\n"                     \
+    ".balign 4\n"                                                     \
+    ".4byte 992f-991f, 994f-993f, 3\n"                                \
+    "991: .asciz \"stapsdt\"\n"                                       \
+    "992: .balign 4\n"                                                \
+    "993: .8byte 990b\n"                                              \
+    ".8byte _.stapsdt.base\n"                                         \
+    ".8byte 0\n"                                                      \
+    ".asciz \"" #provider "\"\n"                                      \
+    ".asciz \"" #name "\"\n"                                          \
+    ".asciz \"" arguments "\"\n"                                      \
+    "994: .balign 4\n"                                                \
+    ".popsection\n"                                                   \
+    ".ifndef _.stapsdt.base\n"                                        \
+    ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n" \
+    ".weak _.stapsdt.base\n"                                          \
+    ".hidden _.stapsdt.base\n"                                        \
+    "_.stapsdt.base: .space 1\n"                                      \
+    ".size _.stapsdt.base, 1\n"                                       \
+    ".popsection\n"                                                   \
+    ".endif\n"                                                        \
+    :: __VA_ARGS__)
+
+#define HSM_SDT_ARG1(value)     [hsm_arg1] "r" ((uint64_t)(value))
+#define HSM_SDT_ARG2(value)     [hsm_arg2] "r" ((uint64_t)(value))
+#define HSM_SDT_ARG3(value)     [hsm_arg3] "r" ((uint64_t)(value))
+#define HSM_SDT_ARG4(value)     [hsm_arg4] "r" ((uint64_t)(value))
+
+#define HSM_SDT_PROBE1(provider, name, a1)                            \
+        HSM_SDT_PROBE(provider, name, "8@%[hsm_arg1]", HSM_SDT_ARG1(a1))
+
+#define HSM_SDT_PROBE2(provider, name, a1, a2)                        \
+        HSM_SDT_PROBE(provider, name, "8@%[hsm_arg1] 8@%[hsm_arg2]",  \
+                      HSM_SDT_ARG1(a1), HSM_SDT_ARG2(a2))
+
+#define HSM_SDT_PROBE3(provider, name, a1, a2, a3)                    \
+        HSM_SDT_PROBE(provider, name, "8@%[hsm_arg1] 8@%[hsm_arg2] 8@%[hsm_arg3]", \
+                      HSM_SDT_ARG1(a1), HSM_SDT_ARG2(a2), HSM_SDT_ARG3(a3))
+
+#define HSM_SDT_PROBE4(provider, name, a1, a2, a3, a4)                \
+        HSM_SDT_PROBE(provider, name, "8@%[hsm_arg1] 8@%[hsm_arg2] 8@%[hsm_arg3] 8@%[hsm_arg4]", \
+                      HSM_SDT_ARG1(a1), HSM_SDT_ARG2(a2), HSM_SDT_ARG3(a3), HSM_SDT_ARG4(a4))
+
+#else
+
+#define HSM_SDT_SUPPORTED   0
+
+#define HSM_SDT_PROBE1(provider, name, a1)                    ((void)0)
+#define HSM_SDT_PROBE2(provider, name, a1, a2)                ((void)0)
+#define HSM_SDT_PROBE3(provider, name, a1, a2, a3)            ((void)0)
+#define HSM_SDT_PROBE4(provider, name, a1, a2, a3, a4)        ((void)0)
+
+#endif
+
+#endif // HSM_SDT_H
@@ -0,0 +1,249 @@
+/**
+ * \file
+ * \brief Lock-free binary trace buffer of state machine activity
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stddef.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+#include "hsm_trace.h"
+
+#if HSM_TRACE_BUFFER
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define HSM_TRACE_RELEASE   1     //!< Trace buffer is released when its thread exits
+#else
+#define HSM_TRACE_RELEASE   0
+#endif
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define DUMP_CHUNK_SIZE     64    //!< Number of records written to the dump file at once
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+HSM_THREAD_LOCAL trace_buffer_t* Trace_Buffer;
+
+static trace_buffer_t Trace_Buffers[HSM_TRACE_MAX_THREADS];
+static uint32_t Trace_Buffer_Count;
+
+//! Buffer shared by the threads that find all the trace buffers claimed. It is always full and never owned,
+//! the threads only increment its drop count.
+static trace_buffer_t Overflow_Buffer = {.Head = HSM_TRACE_BUFFER_SIZE, .Machine = TRACE_UNKNOWN_MACHINE};
+
+#if HSM_TRACE_RELEASE
+static pthread_key_t Release_Key;
+static pthread_once_t Release_Key_Once = PTHREAD_ONCE_INIT;
+#endif // HSM_TRACE_RELEASE
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+#if HSM_TRACE_RELEASE
+//! Return the trace buffer of exiting thread, its unread records stay for the consumer.
+static void release_trace_buffer(void* pBuffer)
+{
+  HSM_ATOMIC_STORE(&((trace_buffer_t*)pBuffer)->Owned, 0u);
+}
+
+static void create_release_key(void)
+{
+  pthread_key_create(&Release_Key, release_trace_buffer);
+}
+#endif // HSM_TRACE_RELEASE
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Claim a free trace buffer for the calling thread.
+ *  It is called on the first record of each thread. On POSIX systems, the buffer is released when
+ *  the thread exits and a later thread reuses it. The records of the threads finding no free buffer
+ *  are counted as dropped.
+ *
+ * \return trace_buffer_t*    trace buffer of calling thread
+ *
+ */
+trace_buffer_t* claim_trace_buffer(void)
+{
+  for(uint32_t index = 0; index < HSM_TRACE_MAX_THREADS; index++)
+  {
+    uint32_t owned = 0;
+    if(HSM_ATOMIC_CAS(&Trace_Buffers[index].Owned, &owned, 1u) == 0)
+    {
+      continue;
+    }
+
+    // Buffer count covers all the buffers ever claimed, the consumer reads them all.
+    uint32_t count = HSM_ATOMIC_LOAD(&Trace_Buffer_Count);
+    while((count <= index) && (HSM_ATOMIC_CAS(&Trace_Buffer_Count, &count, index + 1) == 0))
+    {
+    }
+
+    Trace_Buffer = &Trace_Buffers[index];
+    Trace_Buffer->Machine = TRACE_UNKNOWN_MACHINE;
+#if HSM_TRACE_RELEASE
+    pthread_once(&Release_Key_Once, create_release_key);
+    pthread_setspecific(Release_Key, Trace_Buffer);
+#endif // HSM_TRACE_RELEASE
+    return Trace_Buffer;
+  }
+
+  // Records of this thread are counted as dropped.
+  Trace_Buffer = &Overflow_Buffer;
+  return Trace_Buffer;
+}
+
+/** \brief Get the number of trace buffers claimed by the threads, including the released ones.
+ *
+ * \return uint32_t   number of trace buffers
+ *
+ */
+uint32_t get_trace_buffer_count(void)
+{
+  return HSM_ATOMIC_LOAD(&Trace_Buffer_Count);
+}
+
+/** \brief Get the trace buffer.
+ *
+ * \param index uint32_t      index of trace buffer, less than get_trace_buffer_count()
+ * \return trace_buffer_t*    trace buffer or NULL if index is out of range
+ *
+ */
+trace_buffer_t* get_trace_buffer(uint32_t index)
+{
+  if(index >= get_trace_buffer_count())
+  {
+    return NULL;
+  }
+  return &Trace_Buffers[index];
+}
+
+/** \brief Get the number of records dropped as their thread found no free trace buffer, since the last dump.
+ *
+ * \return uint32_t   number of dropped records
+ *
+ */
+uint32_t get_untraced_records(void)
+{
+  return HSM_ATOMIC_LOAD(&Overflow_Buffer.Dropped);
+}
+
+/** \brief Read the oldest records from the trace buffer. Only one consumer may read a buffer at a time,
+ *  but it can run concurrently to the thread recording the trace.
+ *
+ * \param pBuffer trace_buffer_t* const       trace buffer to read
+ * \param pRecords trace_record_t* const      storage for the records
+ * \param count uint32_t                      maximum number of records to read
+ * \return uint32_t                           number of records read
+ *
+ */
+uint32_t read_trace(trace_buffer_t* const pBuffer, trace_record_t* const pRecords, uint32_t count)
+{
+  const uint32_t tail = pBuffer->Tail;
+  uint32_t available = HSM_ATOMIC_LOAD(&pBuffer->Head) - tail;
+  if(available > count)
+  {
+    available = count;
+  }
+
+  for(uint32_t index = 0; index < available; index++)
+  {
+    pRecords[index] = pBuffer->Records[(tail + index) & (HSM_TRACE_BUFFER_SIZE - 1)];
+  }
+
+  HSM_ATOMIC_STORE(&pBuffer->Tail, tail + available);   // Return the slots to the producer.
+  return available;
+}
+
+/** \brief Write the unread records of all trace buffers to the binary dump file.
+ *  Use the hsm_trace_decode tool to convert the dump into text.
+ *
+ * \param pFile FILE* const   file opened in binary mode
+ * \return uint32_t           number of records written
+ *
+ */
+uint32_t dump_trace(FILE* const pFile)
+{
+  const trace_dump_header_t header =
+  {
+    .Magic = TRACE_DUMP_MAGIC,
+    .Version = TRACE_DUMP_VERSION,
+    .Record_Size = sizeof(trace_record_t),
+    .Ticks_Per_Second = HSM_TIMESTAMP_FREQUENCY,
+  };
+  trace_record_t records[DUMP_CHUNK_SIZE];
+  uint32_t total = 0;
+
+  if(fwrite(&header, sizeof(header), 1, pFile) != 1)
+  {
+    return 0;
+  }
+
+  const uint32_t buffers = get_trace_buffer_count();
+  for(uint32_t thread = 0; thread < buffers; thread++)
+  {
+    trace_buffer_t* const pBuffer = &Trace_Buffers[thread];
+    uint32_t count;
+
+    // Records are written in blocks, each block carries the records dropped till then.
+    do
+    {
+      count = read_trace(pBuffer, records, DUMP_CHUNK_SIZE);
+      const trace_dump_block_t block =
+      {
+        .Thread = thread,
+        .Count = count,
+        .Dropped = HSM_ATOMIC_EXCHANGE(&pBuffer->Dropped, 0),
+      };
+
+      if((count == 0) && (block.Dropped == 0))
+      {
+        break;
+      }
+
+      if((fwrite(&block, sizeof(block), 1, pFile) != 1)
+         || (fwrite(records, sizeof(trace_record_t), count, pFile) != count))
+      {
+        return total;
+      }
+      total += count;
+    }while(count == DUMP_CHUNK_SIZE);
+  }
+
+  // Records of the threads without trace buffer.
+  const trace_dump_block_t overflow =
+  {
+    .Thread = HSM_TRACE_MAX_THREADS,
+    .Dropped = HSM_ATOMIC_EXCHANGE(&Overflow_Buffer.Dropped, 0),
+  };
+  if(overflow.Dropped != 0)
+  {
+    fwrite(&overflow, sizeof(overflow), 1, pFile);
+  }
+  return total;
+}
+
+#endif // HSM_TRACE_BUFFER
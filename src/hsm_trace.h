@@ -0,0 +1,184 @@
+/**
+ * \file
+ * \brief Lock-free binary trace buffer of state machine activity
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_TRACE_H
+#define HSM_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+#include "hsm_trace_format.h"
+
+#if HSM_TRACE_BUFFER
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#if (HSM_TRACE_BUFFER_SIZE & (HSM_TRACE_BUFFER_SIZE - 1)) != 0
+#error "HSM_TRACE_BUFFER_SIZE must be power of 2"
+#endif
+
+#if HSM_EVENT_OBJECTS
+//! Flow id links the dispatch of an event object to its post.
+#define TRACE_FLOW_ID(pState_Machine)     get_trace_flow_id((pState_Machine)->Event_Object)
+#else
+#define TRACE_FLOW_ID(pState_Machine)     0u
+#endif // HSM_EVENT_OBJECTS
+
+// Instrumentation points used by the framework.
+
+#define TRACE_RECORD_EVENT(index, pState_Machine, pState)                   \
+        record_dispatch_trace(TRACE_DISPATCH, index, (pState)->Id,          \
+                              (pState_Machine)->Event, TRACE_FLOW_ID(pState_Machine), 0)
+
+#define TRACE_RECORD_RESULT(index, pState_Machine, pState, result)          \
+        record_result_trace(index, (pState)->Id, (pState_Machine)->Event,   \
+                            (pState_Machine)->State->Id, (uint8_t)(result))
+
+#define TRACE_RECORD_BUBBLE(index, pState_Machine, pState, pParent)         \
+        record_dispatch_trace(TRACE_BUBBLE, index, (pState)->Id,            \
+                              (pState_Machine)->Event, (pParent)->Id, 0)
+
+#define TRACE_RECORD_TRANSITION(pState_Machine, pSource, pTarget)           \
+        record_trace(TRACE_TRANSITION, (pSource)->Id, (pState_Machine)->Event, (pTarget)->Id, 0)
+
+#define TRACE_RECORD_EXIT(pState_Machine, pState)                           \
+        record_trace(TRACE_EXIT, (pState)->Id, (pState_Machine)->Event, 0, 0)
+
+#define TRACE_RECORD_ENTRY(pState_Machine, pState)                          \
+        record_trace(TRACE_ENTRY, (pState)->Id, (pState_Machine)->Event, 0, 0)
+
+#define TRACE_RECORD_POST(pEvent)                                           \
+        record_trace(TRACE_POST, 0, (pEvent)->Id, get_trace_flow_id(pEvent), 0)
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Single producer, single consumer ring buffer of trace records owned by one thread.
+typedef struct
+{
+  trace_record_t Records[HSM_TRACE_BUFFER_SIZE];
+  uint32_t Head;        //!< Write count, updated only by the owning thread
+  uint32_t Tail;        //!< Read count, updated only by the consumer
+  uint32_t Dropped;     //!< Number of records lost as the buffer was full
+  uint32_t Owned;       //!< 1 while a thread owns the buffer, always 0 for the buffer shared by the other threads
+  uint16_t Machine;     //!< Index of state machine under dispatch on the owning thread
+}trace_buffer_t;
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+//! Trace buffer of the calling thread, NULL till its first record.
+extern HSM_THREAD_LOCAL trace_buffer_t* Trace_Buffer;
+
+extern trace_buffer_t* claim_trace_buffer(void);
+
+extern uint32_t get_trace_buffer_count(void);
+
+extern trace_buffer_t* get_trace_buffer(uint32_t index);
+
+extern uint32_t read_trace(trace_buffer_t* const pBuffer, trace_record_t* const pRecords, uint32_t count);
+
+extern uint32_t get_untraced_records(void);
+
+extern uint32_t dump_trace(FILE* const pFile);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+/*
+ *  --------------------- Inline functions ---------------------
+ */
+
+//! Flow id of the event object, 0 for NULL. Ids are reused along with the event objects.
+static inline uint32_t get_trace_flow_id(const void* const pObject)
+{
+  return (uint32_t)((uintptr_t)pObject >> 3);
+}
+
+/** \brief Append a record to the trace buffer of the calling thread. It never blocks.
+ *  The record is dropped, if the consumer hasn't read the buffer in time or the thread has no buffer.
+ *  All the fields are written before the record is published, the consumer may read it right away.
+ */
+static inline void record_trace(trace_record_type_t type, uint32_t state, uint32_t event, uint32_t aux,
+                                uint8_t result)
+{
+  trace_buffer_t* pBuffer = Trace_Buffer;
+  if(pBuffer == NULL)
+  {
+    pBuffer = claim_trace_buffer();
+  }
+
+  const uint32_t head = pBuffer->Head;
+  if((head - HSM_ATOMIC_LOAD(&pBuffer->Tail)) >= HSM_TRACE_BUFFER_SIZE)
+  {
+    HSM_ATOMIC_ADD(&pBuffer->Dropped, 1);
+    return;
+  }
+
+  trace_record_t* const pRecord = &pBuffer->Records[head & (HSM_TRACE_BUFFER_SIZE - 1)];
+  pRecord->Timestamp = HSM_TIMESTAMP();
+  pRecord->State = state;
+  pRecord->Event = event;
+  pRecord->Aux = aux;
+  pRecord->Machine = pBuffer->Machine;
+  pRecord->Type = (uint8_t)type;
+  pRecord->Result = result;
+
+  HSM_ATOMIC_STORE(&pBuffer->Head, head + 1);   // Publish the record to the consumer.
+}
+
+//! Append a record of the dispatcher, it also sets the state machine under dispatch.
+static inline void record_dispatch_trace(trace_record_type_t type, uint32_t index, uint32_t state,
+                                         uint32_t event, uint32_t aux, uint8_t result)
+{
+  trace_buffer_t* pBuffer = Trace_Buffer;
+  if(pBuffer == NULL)
+  {
+    pBuffer = claim_trace_buffer();
+  }
+
+  // The shared buffer only counts the dropped records, its fields are not written.
+  if(pBuffer->Owned != 0)
+  {
+    pBuffer->Machine = (uint16_t)index;
+  }
+  record_trace(type, state, event, aux, result);
+}
+
+//! Append the result of state handler. Records after it are outside of the dispatched state machine.
+static inline void record_result_trace(uint32_t index, uint32_t state, uint32_t event,
+                                       uint32_t current, uint8_t result)
+{
+  record_dispatch_trace(TRACE_RESULT, index, state, event, current, result);
+  if(Trace_Buffer->Owned != 0)
+  {
+    Trace_Buffer->Machine = TRACE_UNKNOWN_MACHINE;
+  }
+}
+
+#endif // HSM_TRACE_BUFFER
+
+#endif // HSM_TRACE_H
@@ -0,0 +1,84 @@
+/**
+ * \file
+ * \brief Binary format of the state machine trace records and trace dump
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_TRACE_FORMAT_H
+#define HSM_TRACE_FORMAT_H
+
+#include <stdint.h>
+
+// This file is independent of the framework configuration,
+// so that the offline tools can decode the dumps of any build.
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define TRACE_DUMP_MAGIC        0x544D5348u   //!< "HSMT" in little endian
+#define TRACE_DUMP_VERSION      1u
+
+#define TRACE_UNKNOWN_MACHINE   0xFFFFu       //!< Machine index outside of the dispatcher
+
+/*
+ *  --------------------- ENUMERATION ---------------------
+ */
+
+//! Type of trace record
+typedef enum
+{
+  TRACE_DISPATCH,     //!< Event dispatched to state handler. Aux: flow id of event object, 0 for plain event
+  TRACE_RESULT,       //!< State handler returned. Result: handler result, Aux: Id of current state
+  TRACE_BUBBLE,       //!< Event passed to parent state. Aux: Id of parent state
+  TRACE_TRANSITION,   //!< switch_state/traverse_state called. State: source, Aux: target state Id
+  TRACE_EXIT,         //!< State exited.
+  TRACE_ENTRY,        //!< State entered.
+  TRACE_POST,         //!< Event object posted. Machine: posting state machine, Aux: flow id of event object
+  TOTAL_TRACE_TYPES
+}trace_record_type_t;
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Trace record (24 bytes)
+typedef struct
+{
+  uint64_t Timestamp;     //!< Time of the record in ticks of trace clock
+  uint32_t State;         //!< Id of the state
+  uint32_t Event;         //!< Event under processing
+  uint32_t Aux;           //!< Record type specific value
+  uint16_t Machine;       //!< Index of state machine in the array passed to dispatch_event
+  uint8_t Type;           //!< trace_record_type_t
+  uint8_t Result;         //!< state_machine_result_t for TRACE_RESULT
+}trace_record_t;
+
+//! Header of the trace dump file.
+typedef struct
+{
+  uint32_t Magic;             //!< TRACE_DUMP_MAGIC
+  uint32_t Version;           //!< TRACE_DUMP_VERSION
+  uint32_t Record_Size;       //!< sizeof(trace_record_t)
+  uint32_t Reserved;
+  uint64_t Ticks_Per_Second;  //!< Frequency of the trace clock
+}trace_dump_header_t;
+
+//! Header of records of one thread in the dump file. The records follow the header.
+typedef struct
+{
+  uint32_t Thread;        //!< Index of trace buffer
+  uint32_t Count;         //!< Number of records that follow
+  uint32_t Dropped;       //!< Number of records lost as the trace buffer was full
+  uint32_t Reserved;
+}trace_dump_block_t;
+
+#endif // HSM_TRACE_FORMAT_H
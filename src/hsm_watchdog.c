@@ -0,0 +1,437 @@
+/**
+ * \file
+ * \brief Watchdog of slow and blocked state handlers
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#if !defined(_XOPEN_SOURCE) && !defined(_GNU_SOURCE)
+#define _XOPEN_SOURCE 700     // nanosleep and POSIX clocks are not visible in strict ISO C build
+#endif
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hsm.h"
+#include "hsm_port.h"
+#include "hsm_watchdog.h"
+
+#if HSM_WATCHDOG
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <time.h>
+#define HSM_WATCHDOG_THREAD   1     //!< Watchdog thread is available
+#else
+#define HSM_WATCHDOG_THREAD   0
+#endif
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Watched call in progress. The fields are published to the watchdog with release stores.
+typedef struct
+{
+  uint64_t Active;                  //!< Sequence number of the call, 0 when the frame is not in use
+  uint64_t Start;                   //!< HSM_TIMESTAMP() at the start of call
+  const state_machine_t* Machine;
+  const state_t* State;
+  uint32_t Event;
+  uint32_t Kind;
+  uint64_t Reported;                //!< Sequence number of the last call reported as blocked
+}watchdog_frame_t;
+
+//! Watched calls of a thread, the nested calls are on top of their caller.
+typedef struct
+{
+  watchdog_frame_t Frames[HSM_WATCHDOG_MAX_DEPTH];
+  uint32_t Depth;                   //!< Number of nested calls, written by the owner thread only
+  uint64_t Sequence;                //!< Sequence number of the last call, written by the owner thread only
+}watchdog_slot_t;
+
+//! Recent violation. The fields are written and read with atomic accesses, between the updates of Sequence.
+typedef struct
+{
+  uint64_t Sequence;                //!< Number of violations up to this one, 0 while the violation is written
+  watchdog_violation_t Violation;
+}violation_slot_t;
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+static uint64_t Global_Threshold[TOTAL_WATCHDOG_KINDS];
+static uint64_t State_Threshold[HSM_WATCHDOG_MAX_STATES];
+static watchdog_handler_t Violation_Handler;
+
+static watchdog_slot_t Watchdog_Slots[HSM_WATCHDOG_MAX_THREADS];
+static uint32_t Watchdog_Slot_Count;
+static HSM_THREAD_LOCAL watchdog_slot_t* Watchdog_Slot;
+
+//! Slot of the threads started after all the slots are claimed.
+//! Their slow calls are reported, but the watchdog doesn't check them for blocked calls.
+static HSM_THREAD_LOCAL watchdog_slot_t Unwatched_Slot;
+
+static violation_slot_t Violations[HSM_WATCHDOG_VIOLATIONS];
+static uint64_t Violation_Count;
+
+#if HSM_WATCHDOG_THREAD
+static pthread_t Watchdog_Thread;
+static uint32_t Watchdog_Period;    // in milliseconds, 0 when the thread is not running
+#endif // HSM_WATCHDOG_THREAD
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+static watchdog_slot_t* get_watchdog_slot(void)
+{
+  if(Watchdog_Slot != NULL)
+  {
+    return Watchdog_Slot;
+  }
+
+  uint32_t count = HSM_ATOMIC_LOAD(&Watchdog_Slot_Count);
+  do
+  {
+    if(count >= HSM_WATCHDOG_MAX_THREADS)
+    {
+      Watchdog_Slot = &Unwatched_Slot;
+      return Watchdog_Slot;
+    }
+  }while(HSM_ATOMIC_CAS(&Watchdog_Slot_Count, &count, count + 1) == 0);
+
+  Watchdog_Slot = &Watchdog_Slots[count];
+  return Watchdog_Slot;
+}
+
+//! Threshold of the state if it has one, otherwise the global threshold of the kind of call.
+static uint64_t get_threshold(uint32_t kind, const state_t* const pState)
+{
+  if(pState->Id < HSM_WATCHDOG_MAX_STATES)
+  {
+    const uint64_t threshold = HSM_ATOMIC_LOAD_RELAXED(&State_Threshold[pState->Id]);
+    if(threshold != 0)
+    {
+      return threshold;
+    }
+  }
+  return HSM_ATOMIC_LOAD_RELAXED(&Global_Threshold[kind]);
+}
+
+static void report_violation(const watchdog_violation_t* const pViolation)
+{
+  const uint64_t index = HSM_ATOMIC_ADD(&Violation_Count, 1);
+  violation_slot_t* const pSlot = &Violations[index & (HSM_WATCHDOG_VIOLATIONS - 1)];
+
+  // Readers skip the slot till the sequence number of this violation is published after its fields.
+  HSM_ATOMIC_STORE(&pSlot->Sequence, (uint64_t)0);
+  HSM_ATOMIC_STORE(&pSlot->Violation.Machine, pViolation->Machine);
+  HSM_ATOMIC_STORE(&pSlot->Violation.State, pViolation->State);
+  HSM_ATOMIC_STORE(&pSlot->Violation.Duration, pViolation->Duration);
+  HSM_ATOMIC_STORE(&pSlot->Violation.Event, pViolation->Event);
+  HSM_ATOMIC_STORE(&pSlot->Violation.Kind, pViolation->Kind);
+  HSM_ATOMIC_STORE(&pSlot->Violation.Blocked, pViolation->Blocked);
+  HSM_ATOMIC_STORE(&pSlot->Sequence, index + 1);
+
+  const watchdog_handler_t handler = HSM_ATOMIC_LOAD(&Violation_Handler);
+  if(handler != NULL)
+  {
+    handler(pViolation);
+  }
+}
+
+//! Report the call in the frame, if it is running longer than its threshold and is not yet reported.
+static bool check_frame(watchdog_frame_t* const pFrame, uint64_t now)
+{
+  const uint64_t active = HSM_ATOMIC_LOAD(&pFrame->Active);
+  uint64_t reported = HSM_ATOMIC_LOAD(&pFrame->Reported);
+  if((active == 0) || (active == reported))
+  {
+    return false;
+  }
+
+  watchdog_violation_t violation;
+  const uint64_t start = HSM_ATOMIC_LOAD(&pFrame->Start);
+  violation.Machine = HSM_ATOMIC_LOAD(&pFrame->Machine);
+  violation.State = HSM_ATOMIC_LOAD(&pFrame->State);
+  violation.Event = HSM_ATOMIC_LOAD(&pFrame->Event);
+  violation.Kind = (uint8_t)HSM_ATOMIC_LOAD(&pFrame->Kind);
+  violation.Blocked = 1;
+
+  // Discard the fields, if the call has returned while they were read.
+  if(HSM_ATOMIC_LOAD(&pFrame->Active) != active)
+  {
+    return false;
+  }
+
+  violation.Duration = (now > start) ? now - start : 0;
+  const uint64_t threshold = get_threshold(violation.Kind, violation.State);
+  if((threshold == 0) || (violation.Duration <= threshold))
+  {
+    return false;
+  }
+
+  // Report the call once, even if several threads check the watchdog.
+  if(HSM_ATOMIC_CAS(&pFrame->Reported, &reported, active) == 0)
+  {
+    return false;
+  }
+
+  report_violation(&violation);
+  return true;
+}
+
+#if HSM_WATCHDOG_THREAD
+static void* watchdog_thread(void* pArgument)
+{
+  (void)pArgument;
+
+  uint32_t period;
+  while((period = HSM_ATOMIC_LOAD(&Watchdog_Period)) != 0)
+  {
+    struct timespec delay;
+    delay.tv_sec = (time_t)(period / 1000u);
+    delay.tv_nsec = (long)(period % 1000u) * 1000000L;
+    nanosleep(&delay, NULL);
+    check_watchdog();
+  }
+  return NULL;
+}
+#endif // HSM_WATCHDOG_THREAD
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Set the global threshold of a kind of call.
+ *
+ * \param kind watchdog_kind_t    handler, entry or exit action
+ * \param threshold uint64_t      threshold in ticks of HSM_TIMESTAMP(), 0 to not watch the calls
+ *
+ */
+void set_watchdog_threshold(watchdog_kind_t kind, uint64_t threshold)
+{
+  HSM_ATOMIC_STORE_RELAXED(&Global_Threshold[kind], threshold);
+}
+
+/** \brief Set the threshold of the handler, entry and exit action of a state, in place of the global thresholds.
+ *
+ * \param state uint32_t          state Id
+ * \param threshold uint64_t      threshold in ticks of HSM_TIMESTAMP(), 0 to use the global thresholds
+ * \return bool                   false if the state Id is out of range of the table
+ *
+ */
+bool set_state_watchdog_threshold(uint32_t state, uint64_t threshold)
+{
+  if(state >= HSM_WATCHDOG_MAX_STATES)
+  {
+    return false;
+  }
+
+  HSM_ATOMIC_STORE_RELAXED(&State_Threshold[state], threshold);
+  return true;
+}
+
+/** \brief Set the handler called for each violation.
+ *
+ * \param handler watchdog_handler_t    handler, NULL to remove it
+ *
+ */
+void set_watchdog_handler(watchdog_handler_t handler)
+{
+  HSM_ATOMIC_STORE(&Violation_Handler, handler);
+}
+
+/** \brief Start watching a call. It is called by the framework before the call.
+ *
+ * \param kind watchdog_kind_t                          handler, entry or exit action
+ * \param pState_Machine const state_machine_t* const   state machine
+ * \param pState const state_t* const                   state whose handler or action is called
+ *
+ */
+void start_watchdog_call(watchdog_kind_t kind, const state_machine_t* const pState_Machine,
+                         const state_t* const pState)
+{
+  watchdog_slot_t* const pSlot = get_watchdog_slot();
+  const uint32_t depth = pSlot->Depth++;
+  if(depth >= HSM_WATCHDOG_MAX_DEPTH)
+  {
+    return;   // Too deep, the call is not watched.
+  }
+
+  watchdog_frame_t* const pFrame = &pSlot->Frames[depth];
+  HSM_ATOMIC_STORE(&pFrame->Machine, pState_Machine);
+  HSM_ATOMIC_STORE(&pFrame->State, pState);
+  HSM_ATOMIC_STORE(&pFrame->Event, pState_Machine->Event);
+  HSM_ATOMIC_STORE(&pFrame->Kind, (uint32_t)kind);
+  HSM_ATOMIC_STORE(&pFrame->Start, HSM_TIMESTAMP());
+  HSM_ATOMIC_STORE(&pFrame->Active, ++pSlot->Sequence);
+}
+
+/** \brief Stop watching the last call and report it, if it has exceeded its threshold.
+ *  It is called by the framework after the call.
+ */
+void stop_watchdog_call(void)
+{
+  watchdog_slot_t* const pSlot = get_watchdog_slot();
+  const uint32_t depth = --pSlot->Depth;
+  if(depth >= HSM_WATCHDOG_MAX_DEPTH)
+  {
+    return;
+  }
+
+  watchdog_frame_t* const pFrame = &pSlot->Frames[depth];
+  const uint64_t duration = HSM_TIMESTAMP() - pFrame->Start;
+  const uint64_t active = pFrame->Active;
+  uint64_t reported = HSM_ATOMIC_LOAD(&pFrame->Reported);
+
+  // The call is reported once. It is claimed before the frame is released,
+  // so that the watchdog either has reported it as blocked or doesn't report it.
+  const uint64_t threshold = get_threshold(pFrame->Kind, pFrame->State);
+  const bool slow = (threshold != 0) && (duration > threshold) && (reported != active)
+                    && HSM_ATOMIC_CAS(&pFrame->Reported, &reported, active);
+  HSM_ATOMIC_STORE(&pFrame->Active, (uint64_t)0);
+
+  if(slow)
+  {
+    watchdog_violation_t violation;
+    violation.Machine = pFrame->Machine;
+    violation.State = pFrame->State;
+    violation.Duration = duration;
+    violation.Event = pFrame->Event;
+    violation.Kind = (uint8_t)pFrame->Kind;
+    violation.Blocked = 0;
+    report_violation(&violation);
+  }
+}
+
+/** \brief Report the calls of all the watched threads running longer than their threshold.
+ *  Each call is reported once. It is called periodically by the watchdog thread,
+ *  or call it from a periodic timer on the systems without threads.
+ *
+ * \return uint32_t   number of reported calls
+ *
+ */
+uint32_t check_watchdog(void)
+{
+  const uint64_t now = HSM_TIMESTAMP();
+  const uint32_t slots = HSM_ATOMIC_LOAD(&Watchdog_Slot_Count);
+  uint32_t reported = 0;
+
+  for(uint32_t slot = 0; slot < slots; slot++)
+  {
+    for(uint32_t depth = 0; depth < HSM_WATCHDOG_MAX_DEPTH; depth++)
+    {
+      reported += check_frame(&Watchdog_Slots[slot].Frames[depth], now) ? 1 : 0;
+    }
+  }
+  return reported;
+}
+
+/** \brief Start the watchdog thread, it checks the watched calls periodically.
+ *
+ * \param period uint32_t   check period in milliseconds
+ * \return bool             false if the thread is already running, not available or could not be created
+ *
+ */
+bool start_watchdog_thread(uint32_t period)
+{
+#if HSM_WATCHDOG_THREAD
+  uint32_t stopped = 0;
+  if((period == 0) || (HSM_ATOMIC_CAS(&Watchdog_Period, &stopped, period) == 0))
+  {
+    return false;
+  }
+
+  if(pthread_create(&Watchdog_Thread, NULL, watchdog_thread, NULL) != 0)
+  {
+    HSM_ATOMIC_STORE(&Watchdog_Period, 0u);
+    return false;
+  }
+  return true;
+#else
+  (void)period;
+  return false;
+#endif // HSM_WATCHDOG_THREAD
+}
+
+//! Stop the watchdog thread and wait for it to exit.
+void stop_watchdog_thread(void)
+{
+#if HSM_WATCHDOG_THREAD
+  if(HSM_ATOMIC_EXCHANGE(&Watchdog_Period, 0u) != 0)
+  {
+    pthread_join(Watchdog_Thread, NULL);
+  }
+#endif // HSM_WATCHDOG_THREAD
+}
+
+/** \brief Copy the recent violations, oldest first. It is safe to call while the violations are reported.
+ *  The violations being written or overwritten during the copy are skipped.
+ *
+ * \param pViolations watchdog_violation_t* const   buffer to store the violations
+ * \param count uint32_t                            capacity of the buffer
+ * \return uint32_t                                 number of copied violations
+ *
+ */
+uint32_t read_watchdog_violations(watchdog_violation_t* const pViolations, uint32_t count)
+{
+  const uint64_t total = HSM_ATOMIC_LOAD(&Violation_Count);
+  uint32_t available = (total < HSM_WATCHDOG_VIOLATIONS) ? (uint32_t)total : HSM_WATCHDOG_VIOLATIONS;
+  if(available > count)
+  {
+    available = count;  // Keep the newest violations
+  }
+
+  const uint64_t first = total - available;
+  uint32_t copied = 0;
+  for(uint64_t index = first; index < total; index++)
+  {
+    violation_slot_t* const pSlot = &Violations[index & (HSM_WATCHDOG_VIOLATIONS - 1)];
+    if(HSM_ATOMIC_LOAD(&pSlot->Sequence) != index + 1)
+    {
+      continue;   // Not yet written or already overwritten
+    }
+
+    watchdog_violation_t* const pViolation = &pViolations[copied];
+    pViolation->Machine = HSM_ATOMIC_LOAD(&pSlot->Violation.Machine);
+    pViolation->State = HSM_ATOMIC_LOAD(&pSlot->Violation.State);
+    pViolation->Duration = HSM_ATOMIC_LOAD(&pSlot->Violation.Duration);
+    pViolation->Event = HSM_ATOMIC_LOAD(&pSlot->Violation.Event);
+    pViolation->Kind = HSM_ATOMIC_LOAD(&pSlot->Violation.Kind);
+    pViolation->Blocked = HSM_ATOMIC_LOAD(&pSlot->Violation.Blocked);
+
+    // Discard the fields, if the violation was overwritten while they were read.
+    if(HSM_ATOMIC_LOAD(&pSlot->Sequence) == index + 1)
+    {
+      copied++;
+    }
+  }
+  return copied;
+}
+
+/** \brief Get the number of violations since the start.
+ *
+ * \return uint64_t   number of violations
+ *
+ */
+uint64_t get_watchdog_violation_count(void)
+{
+  return HSM_ATOMIC_LOAD(&Violation_Count);
+}
+
+#endif // HSM_WATCHDOG
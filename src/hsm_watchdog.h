@@ -0,0 +1,112 @@
+/**
+ * \file
+ * \brief Watchdog of slow and blocked state handlers
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_WATCHDOG_H
+#define HSM_WATCHDOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hsm.h"
+
+#if HSM_WATCHDOG
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#if (HSM_WATCHDOG_VIOLATIONS & (HSM_WATCHDOG_VIOLATIONS - 1)) != 0
+#error "HSM_WATCHDOG_VIOLATIONS must be power of 2"
+#endif
+
+// Instrumentation points used by the framework, around each call of handler, entry and exit action.
+
+#define WATCHDOG_START(kind, pState_Machine, pState)        \
+        start_watchdog_call(kind, pState_Machine, pState)
+
+#define WATCHDOG_STOP()                                     \
+        stop_watchdog_call()
+
+/*
+ *  --------------------- ENUMERATION ---------------------
+ */
+
+//! Watched calls of the framework
+typedef enum
+{
+  WATCHDOG_HANDLER,     //!< State handler
+  WATCHDOG_ENTRY,       //!< Entry action
+  WATCHDOG_EXIT,        //!< Exit action
+  TOTAL_WATCHDOG_KINDS,
+}watchdog_kind_t;
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Call that has exceeded its threshold
+typedef struct
+{
+  const state_machine_t* Machine;   //!< State machine
+  const state_t* State;             //!< State whose handler or action is called
+  uint64_t Duration;                //!< Duration of the call in ticks of HSM_TIMESTAMP(), till detection if Blocked
+  uint32_t Event;                   //!< Event of state machine at the call
+  uint8_t Kind;                     //!< watchdog_kind_t
+  uint8_t Blocked;                  //!< 1 if the watchdog detected the call before it returned
+}watchdog_violation_t;
+
+/** \brief Called for each violation. Slow calls are reported by the dispatching thread after the call returns,
+ *  blocked calls by the thread calling check_watchdog.
+ *
+ * \param pViolation const watchdog_violation_t* const   violation record
+ *
+ */
+typedef void (*watchdog_handler_t)(const watchdog_violation_t* const pViolation);
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+extern void set_watchdog_threshold(watchdog_kind_t kind, uint64_t threshold);
+
+extern bool set_state_watchdog_threshold(uint32_t state, uint64_t threshold);
+
+extern void set_watchdog_handler(watchdog_handler_t handler);
+
+extern void start_watchdog_call(watchdog_kind_t kind, const state_machine_t* const pState_Machine,
+                                const state_t* const pState);
+
+extern void stop_watchdog_call(void);
+
+extern uint32_t check_watchdog(void);
+
+extern bool start_watchdog_thread(uint32_t period);
+
+extern void stop_watchdog_thread(void);
+
+extern uint32_t read_watchdog_violations(watchdog_violation_t* const pViolations, uint32_t count);
+
+extern uint64_t get_watchdog_violation_count(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // HSM_WATCHDOG
+
+#endif // HSM_WATCHDOG_H
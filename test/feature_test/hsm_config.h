@@ -0,0 +1,67 @@
+/**
+ * \file
+ * \brief Framework configuration of feature unit test
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_CONFIG_H
+#define HSM_CONFIG_H
+
+#include <stdint.h>
+
+// All the optional features of framework are enabled.
+
+#define HIERARCHICAL_STATES             1
+#define STATE_MACHINE_LOGGER            1
+#define HSM_USE_VARIABLE_LENGTH_ARRAY   1
+#define HSM_EVENT_OBJECTS               1
+#define HSM_ASYNC_COMPLETION            1
+#define HSM_TRACE_BUFFER                1
+#define HSM_TRACE_BUFFER_SIZE           64
+#define HSM_TRACE_MAX_THREADS           8
+#define HSM_LATENCY_HISTOGRAM           1
+#define HSM_QUEUE_METRICS               1
+#define HSM_RUNTIME_COUNTERS            1
+#define HSM_FLIGHT_RECORDER             1
+#define HSM_FLIGHT_RECORDER_SIZE        16
+#define HSM_STATE_COVERAGE              1
+#define HSM_SAMPLING_PROFILER           1
+#define HSM_WATCHDOG                    1
+#define HSM_STATE_RESIDENCY             1
+
+// Trace hooks implemented by trace_hook_test.cpp
+// and the cycle counter defined by latency_histogram_test.cpp
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+extern uint64_t test_cycle_counter(void);
+
+extern void trace_bubble_hook(const void* pState_Machine, const void* pState, const void* pParent);
+extern void trace_transition_hook(const void* pState_Machine, const void* pSource, const void* pTarget);
+extern void trace_exit_hook(const void* pState_Machine, const void* pState);
+extern void trace_entry_hook(const void* pState_Machine, const void* pState);
+extern void trace_post_hook(const void* pState_Machine, const void* pEvent);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#define HSM_TRACE_BUBBLE(index, pState_Machine, pState, pParent)  trace_bubble_hook(pState_Machine, pState, pParent)
+#define HSM_TRACE_TRANSITION(pState_Machine, pSource, pTarget)    trace_transition_hook(pState_Machine, pSource, pTarget)
+#define HSM_TRACE_EXIT(pState_Machine, pState)                    trace_exit_hook(pState_Machine, pState)
+#define HSM_TRACE_ENTRY(pState_Machine, pState)                   trace_entry_hook(pState_Machine, pState)
+#define HSM_TRACE_POST(pState_Machine, pEvent)                    trace_post_hook(pState_Machine, pEvent)
+
+#define HSM_CYCLE_COUNTER()   test_cycle_counter()
+
+#endif // HSM_CONFIG_H
@@ -0,0 +1,239 @@
+/**
+ * \file
+ * \brief Asynchronous completion of event test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <thread>
+
+#include "catch.hpp"
+#include "hsm.h"
+#define _HIPPOMOCKS__ENABLE_CFUNC_MOCKING_SUPPORT
+#include "hippomocks.h"
+
+namespace async_completion_test
+{
+
+state_machine_result_t io_handler(state_machine_t * const)
+{
+  return EVENT_HANDLED;
+}
+
+state_machine_result_t handler(state_machine_t * const)
+{
+  return EVENT_HANDLED;
+}
+
+const state_t ioHSM[1] =
+{
+  {
+    io_handler,
+    NULL,
+    NULL,
+    0,
+    NULL,
+    NULL,
+    0
+  }
+};
+
+const state_t testHSM[1] =
+{
+  {
+    handler,
+    NULL,
+    NULL,
+    0,
+    NULL,
+    NULL,
+    0
+  }
+};
+
+SCENARIO("Handler completes the event asynchronously")
+{
+  GIVEN("A state machine doing I/O and a lower priority state machine")
+  {
+    state_machine_t ioMachine = {};
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&ioMachine, &machine};
+
+    ioMachine.State = ioHSM;
+    ioMachine.Event = 1;
+    machine.State = testHSM;
+    machine.Event = 2;
+
+    MockRepository mocks;
+    mocks.ExpectCallFunc(io_handler).With(&ioMachine).Return(EVENT_PENDING);
+    mocks.ExpectCallFunc(handler).With(&machine).Return(EVENT_HANDLED);
+
+    REQUIRE(dispatch_event(machineList, 2) == EVENT_PENDING);
+
+    THEN("Parked state machine keeps its event and others are dispatched")
+    {
+      REQUIRE(ioMachine.Event == 1);
+      REQUIRE(machine.Event == 0);
+      REQUIRE(dispatch_event(machineList, 2) == EVENT_PENDING);
+    }
+
+    WHEN("I/O completes the event from other thread")
+    {
+      std::thread io([&ioMachine]() { complete_event(&ioMachine, EVENT_HANDLED); });
+      io.join();
+
+      THEN("Dispatcher clears the event without calling the handler again")
+      {
+        REQUIRE(dispatch_event(machineList, 2) == EVENT_HANDLED);
+        REQUIRE(ioMachine.Event == 0);
+      }
+    }
+
+    WHEN("I/O completes with trigger to self")
+    {
+      complete_event(&ioMachine, TRIGGERED_TO_SELF);
+      mocks.ExpectCallFunc(io_handler).With(&ioMachine).Do(
+        [](state_machine_t * const pMachine)
+        {
+          REQUIRE(pMachine->Event == 1);
+          return EVENT_HANDLED;
+        });
+
+      THEN("Handler receives the event again")
+      {
+        REQUIRE(dispatch_event(machineList, 2) == EVENT_HANDLED);
+        REQUIRE(ioMachine.Event == 0);
+      }
+    }
+
+    WHEN("I/O completion fails")
+    {
+      complete_event(&ioMachine, EVENT_UN_HANDLED);
+
+      THEN("Dispatcher terminates with error")
+      {
+        REQUIRE(dispatch_event(machineList, 2) == EVENT_UN_HANDLED);
+      }
+    }
+  }
+
+  GIVEN("An I/O that completes before the handler returns")
+  {
+    state_machine_t ioMachine = {};
+    state_machine_t * const machineList[] = {&ioMachine};
+    ioMachine.State = ioHSM;
+    ioMachine.Event = 1;
+
+    MockRepository mocks;
+    mocks.ExpectCallFunc(io_handler).With(&ioMachine).Do(
+      [](state_machine_t * const pMachine)
+      {
+        complete_event(pMachine, EVENT_HANDLED);
+        return EVENT_PENDING;
+      });
+
+    THEN("Event is completed in the same dispatch")
+    {
+      REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+      REQUIRE(ioMachine.Event == 0);
+    }
+  }
+}
+
+static uint32_t Parent_Calls;
+static state_machine_result_t Parent_Result;
+
+state_machine_result_t parent_handler(state_machine_t * const)
+{
+  Parent_Calls++;
+  return Parent_Result;
+}
+
+state_machine_result_t pending_handler(state_machine_t * const)
+{
+  return EVENT_PENDING;
+}
+
+state_machine_result_t pending_action(state_machine_t * const)
+{
+  return EVENT_PENDING;
+}
+
+extern const state_t Parent_State[1];
+extern const state_t Child_States[2];
+
+const state_t Parent_State[1] =
+{
+  {parent_handler, NULL, NULL, 0, NULL, Child_States, 0},
+};
+
+const state_t Child_States[2] =
+{
+  {pending_handler, NULL, NULL, 0, &Parent_State[0], NULL, 1},
+  {pending_handler, pending_action, NULL, 0, &Parent_State[0], NULL, 1},
+};
+
+SCENARIO("Asynchronous result is handled as the result of handler")
+{
+  GIVEN("A child state that completes the event asynchronously")
+  {
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    machine.State = &Child_States[0];
+    machine.Event = 1;
+    Parent_Calls = 0;
+
+    REQUIRE(dispatch_event(machineList, 1) == EVENT_PENDING);
+    REQUIRE(Parent_Calls == 0);
+
+    WHEN("Event is not handled by the child state and the parent state handles it")
+    {
+      Parent_Result = EVENT_HANDLED;
+      complete_event(&machine, EVENT_UN_HANDLED);
+
+      THEN("Event bubbles to the parent state")
+      {
+        REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+        REQUIRE(Parent_Calls == 1);
+        REQUIRE(machine.Event == 0);
+        REQUIRE(machine.Counters.Bubbles == 1);
+        REQUIRE(machine.Counters.Unhandled == 0);
+      }
+    }
+
+    WHEN("Event is not handled by any state")
+    {
+      Parent_Result = EVENT_UN_HANDLED;
+      complete_event(&machine, EVENT_UN_HANDLED);
+
+      THEN("Dispatcher counts the unhandled event and terminates with error")
+      {
+        REQUIRE(dispatch_event(machineList, 1) == EVENT_UN_HANDLED);
+        REQUIRE(Parent_Calls == 1);
+        REQUIRE(machine.Counters.Unhandled == 1);
+      }
+    }
+  }
+
+  GIVEN("An entry action that returns EVENT_PENDING")
+  {
+    state_machine_t machine = {};
+    machine.State = &Child_States[0];
+
+    THEN("Transition stops with error")
+    {
+      REQUIRE(switch_state(&machine, &Child_States[1]) == EVENT_UN_HANDLED);
+      REQUIRE(traverse_state(&machine, &Child_States[1]) == EVENT_UN_HANDLED);
+      REQUIRE(machine.Completion == 0);
+    }
+  }
+}
+
+}
@@ -0,0 +1,328 @@
+/**
+ * \file
+ * \brief Coroutine state handler test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_coroutine.hpp"
+
+//! Count the heap allocations to verify that coroutine frames use the arena.
+static unsigned long Heap_Allocations = 0;
+
+void* operator new(std::size_t size)
+{
+  Heap_Allocations++;
+  void* const pMemory = std::malloc(size ? size : 1);
+  if(pMemory == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return pMemory;
+}
+
+void operator delete(void* pMemory) noexcept
+{
+  std::free(pMemory);
+}
+
+void operator delete(void* pMemory, std::size_t) noexcept
+{
+  std::free(pMemory);
+}
+
+namespace coroutine_test
+{
+
+typedef enum
+{
+  EN_START = 1,
+  EN_DOOR_OPEN,
+  EN_DOOR_CLOSE,
+  EN_TICK,
+  EN_TIMEOUT,
+  EN_STOP,
+  EN_UNKNOWN,
+}en_event;
+
+typedef enum
+{
+  ROOT_STATE,
+  IDLE_STATE,
+  COOKING_STATE,
+}en_state;
+
+template<std::size_t ArenaSize>
+struct oven : hsm::coroutine_machine<ArenaSize>
+{
+  uint32_t Ticks = 0;
+  uint32_t Pauses = 0;
+  uint32_t Root_Events = 0;
+};
+
+typedef oven<512> oven_t;
+
+extern const state_t Oven_States[];
+
+state_machine_result_t root_handler(state_machine_t* const pState)
+{
+  if(pState->Event == EN_STOP)
+  {
+    return switch_state(pState, &Oven_States[IDLE_STATE]);
+  }
+  reinterpret_cast<oven_t*>(pState)->Root_Events++;
+  return EVENT_HANDLED;
+}
+
+state_machine_result_t idle_handler(state_machine_t* const pState)
+{
+  if(pState->Event == EN_START)
+  {
+    return switch_state(pState, &Oven_States[COOKING_STATE]);
+  }
+  return EVENT_UN_HANDLED;
+}
+
+// Multi-step protocol of cooking state, written without splitting the state.
+hsm::state_task cooking(oven_t& oven)
+{
+  state_machine_result_t result = EVENT_HANDLED;
+  uint32_t event = oven.Machine.Event;
+
+  while(1)
+  {
+    switch(event)
+    {
+    case EN_TICK:
+      oven.Ticks++;
+      result = EVENT_HANDLED;
+      break;
+
+    case EN_DOOR_OPEN:
+      // Wait for the door to close, ticks are ignored while the door is open.
+      oven.Pauses++;
+      result = EVENT_HANDLED;
+      do
+      {
+        event = co_await hsm::next_event(result);
+        result = ((event == EN_TICK) || (event == EN_DOOR_CLOSE)) ? EVENT_HANDLED : EVENT_UN_HANDLED;
+      }while(event != EN_DOOR_CLOSE);
+      break;
+
+    case EN_TIMEOUT:
+      co_return switch_state(&oven.Machine, &Oven_States[IDLE_STATE]);
+
+    default:
+      result = EVENT_UN_HANDLED;    // Let the parent state handle it.
+      break;
+    }
+    event = co_await hsm::next_event(result);
+  }
+}
+
+const state_t Oven_States[] =
+{
+  {root_handler, NULL, NULL, NULL, &Oven_States[IDLE_STATE], 0},
+  {idle_handler, NULL, NULL, &Oven_States[ROOT_STATE], NULL, 1},
+  {hsm::coroutine_state<oven_t, cooking>, NULL, hsm::coroutine_exit<oven_t, cooking>, &Oven_States[ROOT_STATE], NULL, 1},
+};
+
+typedef oven<16> small_oven_t;
+
+hsm::state_task small_cooking(small_oven_t&)
+{
+  co_await hsm::next_event();
+  co_return EVENT_HANDLED;
+}
+
+const state_t Small_Oven_State =
+{
+  hsm::coroutine_state<small_oven_t, small_cooking>, NULL, NULL, NULL, NULL, 0
+};
+
+template<typename Machine>
+state_machine_result_t dispatch(Machine& oven, uint32_t event)
+{
+  state_machine_t * const machineList[] = {&oven.Machine};
+  oven.Machine.Event = event;
+  return dispatch_event(machineList, 1);
+}
+
+SCENARIO("Coroutine state handler awaits events")
+{
+  GIVEN("An oven with coroutine handler in cooking state")
+  {
+    oven_t oven;
+    oven.Machine.State = &Oven_States[IDLE_STATE];
+    REQUIRE(dispatch(oven, EN_START) == EVENT_HANDLED);
+    REQUIRE(oven.Machine.State == &Oven_States[COOKING_STATE]);
+
+    WHEN("events are dispatched to cooking state")
+    {
+      const uint32_t events[] = {EN_TICK, EN_DOOR_OPEN, EN_TICK, EN_DOOR_CLOSE, EN_TICK, EN_UNKNOWN};
+      state_machine_result_t results[6];
+
+      // Catch assertions allocate memory, check the results after the dispatch.
+      const unsigned long allocations = Heap_Allocations;
+      for(uint32_t index = 0; index < 6; index++)
+      {
+        results[index] = dispatch(oven, events[index]);
+      }
+      const unsigned long dispatch_allocations = Heap_Allocations - allocations;
+
+      THEN("Coroutine keeps its progress across the events without heap allocation")
+      {
+        REQUIRE(dispatch_allocations == 0);
+        for(state_machine_result_t result : results)
+        {
+          REQUIRE(result == EVENT_HANDLED);
+        }
+        REQUIRE(oven.Ticks == 2);
+        REQUIRE(oven.Pauses == 1);
+        REQUIRE(oven.Root_Events == 1);
+        REQUIRE(oven.Machine.Event == 0);
+        REQUIRE(oven.suspended(hsm::coroutine_state<oven_t, cooking>));
+      }
+    }
+
+    WHEN("coroutine returns the state transition")
+    {
+      REQUIRE(dispatch(oven, EN_TICK) == EVENT_HANDLED);
+      REQUIRE(dispatch(oven, EN_TIMEOUT) == EVENT_HANDLED);
+
+      THEN("State machine leaves the state and coroutine frame is released")
+      {
+        REQUIRE(oven.Machine.State == &Oven_States[IDLE_STATE]);
+        REQUIRE_FALSE(oven.suspended(hsm::coroutine_state<oven_t, cooking>));
+
+        REQUIRE(dispatch(oven, EN_START) == EVENT_HANDLED);
+        REQUIRE(dispatch(oven, EN_TICK) == EVENT_HANDLED);
+        REQUIRE(oven.Ticks == 2);
+      }
+    }
+  }
+
+  GIVEN("An oven waiting in cooking state for the door to close")
+  {
+    oven_t oven;
+    oven.Machine.State = &Oven_States[IDLE_STATE];
+    REQUIRE(dispatch(oven, EN_START) == EVENT_HANDLED);
+    REQUIRE(dispatch(oven, EN_DOOR_OPEN) == EVENT_HANDLED);
+
+    WHEN("the parent state leaves cooking state on the event passed by the coroutine")
+    {
+      REQUIRE(dispatch(oven, EN_STOP) == EVENT_HANDLED);
+
+      THEN("Coroutine is discarded on exit and starts again on the next entry")
+      {
+        REQUIRE(oven.Machine.State == &Oven_States[IDLE_STATE]);
+        REQUIRE_FALSE(oven.suspended(hsm::coroutine_state<oven_t, cooking>));
+
+        REQUIRE(dispatch(oven, EN_START) == EVENT_HANDLED);
+        REQUIRE(dispatch(oven, EN_TICK) == EVENT_HANDLED);
+        REQUIRE(oven.Ticks == 1);     // Tick is not ignored as by the discarded coroutine.
+        REQUIRE(oven.Pauses == 1);
+      }
+    }
+  }
+
+  GIVEN("A state machine with too small arena")
+  {
+    small_oven_t oven;
+    oven.Machine.State = &Small_Oven_State;
+
+    THEN("Coroutine handler cannot start and the event is not handled")
+    {
+      REQUIRE(dispatch(oven, EN_TICK) == EVENT_UN_HANDLED);
+    }
+  }
+}
+
+// Coroutine states in the parent and the child state, each with its own frame.
+struct lab_t : hsm::coroutine_machine<256, 2>
+{
+  uint32_t Child_Count = 0;     //!< Events counted by the child coroutine
+  uint32_t Parent_Count = 0;    //!< Events counted by the parent coroutine
+  uint32_t Parent_Starts = 0;
+};
+
+extern const state_t Lab_States[];
+
+hsm::state_task parent_task(lab_t& lab)
+{
+  lab.Parent_Starts++;
+  uint32_t count = 0;
+  while(1)
+  {
+    lab.Parent_Count = ++count;
+    co_await hsm::next_event();
+  }
+}
+
+hsm::state_task child_task(lab_t& lab)
+{
+  uint32_t count = 0;
+  uint32_t event = lab.Machine.Event;
+  while(1)
+  {
+    state_machine_result_t result = EVENT_UN_HANDLED;     // Parent state handles the unknown events.
+    if(event == EN_TICK)
+    {
+      lab.Child_Count = ++count;
+      result = EVENT_HANDLED;
+    }
+    event = co_await hsm::next_event(result);
+  }
+}
+
+const state_t Lab_States[] =
+{
+  {hsm::coroutine_state<lab_t, parent_task>, NULL, NULL, NULL, &Lab_States[1], 0},
+  {hsm::coroutine_state<lab_t, child_task>, NULL, hsm::coroutine_exit<lab_t, child_task>, &Lab_States[0], NULL, 1},
+};
+
+SCENARIO("Coroutine state passes the event to a coroutine parent state")
+{
+  GIVEN("Coroutine states in the parent and child state")
+  {
+    lab_t lab;
+    lab.Machine.State = &Lab_States[1];
+
+    const uint32_t events[] = {EN_TICK, EN_UNKNOWN, EN_TICK, EN_UNKNOWN, EN_TICK};
+    state_machine_result_t results[5];
+    const unsigned long allocations = Heap_Allocations;
+    for(uint32_t index = 0; index < 5; index++)
+    {
+      results[index] = dispatch(lab, events[index]);
+    }
+    const unsigned long dispatch_allocations = Heap_Allocations - allocations;
+
+    THEN("Both coroutines keep their progress")
+    {
+      REQUIRE(dispatch_allocations == 0);
+      for(state_machine_result_t result : results)
+      {
+        REQUIRE(result == EVENT_HANDLED);
+      }
+      REQUIRE(lab.Child_Count == 3);
+      REQUIRE(lab.Parent_Count == 2);
+      REQUIRE(lab.Parent_Starts == 1);
+      REQUIRE(lab.suspended(hsm::coroutine_state<lab_t, child_task>));
+      REQUIRE(lab.suspended(hsm::coroutine_state<lab_t, parent_task>));
+    }
+  }
+}
+
+}
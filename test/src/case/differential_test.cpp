@@ -0,0 +1,479 @@
+/**
+ * \file
+ * \brief Differential test of the dispatch engines against the reference engine
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// Each seed generates a small random state machine and a random event sequence, then runs them through
+// every engine from the same start. The handlers, entry and exit actions log each call with the state
+// it belongs to, so the log of an engine is its sequence of handler calls. The logs, the results of
+// dispatch_event and the final states must be the same for all the engines.
+//
+// The handlers use the engine under test for their transitions. Their behaviour comes from the generator
+// and from per state choices: an action is absent, handles, triggers a new event to self or fails.
+// A new dispatch engine or transition fast path is tested by adding it to Engines.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_reference.h"
+#include "state_generator.h"
+
+namespace differential_test
+{
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define MAX_STATES          256u      //!< Size of the tables of state actions
+#define SEEDS               400u
+#define MACHINES            4u
+#define STEPS               200u      //!< Dispatches of each seed
+#define TRIGGER_BUDGET      3u        //!< Events triggered to self by a state machine in a dispatch
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Dispatch engine under test
+typedef struct
+{
+  const char* Name;
+  state_machine_result_t (*Dispatch)(state_machine_t* const pState_Machine[], uint32_t quantity);
+  state_machine_result_t (*Switch)(state_machine_t* const pState_Machine, const state_t* const pTarget_State);
+#if HIERARCHICAL_STATES
+  state_machine_result_t (*Traverse)(state_machine_t* const pState_Machine, const state_t* const pTarget_State);
+#endif // HIERARCHICAL_STATES
+}engine_t;
+
+//! Behaviour of an entry or exit action
+typedef enum
+{
+  EFFECT_NONE,
+  EFFECT_HANDLED,         //!< Returns EVENT_HANDLED
+  EFFECT_TRIGGER,         //!< Triggers a new event to self while the budget lasts
+  EFFECT_FAIL,            //!< Returns EVENT_UN_HANDLED
+}effect_t;
+
+typedef enum
+{
+  CALL_HANDLER,
+  CALL_ENTRY,
+  CALL_EXIT,
+  CALL_DISPATCH,          //!< Result of dispatch_event, Value is the result
+}call_kind_t;
+
+//! Entry of the log of an engine
+typedef struct
+{
+  call_kind_t Kind;
+  uint32_t Machine;
+  uint32_t State;           //!< State the handler or action belongs to
+  uint32_t Current;         //!< Current state of the state machine at the call
+  uint32_t Value;           //!< Event at the call, result of dispatch_event
+}call_t;
+
+//! Handler, entry and exit action of a state
+typedef struct
+{
+  state_handler Handler;
+  state_handler Entry;
+  state_handler Exit;
+}state_actions_t;
+
+//! Generated state machine rebuilt with the logging actions
+typedef struct
+{
+  generated_hsm_t Hsm;
+  state_tree_t Tree;
+  std::vector<effect_t> Entry;
+  std::vector<effect_t> Exit;
+}scenario_t;
+
+typedef struct
+{
+  state_machine_t Machine;
+  uint32_t Index;
+  uint32_t Budget;          //!< Events it can still trigger to self in this dispatch
+  uint64_t Seed;            //!< Random choices of its handlers
+}machine_t;
+
+//! Outcome of a scenario on an engine
+typedef struct
+{
+  std::vector<call_t> Log;
+  std::vector<uint32_t> States;
+  std::vector<uint32_t> Events;
+}outcome_t;
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+const engine_t Engines[] =
+{
+#if HIERARCHICAL_STATES
+  {"reference", reference_dispatch_event, reference_switch_state, reference_traverse_state},
+  {"hsm.c", dispatch_event, switch_state, traverse_state},
+#else
+  {"reference", reference_dispatch_event, reference_switch_state},
+  {"hsm.c", dispatch_event, switch_state},
+#endif // HIERARCHICAL_STATES
+};
+
+const engine_t* Engine;               //!< Engine under test
+const scenario_t* Scenario;
+outcome_t* Outcome;
+
+state_actions_t Actions[MAX_STATES];
+
+/*
+ *  --------------------- STATE ACTIONS ---------------------
+ */
+
+machine_t* get_machine(state_machine_t* const pState_Machine)
+{
+  return reinterpret_cast<machine_t*>(pState_Machine);
+}
+
+uint32_t get_index(const state_t* const pState)
+{
+  return (uint32_t)(pState - Scenario->Tree.States);
+}
+
+void log_call(call_kind_t kind, state_machine_t* const pState_Machine, uint32_t state)
+{
+  Outcome->Log.push_back(call_t{kind, get_machine(pState_Machine)->Index, state,
+                                get_index(pState_Machine->State), pState_Machine->Event});
+}
+
+//! Trigger a new event to self, if the budget of state machine lasts.
+bool trigger_event(state_machine_t* const pState_Machine)
+{
+  machine_t* const pMachine = get_machine(pState_Machine);
+  if(pMachine->Budget == 0)
+  {
+    return false;
+  }
+  pMachine->Budget--;
+  pState_Machine->Event = random_below(&pMachine->Seed, Scenario->Hsm.Events) + 1;
+  return true;
+}
+
+state_machine_result_t on_handler(state_machine_t* const pState_Machine, uint32_t state)
+{
+  log_call(CALL_HANDLER, pState_Machine, state);
+
+  const generated_hsm_t* const pHsm = &Scenario->Hsm;
+  if((get_generated_action(&pHsm->Tree.States[state]) == ACTION_PASS) || (pState_Machine->Event > pHsm->Events))
+  {
+    return EVENT_UN_HANDLED;      // The unknown event passes up to the top state and terminates the dispatcher.
+  }
+
+  const uint32_t target = pHsm->Targets[get_index(pState_Machine->State) * pHsm->Events + pState_Machine->Event - 1];
+  if(target != GENERATED_NO_TARGET)
+  {
+#if HIERARCHICAL_STATES
+    return Engine->Traverse(pState_Machine, &Scenario->Tree.States[target]);
+#else
+    return Engine->Switch(pState_Machine, &Scenario->Tree.States[target]);
+#endif // HIERARCHICAL_STATES
+  }
+
+  machine_t* const pMachine = get_machine(pState_Machine);
+  if((random_below(&pMachine->Seed, 4) == 0) && trigger_event(pState_Machine))
+  {
+    return TRIGGERED_TO_SELF;
+  }
+  return EVENT_HANDLED;
+}
+
+state_machine_result_t on_action(state_machine_t* const pState_Machine, uint32_t state, call_kind_t kind,
+                                 effect_t effect)
+{
+  log_call(kind, pState_Machine, state);
+
+  switch(effect)
+  {
+  case EFFECT_TRIGGER:
+    return trigger_event(pState_Machine) ? TRIGGERED_TO_SELF : EVENT_HANDLED;
+
+  case EFFECT_FAIL:
+    return EVENT_UN_HANDLED;
+
+  default:
+    return EVENT_HANDLED;
+  }
+}
+
+template<uint32_t STATE>
+state_machine_result_t state_handler_of(state_machine_t* const pState_Machine)
+{
+  return on_handler(pState_Machine, STATE);
+}
+
+template<uint32_t STATE>
+state_machine_result_t entry_action_of(state_machine_t* const pState_Machine)
+{
+  return on_action(pState_Machine, STATE, CALL_ENTRY, Scenario->Entry[STATE]);
+}
+
+template<uint32_t STATE>
+state_machine_result_t exit_action_of(state_machine_t* const pState_Machine)
+{
+  return on_action(pState_Machine, STATE, CALL_EXIT, Scenario->Exit[STATE]);
+}
+
+//! Fill the actions of the states from 0 to COUNT - 1.
+template<uint32_t COUNT>
+struct action_table
+{
+  static void fill(state_actions_t* const pActions)
+  {
+    action_table<COUNT - 1>::fill(pActions);
+    pActions[COUNT - 1] = state_actions_t{state_handler_of<COUNT - 1>, entry_action_of<COUNT - 1>,
+                                          exit_action_of<COUNT - 1>};
+  }
+};
+
+template<>
+struct action_table<0>
+{
+  static void fill(state_actions_t* const)
+  {
+  }
+};
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+effect_t choose_effect(uint64_t* const pSeed)
+{
+  const uint32_t choice = random_below(pSeed, 100);
+  return (choice < 25) ? EFFECT_NONE : (choice < 80) ? EFFECT_HANDLED
+         : (choice < 98) ? EFFECT_TRIGGER : EFFECT_FAIL;
+}
+
+//! Generate the state machine of the seed and rebuild its states with the logging actions.
+void build_scenario(scenario_t* const pScenario, uint64_t seed)
+{
+  generator_config_t config =
+  {
+    random_below(&seed, MAX_STATES) + 1,  // States
+    random_below(&seed, 8) + 1,           // Max_Depth
+    random_below(&seed, 8) + 1,           // Max_Fanout
+    random_below(&seed, 8) + 1,           // Events
+    random_below(&seed, 30),              // None_Percent
+    random_below(&seed, 40),              // Pass_Percent
+    random_below(&seed, 100),             // Transition_Percent
+    seed,
+  };
+  // Fewer states, till they fit in the depth and fan-out.
+  while(!generate_hsm(&pScenario->Hsm, &config))
+  {
+    config.States = (config.States + 1) / 2;
+  }
+
+  const generated_hsm_t* const pHsm = &pScenario->Hsm;
+  const uint32_t states = pHsm->Tree.Count;
+  init_state_tree(&pScenario->Tree, states);
+  state_t* const pStates = reserve_states(&pScenario->Tree, states);
+  pScenario->Entry.resize(states);
+  pScenario->Exit.resize(states);
+
+  for(uint32_t index = 0; index < states; index++)
+  {
+    const state_t* const pGenerated = &pHsm->Tree.States[index];
+    pScenario->Entry[index] = choose_effect(&seed);
+    pScenario->Exit[index] = choose_effect(&seed);
+    const state_actions_t* const pActions = &Actions[index];
+
+#if HIERARCHICAL_STATES
+    const state_t* const pParent = (pGenerated->Parent != NULL) ? &pStates[get_state_index(pHsm, pGenerated->Parent)]
+                                                                : NULL;
+    const state_t* const pNode = (pGenerated->Node != NULL) ? &pStates[get_state_index(pHsm, pGenerated->Node)] : NULL;
+    const uint32_t level = pGenerated->Level;
+#else
+    const state_t* const pParent = NULL;
+    const state_t* const pNode = NULL;
+    const uint32_t level = 0;
+#endif // HIERARCHICAL_STATES
+
+    construct_state(&pStates[index], (pGenerated->Handler != NULL) ? pActions->Handler : NULL,
+                    (pScenario->Entry[index] != EFFECT_NONE) ? pActions->Entry : NULL,
+                    (pScenario->Exit[index] != EFFECT_NONE) ? pActions->Exit : NULL,
+                    index, pParent, pNode, level);
+  }
+}
+
+void free_scenario(scenario_t* const pScenario)
+{
+  free_state_tree(&pScenario->Tree);
+  free_generated_hsm(&pScenario->Hsm);
+}
+
+//! Run the event sequence of the seed on an engine.
+void run_scenario(const engine_t* const pEngine, const scenario_t* const pScenario, uint64_t seed,
+                  outcome_t* const pOutcome)
+{
+  Engine = pEngine;
+  Scenario = pScenario;
+  Outcome = pOutcome;
+
+  machine_t machines[MACHINES];
+  state_machine_t* machineList[MACHINES];
+  for(uint32_t index = 0; index < MACHINES; index++)
+  {
+    machines[index] = machine_t();
+    machines[index].Machine.State = &pScenario->Tree.States[index % pScenario->Hsm.Top_States];
+    machines[index].Index = index;
+    machines[index].Seed = seed + index;
+    machineList[index] = &machines[index].Machine;
+  }
+
+  const uint32_t events = pScenario->Hsm.Events;
+  for(uint32_t step = 0; step < STEPS; step++)
+  {
+    for(machine_t& machine : machines)
+    {
+      machine.Budget = TRIGGER_BUDGET;
+      if((machine.Machine.Event == 0) && (random_below(&seed, 2) == 0))
+      {
+        // Few events are unknown to all the states.
+        machine.Machine.Event = (random_below(&seed, 50) == 0) ? events + 1 : random_below(&seed, events) + 1;
+      }
+    }
+
+    const state_machine_result_t result = pEngine->Dispatch(machineList, MACHINES);
+    pOutcome->Log.push_back(call_t{CALL_DISPATCH, 0, 0, 0, (uint32_t)result});
+    if(result != EVENT_HANDLED)
+    {
+      // Dispatcher is terminated, drop the pending events.
+      for(machine_t& machine : machines)
+      {
+        machine.Machine.Event = 0;
+      }
+    }
+  }
+
+  for(const machine_t& machine : machines)
+  {
+    pOutcome->States.push_back(get_index(machine.Machine.State));
+    pOutcome->Events.push_back(machine.Machine.Event);
+  }
+}
+
+std::string describe_call(const std::vector<call_t>& log, size_t position)
+{
+  if(position >= log.size())
+  {
+    return "end of log";
+  }
+
+  static const char* const Kind_Name[] = {"handler", "entry", "exit", "dispatch"};
+  const call_t& call = log[position];
+  char text[128];
+  if(call.Kind == CALL_DISPATCH)
+  {
+    snprintf(text, sizeof(text), "dispatch result %u", call.Value);
+  }
+  else
+  {
+    snprintf(text, sizeof(text), "%s of state %u, machine %u in state %u with event %u", Kind_Name[call.Kind],
+             call.State, call.Machine, call.Current, call.Value);
+  }
+  return text;
+}
+
+bool is_same_call(const call_t& first, const call_t& second)
+{
+  return (first.Kind == second.Kind) && (first.Machine == second.Machine) && (first.State == second.State)
+         && (first.Current == second.Current) && (first.Value == second.Value);
+}
+
+//! Describe the first difference of the outcome from the reference outcome, empty if they are the same.
+std::string compare_outcome(const outcome_t& reference, const outcome_t& outcome)
+{
+  size_t position = 0;
+  while((position < reference.Log.size()) && (position < outcome.Log.size())
+        && is_same_call(reference.Log[position], outcome.Log[position]))
+  {
+    position++;
+  }
+
+  if((position < reference.Log.size()) || (position < outcome.Log.size()))
+  {
+    return "call " + std::to_string(position) + " is " + describe_call(outcome.Log, position)
+           + ", the reference " + describe_call(reference.Log, position);
+  }
+
+  for(uint32_t index = 0; index < MACHINES; index++)
+  {
+    if((outcome.States[index] != reference.States[index]) || (outcome.Events[index] != reference.Events[index]))
+    {
+      return "machine " + std::to_string(index) + " ends in state " + std::to_string(outcome.States[index])
+             + " with event " + std::to_string(outcome.Events[index]) + ", the reference in state "
+             + std::to_string(reference.States[index]) + " with event " + std::to_string(reference.Events[index]);
+    }
+  }
+  return std::string();
+}
+
+/*
+ *  --------------------- TEST CASES ---------------------
+ */
+
+TEST_CASE("Dispatch engines follow the reference engine", "[differential]")
+{
+  action_table<MAX_STATES>::fill(Actions);
+
+  uint64_t calls = 0;
+  uint64_t unhandled = 0;
+  for(uint64_t seed = 1; seed <= SEEDS; seed++)
+  {
+    scenario_t scenario;
+    build_scenario(&scenario, seed);
+
+    outcome_t reference;
+    run_scenario(&Engines[0], &scenario, seed, &reference);
+    calls += reference.Log.size();
+
+    for(const engine_t& engine : Engines)
+    {
+      outcome_t outcome;
+      run_scenario(&engine, &scenario, seed, &outcome);
+
+      const std::string difference = compare_outcome(reference, outcome);
+      if(!difference.empty())
+      {
+        FAIL("seed " << seed << ", " << scenario.Hsm.Tree.Count << " states, engine " << engine.Name << ": "
+             << difference);
+      }
+    }
+
+    for(const call_t& call : reference.Log)
+    {
+      unhandled += ((call.Kind == CALL_DISPATCH) && (call.Value != EVENT_HANDLED)) ? 1 : 0;
+    }
+    free_scenario(&scenario);
+  }
+
+  // The scenarios exercise the handlers and also the termination of the dispatcher.
+  REQUIRE(calls > SEEDS * STEPS);
+  REQUIRE(unhandled != 0);
+}
+
+}
@@ -0,0 +1,206 @@
+/**
+ * \file
+ * \brief Event object test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_event.hpp"
+
+namespace event_object_test
+{
+
+typedef enum
+{
+  EN_SET_TIME = 1,
+  EN_NEXT,
+}en_event;
+
+typedef struct
+{
+  event_t Header;
+  uint32_t Time;
+}set_time_event_t;
+
+typedef struct
+{
+  state_machine_t Machine;
+  std::vector<uint32_t> Times;
+  uint32_t Trigger_Count;
+}timer_machine_t;
+
+state_machine_result_t set_time_handler(state_machine_t * const pState)
+{
+  timer_machine_t* const pMachine = reinterpret_cast<timer_machine_t*>(pState);
+  const set_time_event_t* const pEvent = hsm::event_cast<set_time_event_t>(pState);
+
+  REQUIRE(pEvent != NULL);
+  pMachine->Times.push_back(pEvent->Time);
+
+  if((pState->Event == EN_SET_TIME) && (pMachine->Trigger_Count != 0))
+  {
+    pMachine->Trigger_Count--;
+    pState->Event = EN_NEXT;
+    return TRIGGERED_TO_SELF;
+  }
+  return EVENT_HANDLED;
+}
+
+const state_t timerHSM[1] =
+{
+  {
+    set_time_handler,
+    NULL,
+    NULL,
+    0,
+    NULL,
+    NULL,
+    0
+  }
+};
+
+SCENARIO("Event objects carry payload to the state machine")
+{
+  GIVEN("A state machine and a pool of event objects")
+  {
+    hsm::event_pool<set_time_event_t, 4> pool;
+    timer_machine_t machine = {};
+    machine.Machine.State = timerHSM;
+    state_machine_t * const machineList[] = {&machine.Machine};
+
+    WHEN("events are posted to state machine")
+    {
+      for(uint32_t time = 10; time < 14; time++)
+      {
+        hsm::event_ptr<set_time_event_t> event = pool.make(EN_SET_TIME, time);
+        REQUIRE(event);
+        hsm::post(&machine.Machine, std::move(event));
+        REQUIRE_FALSE(event);
+      }
+
+      THEN("Pool is exhausted till the events are handled")
+      {
+        REQUIRE_FALSE(pool.make(EN_SET_TIME, 1u));
+      }
+
+      THEN("Handler receives payloads in posting order and pool gets back the objects")
+      {
+        REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+        REQUIRE(machine.Times == std::vector<uint32_t>({10, 11, 12, 13}));
+        REQUIRE(machine.Machine.Event == 0);
+        REQUIRE(machine.Machine.Event_Object == NULL);
+
+        std::vector<hsm::event_ptr<set_time_event_t>> events;
+        for(uint32_t count = 0; count < 4; count++)
+        {
+          events.push_back(pool.make(EN_SET_TIME, count));
+          REQUIRE(events.back());
+        }
+      }
+    }
+
+    WHEN("handler triggers an event to self")
+    {
+      machine.Trigger_Count = 1;
+      hsm::post(&machine.Machine, pool.make(EN_SET_TIME, 5u));
+
+      THEN("Payload is available until the run to completion is over")
+      {
+        REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+        REQUIRE(machine.Times == std::vector<uint32_t>({5, 5}));
+      }
+    }
+
+    WHEN("event object is dropped without posting")
+    {
+      {
+        hsm::event_ptr<set_time_event_t> event = pool.make(EN_SET_TIME, 1u);
+        hsm::event_ptr<set_time_event_t> moved(std::move(event));
+        REQUIRE(moved);
+      }
+
+      THEN("It returns to the pool")
+      {
+        std::vector<hsm::event_ptr<set_time_event_t>> events;
+        for(uint32_t count = 0; count < 4; count++)
+        {
+          events.push_back(pool.make(EN_SET_TIME, count));
+          REQUIRE(events.back());
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Event objects posted from many threads")
+{
+  GIVEN("A state machine and producers sharing a pool")
+  {
+    hsm::event_pool<set_time_event_t, 64> pool;
+    timer_machine_t machine = {};
+    machine.Machine.State = timerHSM;
+    state_machine_t * const machineList[] = {&machine.Machine};
+
+    const uint32_t PRODUCERS = 4;
+    const uint32_t EVENTS = 2000;
+
+    WHEN("producers post concurrently with the dispatcher")
+    {
+      std::vector<std::thread> producers;
+      for(uint32_t producer = 0; producer < PRODUCERS; producer++)
+      {
+        producers.emplace_back([producer, &machine, &pool]()
+        {
+          for(uint32_t count = 0; count < EVENTS;)
+          {
+            hsm::event_ptr<set_time_event_t> event = pool.make(EN_SET_TIME, producer * EVENTS + count);
+            if(event)
+            {
+              hsm::post(&machine.Machine, std::move(event));
+              count++;
+            }
+            else
+            {
+              std::this_thread::yield();
+            }
+          }
+        });
+      }
+
+      while(machine.Times.size() < PRODUCERS * EVENTS)
+      {
+        REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+      }
+
+      for(auto& producer : producers)
+      {
+        producer.join();
+      }
+
+      THEN("Every event is handled once and in posting order of each producer")
+      {
+        std::vector<uint32_t> next(PRODUCERS, 0);
+        for(uint32_t time : machine.Times)
+        {
+          const uint32_t producer = time / EVENTS;
+          REQUIRE(time % EVENTS == next[producer]);
+          next[producer]++;
+        }
+      }
+    }
+  }
+}
+
+}
@@ -0,0 +1,229 @@
+/**
+ * \file
+ * \brief Flight recorder test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_recorder.h"
+
+namespace flight_recorder_test
+{
+
+typedef enum
+{
+  ROOT_STATE = 1,
+  A_STATE,
+  A1_STATE,
+  B_STATE,
+}en_state_id;
+
+enum
+{
+  SWITCH_EVENT = 5,
+  UNKNOWN_EVENT = 9,
+};
+
+extern const state_t Root_State;
+extern const state_t Child_States[2];
+extern const state_t A_Child_States[1];
+
+state_machine_result_t root_handler(state_machine_t* const pState)
+{
+  if(pState->Event == SWITCH_EVENT)
+  {
+    return traverse_state(pState, &Child_States[1]);
+  }
+  return EVENT_UN_HANDLED;
+}
+
+state_machine_result_t a1_handler(state_machine_t* const)
+{
+  return EVENT_UN_HANDLED;
+}
+
+state_machine_result_t b_handler(state_machine_t* const pState)
+{
+  return (pState->Event == UNKNOWN_EVENT) ? EVENT_UN_HANDLED : EVENT_HANDLED;
+}
+
+const state_t Root_State = {root_handler, NULL, NULL, ROOT_STATE, NULL, Child_States, 0};
+
+const state_t Child_States[2] =
+{
+  {NULL, NULL, NULL, A_STATE, &Root_State, A_Child_States, 1},
+  {b_handler, NULL, NULL, B_STATE, &Root_State, NULL, 1},
+};
+
+const state_t A_Child_States[1] =
+{
+  {a1_handler, NULL, NULL, A1_STATE, &Child_States[0], NULL, 2},
+};
+
+//! History captured by the flight recorder handler.
+static struct
+{
+  uint32_t Calls;
+  uint32_t Index;
+  const state_machine_t* pState_Machine;
+  const state_t* pState;
+  std::vector<flight_record_t> Records;
+}Report;
+
+static void unhandled_event_handler(uint32_t index, const state_machine_t* const pState_Machine,
+                                    const state_t* const pState)
+{
+  Report.Calls++;
+  Report.Index = index;
+  Report.pState_Machine = pState_Machine;
+  Report.pState = pState;
+  Report.Records.resize(HSM_FLIGHT_RECORDER_SIZE);
+  Report.Records.resize(read_flight_recorder(pState_Machine, Report.Records.data(), HSM_FLIGHT_RECORDER_SIZE));
+}
+
+SCENARIO("Flight recorder reports the history of unhandled event")
+{
+  GIVEN("A state machine that switches state and then can't handle an event")
+  {
+    Report.Calls = 0;
+    set_flight_recorder_handler(unhandled_event_handler);
+
+    state_machine_t idle = {};
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&idle, &machine};
+    idle.State = &Child_States[1];
+    machine.State = &A_Child_States[0];
+
+    machine.Event = SWITCH_EVENT;
+    REQUIRE(dispatch_event(machineList, 2) == EVENT_HANDLED);
+    REQUIRE(Report.Calls == 0);
+
+    machine.Event = UNKNOWN_EVENT;
+    REQUIRE(dispatch_event(machineList, 2) == EVENT_UN_HANDLED);
+    set_flight_recorder_handler(NULL);
+
+    THEN("Handler is called once with the state machine and its top state")
+    {
+      REQUIRE(Report.Calls == 1);
+      REQUIRE(Report.Index == 1);
+      REQUIRE(Report.pState_Machine == &machine);
+      REQUIRE(Report.pState == &Root_State);
+    }
+
+    THEN("Records show how the state machine reached the unhandled event")
+    {
+      struct expected_record
+      {
+        flight_record_type_t Type;
+        const state_t* State;
+        const state_t* Target;
+        uint32_t Event;
+        state_machine_result_t Result;
+      };
+
+      const std::vector<expected_record> expected =
+      {
+        {FLIGHT_DISPATCH, &A_Child_States[0], NULL, SWITCH_EVENT, EVENT_HANDLED},
+        {FLIGHT_RESULT, &A_Child_States[0], NULL, SWITCH_EVENT, EVENT_UN_HANDLED},
+        {FLIGHT_DISPATCH, &Root_State, NULL, SWITCH_EVENT, EVENT_HANDLED},
+        {FLIGHT_TRANSITION, &A_Child_States[0], &Child_States[1], SWITCH_EVENT, EVENT_HANDLED},
+        {FLIGHT_RESULT, &Root_State, NULL, SWITCH_EVENT, EVENT_HANDLED},
+        {FLIGHT_DISPATCH, &Child_States[1], NULL, UNKNOWN_EVENT, EVENT_HANDLED},
+        {FLIGHT_RESULT, &Child_States[1], NULL, UNKNOWN_EVENT, EVENT_UN_HANDLED},
+        {FLIGHT_DISPATCH, &Root_State, NULL, UNKNOWN_EVENT, EVENT_HANDLED},
+        {FLIGHT_RESULT, &Root_State, NULL, UNKNOWN_EVENT, EVENT_UN_HANDLED},
+      };
+
+      REQUIRE(Report.Records.size() == expected.size());
+      for(size_t index = 0; index < expected.size(); index++)
+      {
+        INFO("record " << index);
+        REQUIRE(Report.Records[index].Type == expected[index].Type);
+        REQUIRE(Report.Records[index].State == expected[index].State);
+        REQUIRE(Report.Records[index].Target == expected[index].Target);
+        REQUIRE(Report.Records[index].Event == expected[index].Event);
+        REQUIRE(Report.Records[index].Result == expected[index].Result);
+      }
+    }
+
+    THEN("Idle state machine has no records")
+    {
+      REQUIRE(idle.Recorder.Count == 0);
+    }
+
+    THEN("Printed history has a line for each record")
+    {
+      FILE* const pFile = std::tmpfile();
+      REQUIRE(pFile != nullptr);
+      print_flight_recorder(pFile, &machine);
+      std::rewind(pFile);
+
+      std::vector<std::string> lines;
+      char line[256];
+      while(std::fgets(line, sizeof(line), pFile) != nullptr)
+      {
+        lines.push_back(line);
+      }
+      std::fclose(pFile);
+
+      REQUIRE(lines.size() == 10);
+      REQUIRE(lines[4] == "transition state 3 event 5 target 4\n");
+      REQUIRE(lines[9] == "result     state 1 event 9 result 1\n");
+    }
+  }
+}
+
+SCENARIO("Flight recorder keeps the most recent records")
+{
+  GIVEN("More records than the size of flight recorder")
+  {
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    machine.State = &Child_States[1];
+
+    // Each dispatch records the dispatch and its result.
+    const uint32_t events = HSM_FLIGHT_RECORDER_SIZE + 4;
+    const uint32_t last = UNKNOWN_EVENT + events;
+    for(uint32_t event = UNKNOWN_EVENT + 1; event <= last; event++)
+    {
+      machine.Event = event;
+      REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+    }
+
+    THEN("Oldest records are overwritten")
+    {
+      std::vector<flight_record_t> records(HSM_FLIGHT_RECORDER_SIZE);
+      REQUIRE(read_flight_recorder(&machine, records.data(), HSM_FLIGHT_RECORDER_SIZE) == HSM_FLIGHT_RECORDER_SIZE);
+      REQUIRE(records.front().Type == FLIGHT_DISPATCH);
+      REQUIRE(records.front().Event == last - HSM_FLIGHT_RECORDER_SIZE / 2 + 1);
+      REQUIRE(records.back().Type == FLIGHT_RESULT);
+      REQUIRE(records.back().Event == last);
+      REQUIRE(machine.Recorder.Count == 2 * events);
+    }
+
+    THEN("Reading fewer records gives the newest ones")
+    {
+      flight_record_t records[2];
+      REQUIRE(read_flight_recorder(&machine, records, 2) == 2);
+      REQUIRE(records[0].Type == FLIGHT_DISPATCH);
+      REQUIRE(records[0].Event == last);
+      REQUIRE(records[1].Type == FLIGHT_RESULT);
+      REQUIRE(records[1].Event == last);
+    }
+  }
+}
+
+}
@@ -0,0 +1,227 @@
+/**
+ * \file
+ * \brief Stress test of large generated hierarchical state machines
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <vector>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "state_generator.h"
+
+namespace generated_hsm_test
+{
+
+static const generator_config_t Large_Config =
+{
+  100000,     // States
+  16,         // Max_Depth
+  8,          // Max_Fanout
+  8,          // Events
+  10,         // None_Percent
+  30,         // Pass_Percent
+  40,         // Transition_Percent
+  0x5EED,     // Seed
+};
+
+//! Expected outcome of an event, from the generated behaviour of the states.
+typedef struct
+{
+  const state_t* State;
+  uint64_t Handler_Calls;
+  uint64_t Exits;
+  uint64_t Entries;
+}expected_t;
+
+static expected_t expect_event(const generated_hsm_t* const pHsm, const state_t* const pCurrent, uint32_t event)
+{
+  expected_t expected = {pCurrent, 0, 0, 0};
+
+  const state_t* pState = pCurrent;
+  generated_action_t action = get_generated_action(pState);
+  while((action == ACTION_NONE) || (action == ACTION_PASS))
+  {
+    expected.Handler_Calls += (action == ACTION_PASS) ? 1 : 0;
+    pState = pState->Parent;
+    REQUIRE(pState != NULL);
+    action = get_generated_action(pState);
+  }
+  expected.Handler_Calls++;
+
+  const uint32_t target = get_generated_target(pHsm, pCurrent, event);
+  if(target != GENERATED_NO_TARGET)
+  {
+    const state_t* const pTarget = &pHsm->Tree.States[target];
+    // Exit up to and enter down from the child states of the common parent.
+    const state_t* pSource_Node = pCurrent;
+    const state_t* pTarget_Node = pTarget;
+    while(pSource_Node->Level > pTarget_Node->Level)
+    {
+      pSource_Node = pSource_Node->Parent;
+    }
+    while(pTarget_Node->Level > pSource_Node->Level)
+    {
+      pTarget_Node = pTarget_Node->Parent;
+    }
+    while(pSource_Node->Parent != pTarget_Node->Parent)
+    {
+      pSource_Node = pSource_Node->Parent;
+      pTarget_Node = pTarget_Node->Parent;
+    }
+
+    expected.State = pTarget;
+    expected.Exits = pCurrent->Level - pSource_Node->Level + 1;
+    expected.Entries = pTarget->Level - pTarget_Node->Level + 1;
+  }
+  return expected;
+}
+
+TEST_CASE("Same seed generates the same state machine", "[generated_hsm]")
+{
+  generator_config_t config = Large_Config;
+  config.States = 10000;
+
+  generated_hsm_t first;
+  generated_hsm_t second;
+  REQUIRE(generate_hsm(&first, &config));
+  REQUIRE(generate_hsm(&second, &config));
+
+  REQUIRE(first.Top_States == second.Top_States);
+  REQUIRE(first.Max_Level == second.Max_Level);
+  bool same = true;
+  for(uint32_t index = 0; index < config.States; index++)
+  {
+    const state_t* const pFirst = &first.Tree.States[index];
+    const state_t* const pSecond = &second.Tree.States[index];
+    same = same && (get_generated_action(pFirst) == get_generated_action(pSecond))
+           && (pFirst->Level == pSecond->Level)
+           && ((pFirst->Parent == NULL) == (pSecond->Parent == NULL))
+           && ((pFirst->Parent == NULL) || (get_state_index(&first, pFirst->Parent)
+                                            == get_state_index(&second, pSecond->Parent)));
+  }
+  for(uint32_t index = 0; index < config.States * config.Events; index++)
+  {
+    same = same && (first.Targets[index] == second.Targets[index]);
+  }
+  REQUIRE(same);
+
+  generated_hsm_t other;
+  config.Seed++;
+  REQUIRE(generate_hsm(&other, &config));
+  bool differ = false;
+  for(uint32_t index = 0; index < config.States * config.Events; index++)
+  {
+    differ = differ || (first.Targets[index] != other.Targets[index]);
+  }
+  REQUIRE(differ);
+
+  free_generated_hsm(&first);
+  free_generated_hsm(&second);
+  free_generated_hsm(&other);
+}
+
+TEST_CASE("Generator rejects the states that don't fit", "[generated_hsm]")
+{
+  generator_config_t config = Large_Config;
+  config.Max_Depth = 2;
+  config.Max_Fanout = 4;
+  config.States = 21;           // 4 top states with 4 child states each
+
+  generated_hsm_t hsm;
+  REQUIRE_FALSE(generate_hsm(&hsm, &config));
+
+  config.States = 20;
+  REQUIRE(generate_hsm(&hsm, &config));
+  REQUIRE(hsm.Max_Level == 1);
+  free_generated_hsm(&hsm);
+}
+
+TEST_CASE("Generated hierarchy is consistent", "[generated_hsm]")
+{
+  generated_hsm_t hsm;
+  REQUIRE(generate_hsm(&hsm, &Large_Config));
+  REQUIRE(hsm.Tree.Count == Large_Config.States);
+  REQUIRE(hsm.Max_Level < Large_Config.Max_Depth);
+
+  std::vector<uint32_t> children(Large_Config.States, 0);
+  uint32_t top_states = 0;
+  bool consistent = true;
+  for(uint32_t index = 0; index < Large_Config.States; index++)
+  {
+    const state_t* const pState = &hsm.Tree.States[index];
+    if(pState->Parent == NULL)
+    {
+      // Top states are the first states and handle all the events.
+      consistent = consistent && (index == top_states) && (pState->Level == 0)
+                   && (get_generated_action(pState) == ACTION_HANDLE);
+      top_states++;
+      continue;
+    }
+
+    const uint32_t parent = get_state_index(&hsm, pState->Parent);
+    consistent = consistent && (pState->Level == pState->Parent->Level + 1)
+                 && (pState == pState->Parent->Node + children[parent]);
+    children[parent]++;
+  }
+  REQUIRE(consistent);
+  REQUIRE(top_states == hsm.Top_States);
+
+  for(uint32_t index = 0; index < Large_Config.States; index++)
+  {
+    const state_t* const pState = &hsm.Tree.States[index];
+    consistent = consistent && (children[index] <= Large_Config.Max_Fanout)
+                 && ((children[index] == 0) == (pState->Node == NULL));
+  }
+  REQUIRE(consistent);
+  free_generated_hsm(&hsm);
+}
+
+TEST_CASE("Random events on a large generated state machine", "[generated_hsm]")
+{
+  static const uint32_t MACHINES = 16;
+  static const uint32_t EVENTS = 200000;
+
+  generated_hsm_t hsm;
+  REQUIRE(generate_hsm(&hsm, &Large_Config));
+
+  std::vector<generated_machine_t> machines(MACHINES);
+  for(uint32_t index = 0; index < MACHINES; index++)
+  {
+    init_generated_machine(&machines[index], &hsm, index % hsm.Top_States);
+  }
+
+  uint64_t seed = Large_Config.Seed;
+  uint64_t transitions = 0;
+  bool matched = true;
+  for(uint32_t count = 0; (count < EVENTS) && matched; count++)
+  {
+    generated_machine_t* const pMachine = &machines[random_below(&seed, MACHINES)];
+    const uint32_t event = random_below(&seed, hsm.Events) + 1;
+    const expected_t expected = expect_event(&hsm, pMachine->Machine.State, event);
+    const generated_machine_t before = *pMachine;
+
+    state_machine_t* const machineList[] = {&pMachine->Machine};
+    pMachine->Machine.Event = event;
+    matched = (dispatch_event(machineList, 1) == EVENT_HANDLED)
+              && (pMachine->Machine.State == expected.State)
+              && (pMachine->Handler_Calls - before.Handler_Calls == expected.Handler_Calls)
+              && (pMachine->Exits - before.Exits == expected.Exits)
+              && (pMachine->Entries - before.Entries == expected.Entries);
+    transitions += pMachine->Transitions - before.Transitions;
+  }
+
+  REQUIRE(matched);
+  REQUIRE(transitions != 0);
+  free_generated_hsm(&hsm);
+}
+
+}
@@ -0,0 +1,182 @@
+/**
+ * \file
+ * \brief Handler latency histogram test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_histogram.h"
+
+namespace latency_histogram_test
+{
+
+//! Cycle counter seen by the framework, handlers of the tests advance it.
+uint64_t Fake_Cycles;
+static uint64_t Handler_Latency;
+
+typedef enum
+{
+  IDLE_STATE = 1,
+  BUSY_STATE,
+  UNKNOWN_STATE = HSM_HISTOGRAM_MAX_STATES,
+}en_state_id;
+
+enum
+{
+  WORK_EVENT = 3,
+};
+
+state_machine_result_t handler(state_machine_t* const)
+{
+  Fake_Cycles += Handler_Latency;
+  return EVENT_HANDLED;
+}
+
+const state_t Idle_State = {handler, NULL, NULL, IDLE_STATE, NULL, NULL, 0};
+const state_t Busy_State = {handler, NULL, NULL, BUSY_STATE, NULL, NULL, 0};
+const state_t Unknown_State = {handler, NULL, NULL, UNKNOWN_STATE, NULL, NULL, 0};
+
+static void dispatch(state_machine_t * const machineList[], uint32_t quantity,
+                     state_machine_t* const pMachine, uint64_t latency, uint32_t count)
+{
+  Handler_Latency = latency;
+  for(uint32_t index = 0; index < count; index++)
+  {
+    pMachine->Event = WORK_EVENT;
+    dispatch_event(machineList, quantity);
+  }
+  Handler_Latency = 0;
+}
+
+SCENARIO("Latency buckets have bounded relative error")
+{
+  GIVEN("Latencies across the range of histogram")
+  {
+    THEN("Small latencies have exact buckets")
+    {
+      for(uint64_t cycles = 0; cycles < 2 * HISTOGRAM_SUB_BUCKETS; cycles++)
+      {
+        REQUIRE(get_bucket_latency(get_latency_bucket(cycles)) == cycles);
+      }
+    }
+
+    THEN("Each bucket covers the latencies up to its highest latency")
+    {
+      uint64_t previous = 0;
+      for(uint32_t bucket = 1; bucket < HISTOGRAM_BUCKETS; bucket++)
+      {
+        const uint64_t highest = get_bucket_latency(bucket);
+        REQUIRE(get_latency_bucket(previous + 1) == bucket);
+        REQUIRE(get_latency_bucket(highest) == bucket);
+        REQUIRE((highest - previous) <= (previous + 1) / HISTOGRAM_SUB_BUCKETS + 1);
+        previous = highest;
+      }
+    }
+
+    THEN("Latencies beyond the range are in the last bucket")
+    {
+      REQUIRE(get_latency_bucket(UINT64_MAX) == HISTOGRAM_BUCKETS - 1);
+      REQUIRE(get_latency_bucket(1ull << HSM_HISTOGRAM_MAX_BITS) == HISTOGRAM_BUCKETS - 1);
+    }
+  }
+}
+
+SCENARIO("Handler latencies are aggregated per state, event and machine")
+{
+  GIVEN("A busy state machine next to an idle one")
+  {
+    state_machine_t idle = {};
+    state_machine_t busy = {};
+    state_machine_t * const machineList[] = {&idle, &busy};
+    idle.State = &Idle_State;
+    busy.State = &Busy_State;
+    reset_latency_histograms();
+
+    dispatch(machineList, 2, &busy, 100, 990);
+    dispatch(machineList, 2, &busy, 1000, 9);
+    dispatch(machineList, 2, &busy, 10000, 1);
+
+    THEN("Percentiles of the state handler reflect the distribution")
+    {
+      latency_histogram_t histogram;
+      latency_summary_t summary;
+      REQUIRE(snapshot_state_latency(BUSY_STATE, WORK_EVENT, &histogram, false));
+      summarize_latency(&histogram, &summary);
+
+      REQUIRE(summary.Count == 1000);
+      REQUIRE(summary.P50 == get_bucket_latency(get_latency_bucket(100)));
+      REQUIRE(summary.P99 == get_bucket_latency(get_latency_bucket(100)));
+      REQUIRE(summary.P999 == get_bucket_latency(get_latency_bucket(1000)));
+      REQUIRE(summary.Max == get_bucket_latency(get_latency_bucket(10000)));
+      REQUIRE(summary.P50 >= 100);
+      REQUIRE(summary.P50 < 100 + 100 / HISTOGRAM_SUB_BUCKETS);
+    }
+
+    THEN("Histogram of state machine counts its handler calls")
+    {
+      latency_histogram_t histogram;
+      latency_summary_t summary;
+      REQUIRE(snapshot_machine_latency(1, &histogram, false));
+      summarize_latency(&histogram, &summary);
+      REQUIRE(summary.Count == 1000);
+
+      REQUIRE(snapshot_machine_latency(0, &histogram, false));
+      summarize_latency(&histogram, &summary);
+      REQUIRE(summary.Count == 0);
+      REQUIRE(summary.P99 == 0);
+
+      REQUIRE_FALSE(snapshot_machine_latency(HSM_HISTOGRAM_MAX_MACHINES, &histogram, false));
+    }
+
+    THEN("Snapshot with reset clears the histogram")
+    {
+      latency_histogram_t histogram;
+      latency_summary_t summary;
+      REQUIRE(snapshot_state_latency(BUSY_STATE, WORK_EVENT, &histogram, true));
+      summarize_latency(&histogram, &summary);
+      REQUIRE(summary.Count == 1000);
+
+      REQUIRE(snapshot_state_latency(BUSY_STATE, WORK_EVENT, &histogram, false));
+      summarize_latency(&histogram, &summary);
+      REQUIRE(summary.Count == 0);
+    }
+  }
+
+  GIVEN("A state Id outside of the histogram table")
+  {
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    machine.State = &Unknown_State;
+    reset_latency_histograms();
+
+    dispatch(machineList, 1, &machine, 50, 10);
+
+    THEN("Its handler calls are recorded in the histogram of other states")
+    {
+      latency_histogram_t histogram;
+      latency_summary_t summary;
+      REQUIRE_FALSE(snapshot_state_latency(UNKNOWN_STATE, WORK_EVENT, &histogram, false));
+
+      snapshot_other_state_latency(&histogram, false);
+      summarize_latency(&histogram, &summary);
+      REQUIRE(summary.Count == 10);
+      REQUIRE(summary.Max == get_bucket_latency(get_latency_bucket(50)));
+    }
+  }
+}
+
+}
+
+extern "C" uint64_t test_cycle_counter(void)
+{
+  return latency_histogram_test::Fake_Cycles;
+}
@@ -0,0 +1,137 @@
+/**
+ * \file
+ * \brief Queue depth and event wait time metrics test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_event.h"
+#include "hsm_queue.h"
+
+namespace queue_metrics_test
+{
+
+enum
+{
+  WORK_EVENT = 1,
+};
+
+state_machine_result_t handler(state_machine_t* const)
+{
+  return EVENT_HANDLED;
+}
+
+const state_t Work_State = {handler, NULL, NULL, 1, NULL, NULL, 0};
+
+static const uint64_t Wait_Time = 2000000;    // 2 ms in ns
+
+SCENARIO("Queue depth follows the posted and dispatched events")
+{
+  GIVEN("A state machine with three posted events")
+  {
+    event_t events[4];
+    event_pool_t pool;
+    init_event_pool(&pool, events, sizeof(event_t), 4);
+
+    state_machine_t idle = {};
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&idle, &machine};
+    idle.State = &Work_State;
+    machine.State = &Work_State;
+
+    for(uint32_t count = 0; count < 3; count++)
+    {
+      post_event(&machine, allocate_event(&pool, WORK_EVENT));
+    }
+
+    THEN("Depth and high water mark count the pending events")
+    {
+      queue_depth_t depth;
+      get_queue_depth(&machine, &depth, false);
+      REQUIRE(depth.Depth == 3);
+      REQUIRE(depth.High_Water == 3);
+      REQUIRE(dispatch_event(machineList, 2) == EVENT_HANDLED);
+    }
+
+    THEN("High water mark stays after the dispatch till it is reset")
+    {
+      REQUIRE(dispatch_event(machineList, 2) == EVENT_HANDLED);
+
+      queue_depth_t depth;
+      get_queue_depth(&machine, &depth, true);
+      REQUIRE(depth.Depth == 0);
+      REQUIRE(depth.High_Water == 3);
+
+      get_queue_depth(&machine, &depth, false);
+      REQUIRE(depth.High_Water == 0);
+
+      get_queue_depth(&idle, &depth, false);
+      REQUIRE(depth.High_Water == 0);
+    }
+  }
+}
+
+SCENARIO("Wait time is measured from the post to the dispatch of event")
+{
+  GIVEN("Events waiting in the queue of a state machine")
+  {
+    event_t events[2];
+    event_pool_t pool;
+    init_event_pool(&pool, events, sizeof(event_t), 2);
+    reset_queue_wait();
+
+    state_machine_t idle = {};
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&idle, &machine};
+    idle.State = &Work_State;
+    machine.State = &Work_State;
+
+    post_event(&machine, allocate_event(&pool, WORK_EVENT));
+    post_event(&machine, allocate_event(&pool, WORK_EVENT));
+    std::this_thread::sleep_for(std::chrono::nanoseconds(Wait_Time));
+    REQUIRE(dispatch_event(machineList, 2) == EVENT_HANDLED);
+
+    THEN("Wait time is recorded by the index of state machine")
+    {
+      queue_metrics_t metrics;
+      REQUIRE(get_queue_metrics(1, &machine, &metrics, false));
+      REQUIRE(metrics.Wait.Count == 2);
+      REQUIRE(metrics.Wait.P50 >= Wait_Time);
+      REQUIRE(metrics.Depth.Depth == 0);
+      REQUIRE(metrics.Depth.High_Water == 2);
+
+      REQUIRE(get_queue_metrics(0, &idle, &metrics, false));
+      REQUIRE(metrics.Wait.Count == 0);
+    }
+
+    THEN("Reset clears the wait histogram")
+    {
+      queue_metrics_t metrics;
+      REQUIRE(get_queue_metrics(1, &machine, &metrics, true));
+      REQUIRE(metrics.Wait.Count == 2);
+      REQUIRE(get_queue_metrics(1, &machine, &metrics, false));
+      REQUIRE(metrics.Wait.Count == 0);
+    }
+
+    THEN("Index out of range of the table has no wait histogram")
+    {
+      queue_metrics_t metrics;
+      REQUIRE_FALSE(get_queue_metrics(HSM_QUEUE_MAX_MACHINES, &machine, &metrics, false));
+      REQUIRE(metrics.Wait.Count == 0);
+    }
+  }
+}
+
+}
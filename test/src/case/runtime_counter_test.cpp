@@ -0,0 +1,210 @@
+/**
+ * \file
+ * \brief Runtime counters test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <thread>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_counter.h"
+
+namespace runtime_counter_test
+{
+
+typedef enum
+{
+  ROOT_STATE = 1,
+  A_STATE,
+  A1_STATE,
+  B_STATE,
+  TOP_STATE,
+  TRIGGER_STATE,
+}en_state_id;
+
+extern const state_t Root_State;
+extern const state_t Child_States[2];
+extern const state_t A_Child_States[1];
+
+state_machine_result_t root_handler(state_machine_t* const pState)
+{
+  return traverse_state(pState, &Child_States[1]);
+}
+
+state_machine_result_t unhandled_handler(state_machine_t* const)
+{
+  return EVENT_UN_HANDLED;
+}
+
+state_machine_result_t handled_handler(state_machine_t* const)
+{
+  return EVENT_HANDLED;
+}
+
+//! Handles the first event by posting the second event to itself.
+state_machine_result_t trigger_handler(state_machine_t* const pState)
+{
+  if(pState->Event == 1)
+  {
+    pState->Event = 2;
+    return TRIGGERED_TO_SELF;
+  }
+  return EVENT_HANDLED;
+}
+
+const state_t Root_State = {root_handler, NULL, NULL, ROOT_STATE, NULL, Child_States, 0};
+
+const state_t Child_States[2] =
+{
+  {NULL, NULL, NULL, A_STATE, &Root_State, A_Child_States, 1},
+  {handled_handler, NULL, NULL, B_STATE, &Root_State, NULL, 1},
+};
+
+const state_t A_Child_States[1] =
+{
+  {unhandled_handler, NULL, NULL, A1_STATE, &Child_States[0], NULL, 2},
+};
+
+const state_t Top_State = {unhandled_handler, NULL, NULL, TOP_STATE, NULL, NULL, 0};
+const state_t Trigger_State = {trigger_handler, NULL, NULL, TRIGGER_STATE, NULL, NULL, 0};
+
+static state_machine_counters_t get_counters(const state_machine_t* const pMachine)
+{
+  state_machine_counters_t counters;
+  get_state_machine_counters(pMachine, &counters);
+  return counters;
+}
+
+static hsm_counters_t get_global(void)
+{
+  hsm_counters_t counters;
+  get_global_counters(&counters);
+  return counters;
+}
+
+SCENARIO("State machine counts the handler calls, bubbling and transitions")
+{
+  GIVEN("A hierarchical state machine in the deepest state")
+  {
+    state_machine_t idle = {};
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&idle, &machine};
+    idle.State = &Child_States[1];
+    machine.State = &A_Child_States[0];
+    machine.Event = 5;
+
+    const hsm_counters_t before = get_global();
+    REQUIRE(dispatch_event(machineList, 2) == EVENT_HANDLED);
+    const hsm_counters_t after = get_global();
+
+    THEN("Each step of the event processing is counted in the state machine")
+    {
+      const state_machine_counters_t counters = get_counters(&machine);
+      REQUIRE(counters.Handler_Calls == 2);
+      REQUIRE(counters.Handled == 1);
+      REQUIRE(counters.Triggered == 0);
+      REQUIRE(counters.Unhandled == 0);
+      REQUIRE(counters.Bubbles == 2);
+      REQUIRE(counters.Transitions == 1);
+      REQUIRE(counters.Exits == 2);
+      REQUIRE(counters.Entries == 1);
+
+      const state_machine_counters_t idle_counters = get_counters(&idle);
+      REQUIRE(idle_counters.Handler_Calls == 0);
+    }
+
+    THEN("Global counters increase by the same counts")
+    {
+      REQUIRE(after.Dispatcher_Calls - before.Dispatcher_Calls == 1);
+      REQUIRE(after.Restarts - before.Restarts == 1);
+      REQUIRE(after.Machines.Handler_Calls - before.Machines.Handler_Calls == 2);
+      REQUIRE(after.Machines.Bubbles - before.Machines.Bubbles == 2);
+      REQUIRE(after.Machines.Transitions - before.Machines.Transitions == 1);
+      REQUIRE(after.Machines.Exits - before.Machines.Exits == 2);
+      REQUIRE(after.Machines.Entries - before.Machines.Entries == 1);
+    }
+  }
+}
+
+SCENARIO("State machine counts the unhandled events and triggered events")
+{
+  GIVEN("A state machine that can't handle the event")
+  {
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    machine.State = &Top_State;
+    machine.Event = 3;
+
+    REQUIRE(dispatch_event(machineList, 1) == EVENT_UN_HANDLED);
+
+    THEN("Event is counted as unhandled once it reaches the top state")
+    {
+      const state_machine_counters_t counters = get_counters(&machine);
+      REQUIRE(counters.Handler_Calls == 1);
+      REQUIRE(counters.Unhandled == 1);
+      REQUIRE(counters.Bubbles == 0);
+      REQUIRE(counters.Handled == 0);
+    }
+  }
+
+  GIVEN("A state machine that posts an event to itself")
+  {
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    machine.State = &Trigger_State;
+    machine.Event = 1;
+
+    const hsm_counters_t before = get_global();
+    REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+    const hsm_counters_t after = get_global();
+
+    THEN("Both events are counted and the dispatcher restarts for each")
+    {
+      const state_machine_counters_t counters = get_counters(&machine);
+      REQUIRE(counters.Handler_Calls == 2);
+      REQUIRE(counters.Triggered == 1);
+      REQUIRE(counters.Handled == 1);
+      REQUIRE(after.Restarts - before.Restarts == 2);
+    }
+  }
+}
+
+SCENARIO("Global counters include the counts of all threads")
+{
+  GIVEN("A state machine dispatched from other thread")
+  {
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    machine.State = &Child_States[1];
+
+    const hsm_counters_t before = get_global();
+    std::thread worker([&machineList, &machine]()
+    {
+      for(uint32_t count = 0; count < 10; count++)
+      {
+        machine.Event = 1;
+        dispatch_event(machineList, 1);
+      }
+    });
+    worker.join();
+    const hsm_counters_t after = get_global();
+
+    THEN("Snapshot sums the counters of the worker thread")
+    {
+      REQUIRE(after.Dispatcher_Calls - before.Dispatcher_Calls == 10);
+      REQUIRE(after.Machines.Handled - before.Machines.Handled == 10);
+      REQUIRE(get_counters(&machine).Handled == 10);
+    }
+  }
+}
+
+}
@@ -0,0 +1,233 @@
+/**
+ * \file
+ * \brief Sampling profiler test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <chrono>
+
+#include <sys/time.h>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_profiler.h"
+
+namespace sampling_profiler_test
+{
+
+typedef enum
+{
+  IDLE_STATE = 1,
+  SAMPLED_STATE,
+  SPINNING_STATE,
+  OUTER_STATE,
+  LARGE_STATE = 0x7FFFFFFF,
+}en_state_id;
+
+enum
+{
+  WORK_EVENT = 7,
+};
+
+static const uint32_t Spin_Samples = 3;
+
+state_machine_result_t idle_handler(state_machine_t* const)
+{
+  return EVENT_HANDLED;
+}
+
+//! Takes the samples itself, as if the timer expired three times during the handler.
+state_machine_result_t sampled_handler(state_machine_t* const)
+{
+  sample_profiler();
+  sample_profiler();
+  sample_profiler();
+  return EVENT_HANDLED;
+}
+
+static uint64_t get_samples(uint32_t machine, uint32_t state, uint32_t event)
+{
+  profile_sample_t samples[HSM_PROFILER_BUCKETS];
+  const uint32_t count = read_profile_samples(samples, HSM_PROFILER_BUCKETS);
+  for(uint32_t index = 0; index < count; index++)
+  {
+    if((samples[index].Machine == machine) && (samples[index].State == state)
+       && (samples[index].Event == event))
+    {
+      return samples[index].Samples;
+    }
+  }
+  return 0;
+}
+
+//! Burns CPU time till the timer has sampled it a few times, or a timeout.
+state_machine_result_t spinning_handler(state_machine_t* const)
+{
+  const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while((get_samples(0, SPINNING_STATE, WORK_EVENT) < Spin_Samples)
+        && (std::chrono::steady_clock::now() < timeout))
+  {
+  }
+  return EVENT_HANDLED;
+}
+
+const state_t Idle_State = {idle_handler, NULL, NULL, IDLE_STATE, NULL, NULL, 0};
+const state_t Sampled_State = {sampled_handler, NULL, NULL, SAMPLED_STATE, NULL, NULL, 0};
+const state_t Spinning_State = {spinning_handler, NULL, NULL, SPINNING_STATE, NULL, NULL, 0};
+const state_t Large_State = {sampled_handler, NULL, NULL, LARGE_STATE, NULL, NULL, 0};
+
+//! Dispatches the event of an inner state machine, then takes a sample itself.
+state_machine_result_t outer_handler(state_machine_t* const)
+{
+  state_machine_t inner = {};
+  state_machine_t * const innerList[] = {&inner};
+  inner.State = &Idle_State;
+  inner.Event = WORK_EVENT + 1;
+  dispatch_event(innerList, 1);
+  sample_profiler();
+  return EVENT_HANDLED;
+}
+
+const state_t Outer_State = {outer_handler, NULL, NULL, OUTER_STATE, NULL, NULL, 0};
+
+SCENARIO("Samples are attributed to the running state handler")
+{
+  GIVEN("A state handler sampled while it processes an event")
+  {
+    reset_sampling_profiler();
+    state_machine_t idle = {};
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&idle, &machine};
+    idle.State = &Idle_State;
+    machine.State = &Sampled_State;
+    machine.Event = WORK_EVENT;
+
+    REQUIRE(dispatch_event(machineList, 2) == EVENT_HANDLED);
+    sample_profiler();
+
+    THEN("Samples are counted by state machine, state and event")
+    {
+      REQUIRE(get_samples(1, SAMPLED_STATE, WORK_EVENT) == 3);
+      REQUIRE(get_samples(0, IDLE_STATE, WORK_EVENT) == 0);
+    }
+
+    THEN("Sample outside of the state handler is idle")
+    {
+      profile_totals_t totals;
+      get_profile_totals(&totals);
+      REQUIRE(totals.Samples == 4);
+      REQUIRE(totals.Idle == 1);
+      REQUIRE(totals.Lost == 0);
+    }
+  }
+
+  GIVEN("A state Id wider than its field of the activity word")
+  {
+    reset_sampling_profiler();
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    machine.State = &Large_State;
+    machine.Event = WORK_EVENT;
+
+    REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+
+    THEN("State Id is saturated")
+    {
+      REQUIRE(get_samples(0, PROFILE_STATE_MAX, WORK_EVENT) == 3);
+    }
+  }
+
+  GIVEN("A state handler dispatching the event of another state machine")
+  {
+    reset_sampling_profiler();
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    machine.State = &Outer_State;
+    machine.Event = WORK_EVENT;
+
+    REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+
+    THEN("Sample after the inner dispatch is attributed to the outer handler")
+    {
+      REQUIRE(get_samples(0, OUTER_STATE, WORK_EVENT) == 1);
+
+      profile_totals_t totals;
+      get_profile_totals(&totals);
+      REQUIRE(totals.Idle == 0);
+    }
+  }
+}
+
+SCENARIO("Profiler timer samples the CPU time of state handlers")
+{
+  GIVEN("A state handler burning CPU time while the profiler is running")
+  {
+    reset_sampling_profiler();
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    machine.State = &Spinning_State;
+    machine.Event = WORK_EVENT;
+
+    REQUIRE(start_sampling_profiler(1000));
+    REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+    REQUIRE(stop_sampling_profiler());
+
+    THEN("The handler is sampled")
+    {
+      REQUIRE(get_samples(0, SPINNING_STATE, WORK_EVENT) >= Spin_Samples);
+    }
+  }
+}
+
+SCENARIO("Profiler timer accepts the whole frequency range")
+{
+  GIVEN("The lowest frequency of one sample per second")
+  {
+    reset_sampling_profiler();
+    const bool started = start_sampling_profiler(1);
+    struct itimerval timer;
+    getitimer(ITIMER_PROF, &timer);
+    const bool stopped = stop_sampling_profiler();
+
+    THEN("The timer runs with the period of one second")
+    {
+      REQUIRE(started);
+      REQUIRE(stopped);
+      REQUIRE(timer.it_interval.tv_sec == 1);
+      REQUIRE(timer.it_interval.tv_usec == 0);
+    }
+  }
+
+  GIVEN("A profiler that is already running")
+  {
+    reset_sampling_profiler();
+    REQUIRE(start_sampling_profiler(100));
+    const bool restarted = start_sampling_profiler(100);
+    REQUIRE(stop_sampling_profiler());
+
+    THEN("The second start is rejected and the stop without a start is rejected")
+    {
+      REQUIRE_FALSE(restarted);
+      REQUIRE_FALSE(stop_sampling_profiler());
+    }
+  }
+
+  GIVEN("Frequencies out of the range")
+  {
+    THEN("The profiler is not started")
+    {
+      REQUIRE_FALSE(start_sampling_profiler(0));
+      REQUIRE_FALSE(start_sampling_profiler(1000001));
+    }
+  }
+}
+
+}
@@ -0,0 +1,247 @@
+/**
+ * \file
+ * \brief Transition coverage and handler time test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_coverage.h"
+
+namespace latency_histogram_test
+{
+extern uint64_t Fake_Cycles;
+}
+
+namespace state_coverage_test
+{
+
+using latency_histogram_test::Fake_Cycles;
+
+typedef enum
+{
+  ROOT_STATE = 1,
+  A_STATE,
+  A1_STATE,
+  B_STATE,
+}en_state_id;
+
+enum
+{
+  TO_B_EVENT = 1,
+  TO_A1_EVENT,
+};
+
+extern const state_t Root_State[1];
+extern const state_t Child_States[2];
+extern const state_t A_Child_States[1];
+
+state_machine_result_t root_handler(state_machine_t* const pState)
+{
+  Fake_Cycles += 100;
+  return traverse_state(pState, &Child_States[1]);
+}
+
+state_machine_result_t a1_handler(state_machine_t* const)
+{
+  Fake_Cycles += 10;
+  return EVENT_UN_HANDLED;
+}
+
+state_machine_result_t b_handler(state_machine_t* const pState)
+{
+  Fake_Cycles += 1000;
+  return traverse_state(pState, &A_Child_States[0]);
+}
+
+const state_t Root_State[1] =
+{
+  {root_handler, NULL, NULL, ROOT_STATE, NULL, Child_States, 0},
+};
+
+const state_t Child_States[2] =
+{
+  {NULL, NULL, NULL, A_STATE, &Root_State[0], A_Child_States, 1},
+  {b_handler, NULL, NULL, B_STATE, &Root_State[0], NULL, 1},
+};
+
+const state_t A_Child_States[1] =
+{
+  {a1_handler, NULL, NULL, A1_STATE, &Child_States[0], NULL, 2},
+};
+
+const state_t Unregistered_State = {b_handler, NULL, NULL, B_STATE, NULL, NULL, 0};
+
+const state_t Quoted_State[1] =
+{
+  {b_handler, NULL, NULL, B_STATE + 1, NULL, NULL, 0},
+};
+
+static const char* const Root_Names[] = {"Root"};
+static const char* const Child_Names[] = {"A", "B"};
+
+//! Registers the tables and dispatches A1 -> B -> A1 -> B
+static void run_state_machine(state_machine_t* const pMachine)
+{
+  REQUIRE(register_state_table(Root_State, 1, Root_Names));
+  REQUIRE(register_state_table(Child_States, 2, Child_Names));
+  REQUIRE(register_state_table(A_Child_States, 1, NULL));
+  reset_state_coverage();
+
+  state_machine_t * const machineList[] = {pMachine};
+  pMachine->State = &A_Child_States[0];
+  for(uint32_t count = 0; count < 3; count++)
+  {
+    pMachine->Event = (pMachine->State == &Child_States[1]) ? TO_A1_EVENT : TO_B_EVENT;
+    REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+  }
+}
+
+SCENARIO("Coverage counts the transitions and handler time of states")
+{
+  GIVEN("A hierarchical state machine switching between two states")
+  {
+    state_machine_t machine = {};
+    run_state_machine(&machine);
+
+    THEN("Transitions are counted from source to target state")
+    {
+      REQUIRE(get_transition_count(&A_Child_States[0], &Child_States[1]) == 2);
+      REQUIRE(get_transition_count(&Child_States[1], &A_Child_States[0]) == 1);
+      REQUIRE(get_transition_count(&Child_States[1], &Child_States[1]) == 0);
+    }
+
+    THEN("Handler time is accumulated per state")
+    {
+      state_coverage_t coverage;
+      REQUIRE(get_state_coverage(&Root_State[0], &coverage));
+      REQUIRE(coverage.Handler_Calls == 2);
+      REQUIRE(coverage.Handler_Cycles == 200);
+
+      REQUIRE(get_state_coverage(&A_Child_States[0], &coverage));
+      REQUIRE(coverage.Handler_Calls == 2);
+      REQUIRE(coverage.Handler_Cycles == 20);
+
+      REQUIRE(get_state_coverage(&Child_States[1], &coverage));
+      REQUIRE(coverage.Handler_Calls == 1);
+      REQUIRE(coverage.Handler_Cycles == 1000);
+    }
+
+    THEN("Transitions cost the time of handler calls that took them")
+    {
+      transition_coverage_t transition;
+      REQUIRE(get_transition_coverage(&A_Child_States[0], &Child_States[1], &transition));
+      REQUIRE(transition.Count == 2);
+      REQUIRE(transition.Cycles == 200);
+
+      REQUIRE(get_transition_coverage(&Child_States[1], &A_Child_States[0], &transition));
+      REQUIRE(transition.Count == 1);
+      REQUIRE(transition.Cycles == 1000);
+
+      // Transition out of the dispatcher has no handler time.
+      switch_state(&machine, &A_Child_States[0]);
+      state_machine_t * const machineList[] = {&machine};
+      machine.Event = TO_B_EVENT;
+      REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+
+      REQUIRE(get_transition_coverage(&Child_States[1], &A_Child_States[0], &transition));
+      REQUIRE(transition.Count == 2);
+      REQUIRE(transition.Cycles == 1000);
+      REQUIRE(get_transition_coverage(&A_Child_States[0], &Child_States[1], &transition));
+      REQUIRE(transition.Count == 3);
+      REQUIRE(transition.Cycles == 300);
+    }
+
+    THEN("States are registered only once for each Id")
+    {
+      REQUIRE(get_coverage_state_index(&Child_States[1]) == B_STATE);
+      REQUIRE_FALSE(register_state_table(&Unregistered_State, 1, NULL));
+      REQUIRE(get_coverage_state_index(&Child_States[1]) == B_STATE);
+    }
+
+    THEN("Transitions to the states out of the registered tables are counted separately")
+    {
+      state_coverage_t coverage;
+      REQUIRE(get_coverage_state_index(&Unregistered_State) == COVERAGE_UNKNOWN_STATE);
+      REQUIRE_FALSE(get_state_coverage(&Unregistered_State, &coverage));
+
+      const uint64_t unregistered = get_unregistered_transitions();
+      switch_state(&machine, &Unregistered_State);
+      REQUIRE(get_unregistered_transitions() == unregistered + 1);
+    }
+  }
+}
+
+SCENARIO("Coverage is exported as Graphviz graph of the state hierarchy")
+{
+  GIVEN("Coverage of a hierarchical state machine")
+  {
+    state_machine_t machine = {};
+    run_state_machine(&machine);
+
+    static const char* const Quoted_Names[] = {"say \"hi\" \\ bye"};
+    REQUIRE(register_state_table(Quoted_State, 1, Quoted_Names));
+
+    FILE* const pFile = std::tmpfile();
+    REQUIRE(pFile != nullptr);
+    export_state_coverage_dot(pFile);
+    std::rewind(pFile);
+
+    std::string graph;
+    char line[256];
+    while(std::fgets(line, sizeof(line), pFile) != nullptr)
+    {
+      graph += line;
+    }
+    std::fclose(pFile);
+
+    const uint32_t root = get_coverage_state_index(&Root_State[0]);
+    const uint32_t a = get_coverage_state_index(&Child_States[0]);
+    const uint32_t b = get_coverage_state_index(&Child_States[1]);
+    const uint32_t a1 = get_coverage_state_index(&A_Child_States[0]);
+
+    THEN("Composite states are clusters of their child states")
+    {
+      const size_t root_cluster = graph.find("subgraph cluster_s" + std::to_string(root) + " {");
+      const size_t a_cluster = graph.find("subgraph cluster_s" + std::to_string(a) + " {");
+      const size_t a1_node = graph.find("s" + std::to_string(a1) + " [label=\"state 3\\ncalls 2\\ncycles 20\"");
+      const size_t b_node = graph.find("s" + std::to_string(b) + " [label=\"B\\ncalls 1\\ncycles 1000\"");
+
+      REQUIRE(root_cluster != std::string::npos);
+      REQUIRE(a_cluster != std::string::npos);
+      REQUIRE(a1_node != std::string::npos);
+      REQUIRE(b_node != std::string::npos);
+      REQUIRE(root_cluster < a_cluster);
+      REQUIRE(a_cluster < a1_node);
+      REQUIRE(graph.find("label=\"Root\";") != std::string::npos);
+    }
+
+    THEN("Transitions are edges labelled with their count and cost")
+    {
+      const std::string frequent = "s" + std::to_string(a1) + " -> s" + std::to_string(b)
+                                   + " [label=\"2\\ncycles 200\", penwidth=8.00, color=\"0.533 1.000 0.900\"]";
+      const std::string costly = "s" + std::to_string(b) + " -> s" + std::to_string(a1)
+                                 + " [label=\"1\\ncycles 1000\", penwidth=4.50, color=\"0.000 1.000 0.900\"]";
+      REQUIRE(graph.find(frequent) != std::string::npos);
+      REQUIRE(graph.find(costly) != std::string::npos);
+    }
+
+    THEN("Quotes and backslashes of the state names are escaped")
+    {
+      REQUIRE(graph.find("[label=\"say \\\"hi\\\" \\\\ bye\\ncalls 0") != std::string::npos);
+    }
+  }
+}
+
+}
@@ -0,0 +1,164 @@
+/**
+ * \file
+ * \brief Time in state accounting test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_residency.h"
+
+namespace state_residency_test
+{
+
+typedef enum
+{
+  ON_STATE = 1,
+  BAKE_STATE,
+  TOAST_STATE,
+  OFF_STATE,
+}en_state_id;
+
+enum
+{
+  TO_TOAST_EVENT = 1,
+  TO_OFF_EVENT,
+};
+
+extern const state_t Top_States[2];
+extern const state_t On_Child_States[2];
+
+state_machine_result_t handler(state_machine_t* const pState_Machine)
+{
+  switch(pState_Machine->Event)
+  {
+  case TO_TOAST_EVENT:
+    return traverse_state(pState_Machine, &On_Child_States[1]);
+
+  case TO_OFF_EVENT:
+    return traverse_state(pState_Machine, &Top_States[1]);
+
+  default:
+    return EVENT_UN_HANDLED;
+  }
+}
+
+const state_t Top_States[2] =
+{
+  {NULL, NULL, NULL, ON_STATE, NULL, On_Child_States, 0},
+  {handler, NULL, NULL, OFF_STATE, NULL, NULL, 0},
+};
+
+const state_t On_Child_States[2] =
+{
+  {handler, NULL, NULL, BAKE_STATE, &Top_States[0], NULL, 1},
+  {handler, NULL, NULL, TOAST_STATE, &Top_States[0], NULL, 1},
+};
+
+static const uint64_t Stay_Time = 2000000;    // 2 ms in ns
+
+static void send_event(state_machine_t* const pState_Machine, uint32_t event)
+{
+  state_machine_t * const machineList[] = {pState_Machine};
+  pState_Machine->Event = event;
+  REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+}
+
+//! Bake -> Toast -> Off, staying 2 ms in Bake and Toast.
+static void run_oven(state_machine_t* const pOven)
+{
+  pOven->State = &On_Child_States[0];
+  start_state_residency(pOven);
+
+  std::this_thread::sleep_for(std::chrono::nanoseconds(Stay_Time));
+  send_event(pOven, TO_TOAST_EVENT);
+  std::this_thread::sleep_for(std::chrono::nanoseconds(Stay_Time));
+  send_event(pOven, TO_OFF_EVENT);
+}
+
+SCENARIO("Time in state is accounted at each transition")
+{
+  GIVEN("An oven that has baked, toasted and is now off")
+  {
+    state_machine_t oven = {};
+    run_oven(&oven);
+
+    THEN("Each state has the time spent in it")
+    {
+      REQUIRE(get_state_residency(&oven, BAKE_STATE) >= Stay_Time);
+      REQUIRE(get_state_residency(&oven, TOAST_STATE) >= Stay_Time);
+    }
+
+    THEN("Parent state has the time spent in its child states")
+    {
+      REQUIRE(get_state_residency(&oven, ON_STATE)
+              == get_state_residency(&oven, BAKE_STATE) + get_state_residency(&oven, TOAST_STATE));
+    }
+
+    THEN("Current state has the time since it is entered")
+    {
+      const uint64_t off_time = get_state_residency(&oven, OFF_STATE);
+      std::this_thread::sleep_for(std::chrono::nanoseconds(Stay_Time));
+      REQUIRE(get_state_residency(&oven, OFF_STATE) >= off_time + Stay_Time);
+    }
+
+    THEN("Restart clears the time in state")
+    {
+      start_state_residency(&oven);
+      REQUIRE(get_state_residency(&oven, TOAST_STATE) == 0);
+      REQUIRE(get_state_residency(&oven, HSM_RESIDENCY_MAX_STATES) == 0);
+    }
+  }
+
+  GIVEN("A state machine without start of accounting")
+  {
+    state_machine_t oven = {};
+    oven.State = &On_Child_States[0];
+    send_event(&oven, TO_TOAST_EVENT);
+
+    THEN("Accounting starts at the first transition")
+    {
+      REQUIRE(get_state_residency(&oven, BAKE_STATE) == 0);
+      REQUIRE(get_state_residency(&oven, TOAST_STATE) > 0);
+    }
+  }
+}
+
+SCENARIO("Fleet time in state is the sum of all state machines")
+{
+  GIVEN("A fleet of two ovens, one of them still baking")
+  {
+    state_machine_t oven = {};
+    state_machine_t baking = {};
+    state_machine_t * const fleet[] = {&oven, &baking};
+
+    baking.State = &On_Child_States[0];
+    start_state_residency(&baking);
+    run_oven(&oven);
+
+    THEN("Fleet time is counted in the states and their parents")
+    {
+      uint64_t residency[HSM_RESIDENCY_MAX_STATES];
+      get_fleet_residency(fleet, 2, residency);
+
+      REQUIRE(residency[BAKE_STATE] >= 2 * Stay_Time);
+      REQUIRE(residency[TOAST_STATE] >= Stay_Time);
+      REQUIRE(residency[ON_STATE] == residency[BAKE_STATE] + residency[TOAST_STATE]);
+      REQUIRE(residency[OFF_STATE] > 0);
+      REQUIRE(residency[0] == 0);
+    }
+  }
+}
+
+}
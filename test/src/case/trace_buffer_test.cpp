@@ -0,0 +1,457 @@
+/**
+ * \file
+ * \brief Binary trace buffer test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_event.h"
+#include "hsm_trace.h"
+
+namespace trace_buffer_test
+{
+
+typedef enum
+{
+  ROOT_STATE = 1,
+  A_STATE,
+  A1_STATE,
+  B_STATE,
+}en_state_id;
+
+extern const state_t Root_State;
+extern const state_t Child_States[2];
+extern const state_t A_Child_States[1];
+
+state_machine_result_t root_handler(state_machine_t* const pState)
+{
+  return traverse_state(pState, &Child_States[1]);
+}
+
+state_machine_result_t a1_handler(state_machine_t* const)
+{
+  return EVENT_UN_HANDLED;
+}
+
+state_machine_result_t b_handler(state_machine_t* const)
+{
+  return EVENT_HANDLED;
+}
+
+const state_t Root_State = {root_handler, NULL, NULL, ROOT_STATE, NULL, Child_States, 0};
+
+const state_t Child_States[2] =
+{
+  {NULL, NULL, NULL, A_STATE, &Root_State, A_Child_States, 1},
+  {b_handler, NULL, NULL, B_STATE, &Root_State, NULL, 1},
+};
+
+const state_t A_Child_States[1] =
+{
+  {a1_handler, NULL, NULL, A1_STATE, &Child_States[0], NULL, 2},
+};
+
+static event_pool_t Pool;
+static state_machine_t* pReceiver;
+
+//! Posts an event object to the receiver state machine.
+state_machine_result_t sender_handler(state_machine_t* const)
+{
+  post_event(pReceiver, allocate_event(&Pool, 9));
+  return EVENT_HANDLED;
+}
+
+const state_t Sender_State = {sender_handler, NULL, NULL, ROOT_STATE, NULL, NULL, 0};
+
+//! Trace buffer of calling thread, after discarding the records of previous tests in all buffers.
+static trace_buffer_t* get_empty_buffer(void)
+{
+  trace_buffer_t* const pBuffer = (Trace_Buffer != NULL) ? Trace_Buffer : claim_trace_buffer();
+  trace_record_t records[HSM_TRACE_BUFFER_SIZE];
+  for(uint32_t index = 0; index < get_trace_buffer_count(); index++)
+  {
+    trace_buffer_t* const pOther = get_trace_buffer(index);
+    while(read_trace(pOther, records, HSM_TRACE_BUFFER_SIZE) != 0)
+    {
+    }
+    pOther->Dropped = 0;
+  }
+  return pBuffer;
+}
+
+static std::vector<trace_record_t> read_all(trace_buffer_t* const pBuffer)
+{
+  std::vector<trace_record_t> records(HSM_TRACE_BUFFER_SIZE);
+  records.resize(read_trace(pBuffer, records.data(), HSM_TRACE_BUFFER_SIZE));
+  return records;
+}
+
+SCENARIO("Trace buffer records dispatch, bubbling and transitions")
+{
+  GIVEN("A hierarchical state machine in the deepest state")
+  {
+    trace_buffer_t* const pBuffer = get_empty_buffer();
+    state_machine_t idle = {};
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&idle, &machine};
+    idle.State = &Child_States[1];
+    machine.State = &A_Child_States[0];
+    machine.Event = 5;
+
+    REQUIRE(dispatch_event(machineList, 2) == EVENT_HANDLED);
+    const std::vector<trace_record_t> records = read_all(pBuffer);
+
+    THEN("Every step of the event processing is recorded in order")
+    {
+      struct expected_record
+      {
+        trace_record_type_t Type;
+        uint32_t State;
+        uint32_t Aux;
+        state_machine_result_t Result;
+      };
+
+      const std::vector<expected_record> expected =
+      {
+        {TRACE_DISPATCH, A1_STATE, 0, EVENT_HANDLED},
+        {TRACE_RESULT, A1_STATE, A1_STATE, EVENT_UN_HANDLED},
+        {TRACE_BUBBLE, A1_STATE, A_STATE, EVENT_HANDLED},
+        {TRACE_BUBBLE, A_STATE, ROOT_STATE, EVENT_HANDLED},
+        {TRACE_DISPATCH, ROOT_STATE, 0, EVENT_HANDLED},
+        {TRACE_TRANSITION, A1_STATE, B_STATE, EVENT_HANDLED},
+        {TRACE_EXIT, A1_STATE, 0, EVENT_HANDLED},
+        {TRACE_EXIT, A_STATE, 0, EVENT_HANDLED},
+        {TRACE_ENTRY, B_STATE, 0, EVENT_HANDLED},
+        {TRACE_RESULT, ROOT_STATE, B_STATE, EVENT_HANDLED},
+      };
+
+      REQUIRE(records.size() == expected.size());
+      for(size_t index = 0; index < expected.size(); index++)
+      {
+        INFO("record " << index);
+        REQUIRE(records[index].Type == expected[index].Type);
+        REQUIRE(records[index].State == expected[index].State);
+        REQUIRE(records[index].Aux == expected[index].Aux);
+        REQUIRE(records[index].Result == expected[index].Result);
+        REQUIRE(records[index].Event == 5);
+        REQUIRE(records[index].Machine == 1);
+        if(index != 0)
+        {
+          REQUIRE(records[index].Timestamp >= records[index - 1].Timestamp);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Trace buffer links the post of event object to its dispatch")
+{
+  GIVEN("A state machine posting an event object to other state machine")
+  {
+    trace_buffer_t* const pBuffer = get_empty_buffer();
+    event_t events[2];
+    state_machine_t sender = {};
+    state_machine_t receiver = {};
+    state_machine_t * const machineList[] = {&sender, &receiver};
+    init_event_pool(&Pool, events, sizeof(event_t), 2);
+    sender.State = &Sender_State;
+    sender.Event = 1;
+    receiver.State = &Child_States[1];
+    pReceiver = &receiver;
+
+    REQUIRE(dispatch_event(machineList, 2) == EVENT_HANDLED);
+    const std::vector<trace_record_t> records = read_all(pBuffer);
+
+    THEN("Post is recorded by the sender and the dispatch carries the same flow id")
+    {
+      REQUIRE(records.size() == 5);
+      REQUIRE(records[1].Type == TRACE_POST);
+      REQUIRE(records[1].Machine == 0);
+      REQUIRE(records[1].Event == 9);
+      REQUIRE(records[1].Aux != 0);
+
+      REQUIRE(records[0].Type == TRACE_DISPATCH);
+      REQUIRE(records[0].Aux == 0);
+      REQUIRE(records[3].Type == TRACE_DISPATCH);
+      REQUIRE(records[3].Machine == 1);
+      REQUIRE(records[3].Event == 9);
+      REQUIRE(records[3].Aux == records[1].Aux);
+    }
+
+    THEN("Post outside of the dispatcher has no state machine")
+    {
+      post_event(&receiver, allocate_event(&Pool, 10));
+      const std::vector<trace_record_t> post = read_all(pBuffer);
+      REQUIRE(post.size() == 1);
+      REQUIRE(post[0].Machine == TRACE_UNKNOWN_MACHINE);
+      REQUIRE(dispatch_event(machineList, 2) == EVENT_HANDLED);
+    }
+  }
+}
+
+SCENARIO("Trace buffer drops records when the consumer is late")
+{
+  GIVEN("More records than the capacity of trace buffer")
+  {
+    trace_buffer_t* const pBuffer = get_empty_buffer();
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    machine.State = &Child_States[1];
+
+    // Each dispatch records the dispatch and its result.
+    for(uint32_t event = 1; event <= HSM_TRACE_BUFFER_SIZE; event++)
+    {
+      machine.Event = event;
+      REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+    }
+
+    THEN("The oldest records are kept and the rest are counted as dropped")
+    {
+      const std::vector<trace_record_t> records = read_all(pBuffer);
+      REQUIRE(records.size() == HSM_TRACE_BUFFER_SIZE);
+      REQUIRE(records.front().Event == 1);
+      REQUIRE(records.back().Event == HSM_TRACE_BUFFER_SIZE / 2);
+      REQUIRE(pBuffer->Dropped == HSM_TRACE_BUFFER_SIZE);
+    }
+
+    THEN("The dump contains the records and the dropped count")
+    {
+      FILE* const pFile = std::tmpfile();
+      REQUIRE(pFile != nullptr);
+      REQUIRE(dump_trace(pFile) == HSM_TRACE_BUFFER_SIZE);
+      std::rewind(pFile);
+
+      trace_dump_header_t header;
+      REQUIRE(std::fread(&header, sizeof(header), 1, pFile) == 1);
+      REQUIRE(header.Magic == TRACE_DUMP_MAGIC);
+      REQUIRE(header.Version == TRACE_DUMP_VERSION);
+      REQUIRE(header.Record_Size == sizeof(trace_record_t));
+
+      uint32_t records = 0;
+      uint32_t dropped = 0;
+      trace_dump_block_t block;
+      while(std::fread(&block, sizeof(block), 1, pFile) == 1)
+      {
+        records += block.Count;
+        dropped += block.Dropped;
+        REQUIRE(std::fseek(pFile, (long)(block.Count * sizeof(trace_record_t)), SEEK_CUR) == 0);
+      }
+      std::fclose(pFile);
+
+      REQUIRE(records == HSM_TRACE_BUFFER_SIZE);
+      REQUIRE(dropped == HSM_TRACE_BUFFER_SIZE);
+      REQUIRE(read_all(pBuffer).empty());
+    }
+  }
+}
+
+SCENARIO("Each thread records into its own trace buffer")
+{
+  GIVEN("A state machine dispatched from other thread")
+  {
+    trace_buffer_t* const pBuffer = get_empty_buffer();
+    trace_buffer_t* pThread_Buffer = nullptr;
+
+    std::thread worker([&pThread_Buffer]()
+    {
+      state_machine_t machine = {};
+      state_machine_t * const machineList[] = {&machine};
+      machine.State = &Child_States[1];
+      machine.Event = 7;
+      dispatch_event(machineList, 1);
+      pThread_Buffer = Trace_Buffer;
+    });
+    worker.join();
+
+    THEN("Records are in the trace buffer of that thread")
+    {
+      REQUIRE(pThread_Buffer != nullptr);
+      REQUIRE(pThread_Buffer != pBuffer);
+      REQUIRE(read_all(pBuffer).empty());
+
+      const std::vector<trace_record_t> records = read_all(pThread_Buffer);
+      REQUIRE(records.size() == 2);
+      REQUIRE(records[0].Type == TRACE_DISPATCH);
+      REQUIRE(records[1].Type == TRACE_RESULT);
+      REQUIRE(records[1].Event == 7);
+    }
+  }
+}
+
+// The dump is decoded by the hsm_trace_decode tests, see tools/hsm_trace_decode/CMakeLists.txt.
+SCENARIO("Trace dump of two threads dispatching their own state machine arrays")
+{
+  GIVEN("A state machine at index 0 on this thread and on other thread")
+  {
+    get_empty_buffer();
+    auto dispatch = [](uint32_t event)
+    {
+      state_machine_t machine = {};
+      state_machine_t * const machineList[] = {&machine};
+      machine.State = &A_Child_States[0];
+      machine.Event = event;
+      dispatch_event(machineList, 1);
+    };
+    dispatch(5);
+    std::thread worker(dispatch, 6);
+    worker.join();
+
+    THEN("The dump of both threads is written to hsm_trace_dump.bin")
+    {
+      FILE* const pFile = std::fopen("hsm_trace_dump.bin", "wb");
+      REQUIRE(pFile != nullptr);
+      const uint32_t records = dump_trace(pFile);
+      std::fclose(pFile);
+      REQUIRE(records == 20);
+    }
+  }
+}
+
+SCENARIO("Trace dump of an event object posted again after its dispatch")
+{
+  GIVEN("A state machine receiving two posts of the same pool block")
+  {
+    get_empty_buffer();
+    event_t events[2];
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    init_event_pool(&Pool, events, sizeof(event_t), 2);
+
+    // Each event bubbles from A1 to the root state, that transitions to B.
+    machine.State = &A_Child_States[0];
+    event_t* const pFirst = allocate_event(&Pool, 5);
+    post_event(&machine, pFirst);
+    REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+
+    machine.State = &A_Child_States[0];
+    event_t* const pSecond = allocate_event(&Pool, 6);
+    post_event(&machine, pSecond);
+    REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+
+    THEN("The dump is written to hsm_trace_post_dump.bin")
+    {
+      REQUIRE(pFirst == pSecond);   // Both posts have the same flow id
+      FILE* const pFile = std::fopen("hsm_trace_post_dump.bin", "wb");
+      REQUIRE(pFile != nullptr);
+      const uint32_t records = dump_trace(pFile);
+      std::fclose(pFile);
+      REQUIRE(records == 22);
+    }
+  }
+}
+
+SCENARIO("Trace buffers of the exited threads are reused")
+{
+  GIVEN("More threads than the trace buffers, each recording after the previous one has exited")
+  {
+    get_empty_buffer();
+    const uint32_t untraced = get_untraced_records();
+
+    for(uint32_t thread = 0; thread < 2 * HSM_TRACE_MAX_THREADS; thread++)
+    {
+      std::thread worker([]()
+      {
+        state_machine_t machine = {};
+        state_machine_t * const machineList[] = {&machine};
+        machine.State = &Child_States[1];
+        machine.Event = 1;
+        dispatch_event(machineList, 1);
+      });
+      worker.join();
+    }
+
+    THEN("Each thread records in a trace buffer")
+    {
+      REQUIRE(get_trace_buffer_count() <= HSM_TRACE_MAX_THREADS);
+      REQUIRE(get_untraced_records() == untraced);
+
+      uint32_t results = 0;
+      trace_record_t records[HSM_TRACE_BUFFER_SIZE];
+      for(uint32_t index = 0; index < get_trace_buffer_count(); index++)
+      {
+        const uint32_t count = read_trace(get_trace_buffer(index), records, HSM_TRACE_BUFFER_SIZE);
+        for(uint32_t record = 0; record < count; record++)
+        {
+          results += (records[record].Type == TRACE_RESULT) ? 1 : 0;
+        }
+      }
+      REQUIRE(results == 2 * HSM_TRACE_MAX_THREADS);
+    }
+  }
+}
+
+SCENARIO("Trace buffer is read while other thread dispatches")
+{
+  GIVEN("A state machine dispatched repeatedly from other thread")
+  {
+    static const uint32_t DISPATCHES = 20000;
+    get_empty_buffer();
+    std::atomic<trace_buffer_t*> pThread_Buffer(nullptr);
+    std::atomic<bool> done(false);
+
+    std::thread worker([&pThread_Buffer, &done]()
+    {
+      pThread_Buffer.store(claim_trace_buffer());
+      state_machine_t machine = {};
+      state_machine_t * const machineList[] = {&machine};
+      for(uint32_t event = 1; event <= DISPATCHES; event++)
+      {
+        // Each dispatch bubbles from A1 to the root state, that transitions to B.
+        machine.State = &A_Child_States[0];
+        machine.Event = event;
+        dispatch_event(machineList, 1);
+      }
+      done.store(true);
+    });
+
+    THEN("Each record is complete when the consumer reads it")
+    {
+      while(pThread_Buffer.load() == nullptr)
+      {
+        std::this_thread::yield();
+      }
+
+      uint32_t results = 0;
+      bool complete = true;
+      trace_record_t records[16];
+      bool finished = false;
+      do
+      {
+        finished = done.load();   // Drain once more after the worker is done.
+        uint32_t count;
+        while((count = read_trace(pThread_Buffer.load(), records, 16)) != 0)
+        {
+          for(uint32_t index = 0; index < count; index++)
+          {
+            if(records[index].Type == TRACE_RESULT)
+            {
+              const uint8_t expected = (records[index].State == A1_STATE) ? EVENT_UN_HANDLED : EVENT_HANDLED;
+              complete = complete && (records[index].Result == expected);
+              results++;
+            }
+          }
+        }
+      }while(!finished);
+      worker.join();
+
+      REQUIRE(complete);
+      REQUIRE(results != 0);
+    }
+  }
+}
+
+}
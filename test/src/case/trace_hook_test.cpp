@@ -0,0 +1,187 @@
+/**
+ * \file
+ * \brief Compile time trace hooks test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_event.h"
+
+namespace trace_hook_test
+{
+
+//! Trace recorded by the hooks, as "<hook>:<state id>" strings.
+static std::vector<std::string> Trace;
+static bool Trace_Enabled = false;
+
+static void record(const char* const hook, uint32_t id)
+{
+  if(Trace_Enabled)
+  {
+    Trace.push_back(std::string(hook) + ":" + std::to_string(id));
+  }
+}
+
+typedef enum
+{
+  ROOT_STATE = 1,
+  A_STATE,
+  A1_STATE,
+  B_STATE,
+}en_state_id;
+
+extern const state_t Root_State;
+extern const state_t Child_States[2];
+extern const state_t A_Child_States[1];
+
+state_machine_result_t root_handler(state_machine_t* const pState)
+{
+  return traverse_state(pState, &Child_States[1]);
+}
+
+state_machine_result_t a1_handler(state_machine_t* const)
+{
+  return EVENT_UN_HANDLED;
+}
+
+state_machine_result_t b_handler(state_machine_t* const pState)
+{
+  return switch_state(pState, &Child_States[0]);
+}
+
+const state_t Root_State = {root_handler, NULL, NULL, ROOT_STATE, NULL, Child_States, 0};
+
+const state_t Child_States[2] =
+{
+  // A state doesn't have handler, event bubbles from A1 to root state.
+  {NULL, NULL, NULL, A_STATE, &Root_State, A_Child_States, 1},
+  {b_handler, NULL, NULL, B_STATE, &Root_State, NULL, 1},
+};
+
+const state_t A_Child_States[1] =
+{
+  {a1_handler, NULL, NULL, A1_STATE, &Child_States[0], NULL, 2},
+};
+
+SCENARIO("Trace hooks observe dispatch, bubbling and transitions")
+{
+  GIVEN("A hierarchical state machine in the deepest state")
+  {
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    machine.State = &A_Child_States[0];
+    machine.Event = 1;
+
+    Trace.clear();
+    Trace_Enabled = true;
+    const state_machine_result_t result = dispatch_event(machineList, 1);
+    Trace_Enabled = false;
+
+    THEN("Every step of the event processing is traced")
+    {
+      REQUIRE(result == EVENT_HANDLED);
+      const std::vector<std::string> expected =
+      {
+        "event:3", "result:3",
+        "bubble:3", "bubble:2",
+        "event:1",
+        "transition:3", "exit:3", "exit:2", "entry:4",
+        "result:4",
+      };
+      REQUIRE(Trace == expected);
+    }
+  }
+}
+
+SCENARIO("Post hook observes the event object before the dispatcher")
+{
+  GIVEN("A state machine and a pool of event objects")
+  {
+    state_machine_t machine = {};
+    state_machine_t * const machineList[] = {&machine};
+    machine.State = &A_Child_States[0];
+
+    event_t storage[2];
+    event_pool_t pool;
+    init_event_pool(&pool, storage, sizeof(event_t), 2);
+
+    WHEN("Event objects are posted and dispatched")
+    {
+      Trace.clear();
+      Trace_Enabled = true;
+      post_event(&machine, allocate_event(&pool, 5));
+      post_event(&machine, allocate_event(&pool, 6));
+      const state_machine_result_t result = dispatch_event(machineList, 1);
+      Trace_Enabled = false;
+
+      THEN("Each post is traced in posting order, before the event processing")
+      {
+        REQUIRE(result == EVENT_HANDLED);
+        REQUIRE(Trace.size() > 2);
+        REQUIRE(Trace[0] == "post:5");
+        REQUIRE(Trace[1] == "post:6");
+      }
+    }
+  }
+}
+
+}
+
+extern "C"
+{
+
+void state_machine_event_logger(uint32_t, uint32_t state, uint32_t)
+{
+  trace_hook_test::record("event", state);
+}
+
+void state_machine_result_logger(uint32_t state, state_machine_result_t)
+{
+  trace_hook_test::record("result", state);
+}
+
+void trace_bubble_hook(const void*, const void* pState, const void*)
+{
+  trace_hook_test::record("bubble", static_cast<const state_t*>(pState)->Id);
+}
+
+void trace_transition_hook(const void*, const void* pSource, const void*)
+{
+  trace_hook_test::record("transition", static_cast<const state_t*>(pSource)->Id);
+}
+
+void trace_exit_hook(const void*, const void* pState)
+{
+  trace_hook_test::record("exit", static_cast<const state_t*>(pState)->Id);
+}
+
+void trace_entry_hook(const void*, const void* pState)
+{
+  trace_hook_test::record("entry", static_cast<const state_t*>(pState)->Id);
+}
+
+void trace_post_hook(const void* pState_Machine, const void* pEvent)
+{
+  // The event object is not yet in the inbox of state machine.
+  const event_t* const pObject = static_cast<const event_t*>(pEvent);
+  const event_t* pQueued = static_cast<const state_machine_t*>(pState_Machine)->Inbox;
+  while((pQueued != NULL) && (pQueued != pObject))
+  {
+    pQueued = pQueued->Next;
+  }
+  trace_hook_test::record((pQueued == NULL) ? "post" : "queued", pObject->Id);
+}
+
+}
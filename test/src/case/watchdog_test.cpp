@@ -0,0 +1,282 @@
+/**
+ * \file
+ * \brief Watchdog of slow and blocked state handlers test
+
+ * \author  Nandkishor Biradar
+ * \date  18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "catch.hpp"
+#include "hsm.h"
+#include "hsm_watchdog.h"
+
+namespace watchdog_test
+{
+
+enum
+{
+  WORK_EVENT = 1,
+};
+
+enum
+{
+  SLOW_STATE = 1,
+  FAST_STATE,
+  ENTRY_STATE,
+  BLOCKED_STATE,
+};
+
+static const uint64_t Threshold = 1000000;          // 1 ms in ns
+static const auto Slow_Time = std::chrono::milliseconds(3);
+
+static std::atomic<uint32_t> Handler_Calls;
+static std::atomic<bool> Blocked_Reported;
+
+static void violation_handler(const watchdog_violation_t* const pViolation)
+{
+  Handler_Calls++;
+  if(pViolation->Blocked)
+  {
+    Blocked_Reported = true;
+  }
+}
+
+state_machine_result_t slow_handler(state_machine_t* const)
+{
+  std::this_thread::sleep_for(Slow_Time);
+  return EVENT_HANDLED;
+}
+
+state_machine_result_t fast_handler(state_machine_t* const)
+{
+  return EVENT_HANDLED;
+}
+
+state_machine_result_t slow_entry(state_machine_t* const)
+{
+  std::this_thread::sleep_for(Slow_Time);
+  return EVENT_HANDLED;
+}
+
+extern const state_t Entry_State;
+
+state_machine_result_t switch_handler(state_machine_t* const pState_Machine)
+{
+  return switch_state(pState_Machine, &Entry_State);
+}
+
+state_machine_result_t blocked_handler(state_machine_t* const)
+{
+  // Wait till the watchdog thread detects the call, or give up after 2 seconds.
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while(!Blocked_Reported && (std::chrono::steady_clock::now() < deadline))
+  {
+    std::this_thread::yield();
+  }
+  return EVENT_HANDLED;
+}
+
+const state_t Slow_State = {slow_handler, NULL, NULL, SLOW_STATE, NULL, NULL, 0};
+const state_t Fast_State = {fast_handler, NULL, NULL, FAST_STATE, NULL, NULL, 0};
+const state_t Switch_State = {switch_handler, NULL, NULL, FAST_STATE, NULL, NULL, 0};
+const state_t Entry_State = {fast_handler, slow_entry, NULL, ENTRY_STATE, NULL, NULL, 0};
+const state_t Blocked_State = {blocked_handler, NULL, NULL, BLOCKED_STATE, NULL, NULL, 0};
+
+static watchdog_violation_t dispatch(const state_t* const pState, uint64_t* const pCount)
+{
+  state_machine_t machine = {};
+  state_machine_t * const machineList[] = {&machine};
+  machine.State = pState;
+  machine.Event = WORK_EVENT;
+
+  const uint64_t count = get_watchdog_violation_count();
+  REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+  *pCount = get_watchdog_violation_count() - count;
+
+  watchdog_violation_t violation = {};
+  read_watchdog_violations(&violation, 1);
+  return violation;
+}
+
+SCENARIO("Watchdog reports the calls slower than their threshold")
+{
+  GIVEN("A global threshold of state handlers and entry actions")
+  {
+    Handler_Calls = 0;
+    set_watchdog_threshold(WATCHDOG_HANDLER, Threshold);
+    set_watchdog_threshold(WATCHDOG_ENTRY, Threshold);
+    set_watchdog_handler(violation_handler);
+
+    WHEN("State handler is slower than the threshold")
+    {
+      uint64_t count;
+      const watchdog_violation_t violation = dispatch(&Slow_State, &count);
+
+      THEN("Slow call is reported to the handler")
+      {
+        REQUIRE(count == 1);
+        REQUIRE(Handler_Calls == 1);
+        REQUIRE(violation.State == &Slow_State);
+        REQUIRE(violation.Event == WORK_EVENT);
+        REQUIRE(violation.Kind == WATCHDOG_HANDLER);
+        REQUIRE(violation.Blocked == 0);
+        REQUIRE(violation.Duration > Threshold);
+      }
+    }
+
+    WHEN("State handler is faster than the threshold")
+    {
+      uint64_t count;
+      dispatch(&Fast_State, &count);
+
+      THEN("Nothing is reported")
+      {
+        REQUIRE(count == 0);
+        REQUIRE(Handler_Calls == 0);
+      }
+    }
+
+    WHEN("Entry action is slower than the threshold")
+    {
+      uint64_t count;
+      dispatch(&Switch_State, &count);
+
+      THEN("Slow entry action is reported, followed by the handler that called it")
+      {
+        REQUIRE(count == 2);
+
+        watchdog_violation_t violations[2];
+        REQUIRE(read_watchdog_violations(violations, 2) == 2);
+        REQUIRE(violations[0].State == &Entry_State);
+        REQUIRE(violations[0].Kind == WATCHDOG_ENTRY);
+        REQUIRE(violations[1].State == &Switch_State);
+        REQUIRE(violations[1].Kind == WATCHDOG_HANDLER);
+      }
+    }
+
+    WHEN("State has its own threshold higher than the call")
+    {
+      REQUIRE(set_state_watchdog_threshold(SLOW_STATE, 1000 * Threshold));
+      uint64_t count;
+      dispatch(&Slow_State, &count);
+      set_state_watchdog_threshold(SLOW_STATE, 0);
+
+      THEN("State threshold replaces the global threshold")
+      {
+        REQUIRE(count == 0);
+      }
+    }
+
+    THEN("State Id out of range of the table has no threshold")
+    {
+      REQUIRE_FALSE(set_state_watchdog_threshold(HSM_WATCHDOG_MAX_STATES, Threshold));
+    }
+
+    set_watchdog_threshold(WATCHDOG_HANDLER, 0);
+    set_watchdog_threshold(WATCHDOG_ENTRY, 0);
+    set_watchdog_handler(NULL);
+  }
+}
+
+SCENARIO("Watchdog thread reports the blocked calls")
+{
+  GIVEN("A running watchdog thread")
+  {
+    Handler_Calls = 0;
+    Blocked_Reported = false;
+    set_watchdog_threshold(WATCHDOG_HANDLER, 5 * Threshold);
+    set_watchdog_handler(violation_handler);
+    REQUIRE(start_watchdog_thread(1));
+    REQUIRE_FALSE(start_watchdog_thread(1));
+
+    WHEN("State handler doesn't return")
+    {
+      state_machine_t machine = {};
+      state_machine_t * const machineList[] = {&machine};
+      machine.State = &Blocked_State;
+      machine.Event = WORK_EVENT;
+      REQUIRE(dispatch_event(machineList, 1) == EVENT_HANDLED);
+
+      THEN("Call is reported once as blocked, and not again as slow when it returns")
+      {
+        REQUIRE(Blocked_Reported);
+        REQUIRE(Handler_Calls == 1);
+
+        watchdog_violation_t violations[1];
+        REQUIRE(read_watchdog_violations(violations, 1) == 1);
+        REQUIRE(violations[0].Blocked == 1);
+        REQUIRE(violations[0].State == &Blocked_State);
+        REQUIRE(violations[0].Machine == &machine);
+      }
+    }
+
+    stop_watchdog_thread();
+    set_watchdog_threshold(WATCHDOG_HANDLER, 0);
+    set_watchdog_handler(NULL);
+  }
+}
+
+SCENARIO("Violations are read while other thread reports them")
+{
+  GIVEN("A thread dispatching a state machine with calls slower than the threshold")
+  {
+    set_watchdog_threshold(WATCHDOG_HANDLER, 1);
+
+    state_machine_t machine = {};
+    const uint64_t first = get_watchdog_violation_count();
+    std::atomic<bool> done(false);
+    std::thread worker([&machine, &done]()
+    {
+      state_machine_t * const machineList[] = {&machine};
+      machine.State = &Fast_State;
+      for(uint32_t count = 0; count < 20000; count++)
+      {
+        machine.Event = WORK_EVENT;
+        dispatch_event(machineList, 1);
+      }
+      done = true;
+    });
+
+    THEN("Each copied violation is consistent")
+    {
+      watchdog_violation_t violations[HSM_WATCHDOG_VIOLATIONS];
+      bool consistent = true;
+      bool finished = false;
+      while(!finished && consistent)
+      {
+        finished = done;
+        // Read once the violations of earlier tests are overwritten.
+        if(get_watchdog_violation_count() - first < HSM_WATCHDOG_VIOLATIONS)
+        {
+          continue;
+        }
+
+        const uint32_t count = read_watchdog_violations(violations, HSM_WATCHDOG_VIOLATIONS);
+        for(uint32_t index = 0; index < count; index++)
+        {
+          consistent = consistent && (violations[index].Machine == &machine)
+                       && (violations[index].State == &Fast_State)
+                       && (violations[index].Event == WORK_EVENT)
+                       && (violations[index].Kind == WATCHDOG_HANDLER);
+        }
+      }
+      worker.join();
+      REQUIRE(consistent);
+      REQUIRE(read_watchdog_violations(violations, HSM_WATCHDOG_VIOLATIONS) == HSM_WATCHDOG_VIOLATIONS);
+    }
+
+    set_watchdog_threshold(WATCHDOG_HANDLER, 0);
+  }
+}
+
+}
@@ -0,0 +1,212 @@
+/**
+ * \file
+ * \brief Reference engine of the state machine framework
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// The reference engine is the specification of the dispatcher and the state transitions, used by the
+// differential test to check the engine of framework in hsm.c. It is written for clarity, without the
+// instrumentation points and without any optimization, and it must not change with hsm.c. Change it only
+// when the behaviour of the framework changes on purpose.
+//
+// The semantics it defines:
+//  - dispatch_event calls the handler of the current state of the first state machine with a pending Event.
+//    EVENT_HANDLED clears the Event. EVENT_HANDLED and TRIGGERED_TO_SELF restart from the first state machine.
+//    EVENT_UN_HANDLED passes the Event to the nearest parent state with a handler, and is returned when
+//    the top state doesn't handle it. Any other result is returned.
+//  - A transition exits the source state and its parent states up to the child state of the common parent,
+//    then enters the child state of the common parent and its child states down to the target state.
+//    A transition to the state itself or to its parent state exits and enters that state again.
+//  - The current state is the target state before the first exit action. An exit or entry action returning
+//    TRIGGERED_TO_SELF makes the transition return it. Any other result than EVENT_HANDLED stops the
+//    transition and is returned.
+// Event objects and asynchronous completion are not part of the reference engine.
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hsm_reference.h"
+
+/*
+ *  --------------------- STATIC FUNCTION ---------------------
+ */
+
+/** \brief Call an exit or entry action and merge its result with the result of transition.
+ *
+ * \param pState_Machine state_machine_t* const   state machine
+ * \param action state_handler                    exit or entry action, NULL if none
+ * \param pResult state_machine_result_t* const   result of transition so far
+ * \return bool                                   false if the transition must stop
+ *
+ */
+static bool call_action(state_machine_t* const pState_Machine, state_handler action,
+                        state_machine_result_t* const pResult)
+{
+  if(action == NULL)
+  {
+    return true;
+  }
+
+  const state_machine_result_t result = action(pState_Machine);
+  if(result == TRIGGERED_TO_SELF)
+  {
+    *pResult = TRIGGERED_TO_SELF;
+  }
+  else if(result != EVENT_HANDLED)
+  {
+    *pResult = result;
+    return false;
+  }
+  return true;
+}
+
+#if HIERARCHICAL_STATES
+//! Parent state of pState at the level, pState itself at its own level.
+static const state_t* get_ancestor(const state_t* pState, uint32_t level)
+{
+  while(pState->Level > level)
+  {
+    pState = pState->Parent;
+  }
+  return pState;
+}
+
+//! Enter the states from the level down to pTarget, parent state first.
+static bool enter_down(state_machine_t* const pState_Machine, const state_t* const pTarget, uint32_t level,
+                       state_machine_result_t* const pResult)
+{
+  if((pTarget->Level > level) && !enter_down(pState_Machine, pTarget->Parent, level, pResult))
+  {
+    return false;
+  }
+  return call_action(pState_Machine, pTarget->Entry, pResult);
+}
+#endif // HIERARCHICAL_STATES
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+/** \brief Dispatch the pending events to the state machines, as dispatch_event does.
+ *
+ * \param pState_Machine[] state_machine_t* const  array of state machines
+ * \param quantity uint32_t                        number of state machines
+ * \return state_machine_result_t                  result of state machine
+ *
+ */
+state_machine_result_t reference_dispatch_event(state_machine_t* const pState_Machine[], uint32_t quantity)
+{
+  uint32_t index = 0;
+  while(index < quantity)
+  {
+    state_machine_t* const pMachine = pState_Machine[index];
+    if(pMachine->Event == 0)
+    {
+      index++;
+      continue;
+    }
+
+    const state_t* pState = pMachine->State;
+    state_machine_result_t result = pState->Handler(pMachine);
+#if HIERARCHICAL_STATES
+    while(result == EVENT_UN_HANDLED)
+    {
+      do
+      {
+        pState = pState->Parent;
+        if(pState == NULL)
+        {
+          return EVENT_UN_HANDLED;
+        }
+      }while(pState->Handler == NULL);
+      result = pState->Handler(pMachine);
+    }
+#endif // HIERARCHICAL_STATES
+
+    if(result == EVENT_HANDLED)
+    {
+      pMachine->Event = 0;
+    }
+    else if(result != TRIGGERED_TO_SELF)
+    {
+      return result;
+    }
+    index = 0;
+  }
+  return EVENT_HANDLED;
+}
+
+/** \brief Switch to the target state, as switch_state does.
+ *
+ * \param pState_Machine state_machine_t* const   state machine
+ * \param pTarget_State const state_t* const      target state
+ * \return state_machine_result_t                 result of transition
+ *
+ */
+state_machine_result_t reference_switch_state(state_machine_t* const pState_Machine,
+                                              const state_t* const pTarget_State)
+{
+  const state_t* const pSource_State = pState_Machine->State;
+  state_machine_result_t result = EVENT_HANDLED;
+  pState_Machine->State = pTarget_State;
+
+  if(call_action(pState_Machine, pSource_State->Exit, &result))
+  {
+    call_action(pState_Machine, pTarget_State->Entry, &result);
+  }
+  return result;
+}
+
+#if HIERARCHICAL_STATES
+/** \brief Traverse to the target state, as traverse_state does.
+ *
+ * \param pState_Machine state_machine_t* const   state machine
+ * \param pTarget_State const state_t* const      target state
+ * \return state_machine_result_t                 result of transition
+ *
+ */
+state_machine_result_t reference_traverse_state(state_machine_t* const pState_Machine,
+                                                const state_t* const pTarget_State)
+{
+  const state_t* pSource_State = pState_Machine->State;
+  state_machine_result_t result = EVENT_HANDLED;
+  pState_Machine->State = pTarget_State;
+
+  // Level of the child states of the common parent: the deepest level at which
+  // the parent states of source and target have the same parent.
+  uint32_t level = (pSource_State->Level < pTarget_State->Level) ? pSource_State->Level : pTarget_State->Level;
+  while(get_ancestor(pSource_State, level)->Parent != get_ancestor(pTarget_State, level)->Parent)
+  {
+    level--;
+  }
+
+  while(pSource_State->Level >= level)
+  {
+    if(!call_action(pState_Machine, pSource_State->Exit, &result))
+    {
+      return result;
+    }
+    if(pSource_State->Level == level)
+    {
+      break;
+    }
+    pSource_State = pSource_State->Parent;
+  }
+
+  enter_down(pState_Machine, pTarget_State, level, &result);
+  return result;
+}
+#endif // HIERARCHICAL_STATES
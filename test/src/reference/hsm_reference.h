@@ -0,0 +1,42 @@
+/**
+ * \file
+ * \brief Reference engine of the state machine framework
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#ifndef HSM_REFERENCE_H
+#define HSM_REFERENCE_H
+
+#include "hsm.h"
+
+/*
+ *  --------------------- EXPORTED FUNCTION ---------------------
+ */
+
+#ifdef __cplusplus
+extern "C"  {
+#endif // __cplusplus
+
+extern state_machine_result_t reference_dispatch_event(state_machine_t* const pState_Machine[], uint32_t quantity);
+
+extern state_machine_result_t reference_switch_state(state_machine_t* const pState_Machine,
+                                                     const state_t* const pTarget_State);
+
+#if HIERARCHICAL_STATES
+extern state_machine_result_t reference_traverse_state(state_machine_t* const pState_Machine,
+                                                       const state_t* const pTarget_State);
+#endif // HIERARCHICAL_STATES
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // HSM_REFERENCE_H
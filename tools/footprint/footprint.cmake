@@ -0,0 +1,358 @@
+# Footprint of the framework in each configuration.
+#
+# Compiles src/*.c for each configuration of the matrix and reports the .text, .data and .bss of all
+# the objects, the .text of hsm.c alone and the worst-case stack of the dispatch path.
+# Then compares the footprint with the baseline and fails if any of them grows.
+#
+# cmake -DCOMPILER=<c compiler> -DSIZE=<size tool> -DSOURCE_DIR=<src dir> -DWORK_DIR=<dir>
+#       -DBASELINE=<baseline file> [-DFLAGS="-Os"] [-DUPDATE=ON] -P footprint.cmake
+#
+# Matrix: all the combinations of HIERARCHICAL_STATES, STATE_MACHINE_LOGGER and
+# HSM_USE_VARIABLE_LENGTH_ARRAY, then each of the optional features alone on the default finite and
+# hierarchical state machine. The USDT probes are disabled, except in their own configuration.
+#
+# Stack is the frame of dispatch_event plus the deepest of switch_state and traverse_state, called by
+# a state handler, or the deepest call chain of any other function if that is deeper.
+# The frames of the state handlers and actions are not included. It needs -fcallgraph-info of GCC 10
+# or newer, "dynamic" marks a variable length array in the chain.
+# The baseline is only checked with the compiler and flags it was made with.
+
+cmake_minimum_required(VERSION 3.5 FATAL_ERROR)
+
+foreach(variable COMPILER SIZE SOURCE_DIR WORK_DIR BASELINE)
+  if(NOT DEFINED ${variable})
+    message(FATAL_ERROR "footprint.cmake: ${variable} is not defined")
+  endif()
+endforeach()
+
+if(NOT DEFINED FLAGS)
+  set(FLAGS "-Os")
+endif()
+separate_arguments(FLAG_LIST UNIX_COMMAND "${FLAGS}")
+
+# Optional features, each with the definitions it needs.
+set(FEATURES
+  "event_objects:HSM_EVENT_OBJECTS=1"
+  "async_completion:HSM_ASYNC_COMPLETION=1"
+  "trace_buffer:HSM_TRACE_BUFFER=1"
+  "latency_histogram:HSM_LATENCY_HISTOGRAM=1"
+  "queue_metrics:HSM_EVENT_OBJECTS=1,HSM_QUEUE_METRICS=1"
+  "runtime_counters:HSM_RUNTIME_COUNTERS=1"
+  "flight_recorder:HSM_FLIGHT_RECORDER=1"
+  "state_coverage:HSM_STATE_COVERAGE=1"
+  "sampling_profiler:HSM_SAMPLING_PROFILER=1"
+  "watchdog:HSM_WATCHDOG=1"
+  "state_residency:HSM_STATE_RESIDENCY=1"
+  "usdt_probes:HSM_USDT_PROBES=1"
+  )
+
+set(CONFIGURATIONS)
+foreach(hierarchical 0 1)
+  if(hierarchical)
+    set(engine hsm)
+  else()
+    set(engine fsm)
+  endif()
+
+  foreach(logger 0 1)
+    foreach(vla 0 1)
+      list(APPEND CONFIGURATIONS
+           "${engine}/logger:${logger}/vla:${vla}:HIERARCHICAL_STATES=${hierarchical},STATE_MACHINE_LOGGER=${logger},HSM_USE_VARIABLE_LENGTH_ARRAY=${vla}")
+    endforeach()
+  endforeach()
+
+  foreach(feature ${FEATURES})
+    string(REGEX REPLACE ":.*" "" name "${feature}")
+    string(REGEX REPLACE "^[^:]*:" "" definitions "${feature}")
+    list(APPEND CONFIGURATIONS "${engine}/${name}:HIERARCHICAL_STATES=${hierarchical},${definitions}")
+  endforeach()
+endforeach()
+
+execute_process(COMMAND ${COMPILER} --version OUTPUT_VARIABLE COMPILER_VERSION ERROR_QUIET)
+string(REGEX REPLACE "\n.*" "" COMPILER_VERSION "${COMPILER_VERSION}")
+set(IDENTITY "${COMPILER_VERSION} ${FLAGS}")
+
+# Stack is measured if the compiler writes the call graph.
+file(MAKE_DIRECTORY ${WORK_DIR})
+file(WRITE ${WORK_DIR}/probe.c "int probe(void) { return 0; }\n")
+execute_process(COMMAND ${COMPILER} -fstack-usage -fcallgraph-info=su -c probe.c -o probe.o
+                WORKING_DIRECTORY ${WORK_DIR} RESULT_VARIABLE status OUTPUT_QUIET ERROR_QUIET)
+set(STACK_INFO OFF)
+if(status EQUAL 0)
+  set(STACK_INFO ON)
+endif()
+
+file(GLOB SOURCES ${SOURCE_DIR}/*.c)
+
+# Deepest call chain from the function, in bytes, without the indirect calls.
+# Sets <function>_DEPTH and <function>_DYNAMIC.
+function(get_depth function)
+  if(DEFINED ${function}_DEPTH)
+    set(${function}_DEPTH ${${function}_DEPTH} PARENT_SCOPE)
+    set(${function}_DYNAMIC ${${function}_DYNAMIC} PARENT_SCOPE)
+    return()
+  endif()
+
+  # Recursion is not expected in the framework, break it at the repeated function.
+  set(${function}_DEPTH 0 PARENT_SCOPE)
+  set(${function}_DYNAMIC OFF PARENT_SCOPE)
+  set(${function}_DEPTH 0)
+  set(${function}_DYNAMIC OFF)
+
+  set(deepest 0)
+  set(dynamic OFF)
+  foreach(callee ${${function}_CALLEES})
+    get_depth(${callee})
+    if(${callee}_DEPTH GREATER deepest)
+      set(deepest ${${callee}_DEPTH})
+      set(dynamic ${${callee}_DYNAMIC})
+    endif()
+  endforeach()
+
+  set(frame 0)
+  if(DEFINED ${function}_FRAME)
+    set(frame ${${function}_FRAME})
+  endif()
+  math(EXPR depth "${frame} + ${deepest}")
+  if(${function}_FRAME_DYNAMIC)
+    set(dynamic ON)
+  endif()
+
+  set(${function}_DEPTH ${depth} PARENT_SCOPE)
+  set(${function}_DYNAMIC ${dynamic} PARENT_SCOPE)
+endfunction()
+
+# Worst-case stack of the call graph files in the directory.
+function(get_stack directory result)
+  file(GLOB graphs ${directory}/*.ci)
+  set(functions)
+  foreach(graph ${graphs})
+    file(STRINGS ${graph} lines)
+    foreach(line ${lines})
+      if(line MATCHES "^node: { title: \"([^\"]+)\" label: \"[^\"]*\\\\n([0-9]+) bytes \\(([a-z,]+)\\)")
+        set(function ${CMAKE_MATCH_1})
+        set(${function}_FRAME ${CMAKE_MATCH_2})
+        set(${function}_FRAME_DYNAMIC OFF)
+        if(CMAKE_MATCH_3 MATCHES "dynamic")
+          set(${function}_FRAME_DYNAMIC ON)
+        endif()
+        list(APPEND functions ${function})
+      elseif(line MATCHES "^edge: { sourcename: \"([^\"]+)\" targetname: \"([^\"]+)\"")
+        if(NOT CMAKE_MATCH_2 STREQUAL "__indirect_call")
+          list(APPEND ${CMAKE_MATCH_1}_CALLEES ${CMAKE_MATCH_2})
+        endif()
+      endif()
+    endforeach()
+  endforeach()
+
+  set(stack 0)
+  set(dynamic OFF)
+  foreach(function ${functions})
+    get_depth(${function})
+    if(${function}_DEPTH GREATER stack)
+      set(stack ${${function}_DEPTH})
+      set(dynamic ${${function}_DYNAMIC})
+    endif()
+  endforeach()
+
+  # Dispatch path: the state handler called by dispatch_event makes a transition.
+  if(DEFINED dispatch_event_FRAME)
+    set(transition 0)
+    set(transition_dynamic OFF)
+    foreach(function switch_state traverse_state)
+      if(DEFINED ${function}_DEPTH AND ${function}_DEPTH GREATER transition)
+        set(transition ${${function}_DEPTH})
+        set(transition_dynamic ${${function}_DYNAMIC})
+      endif()
+    endforeach()
+
+    math(EXPR dispatch "${dispatch_event_DEPTH} + ${transition}")
+    if(dispatch GREATER stack)
+      set(stack ${dispatch})
+      set(dynamic OFF)
+      if(dispatch_event_DYNAMIC OR transition_dynamic)
+        set(dynamic ON)
+      endif()
+    endif()
+  endif()
+
+  if(dynamic)
+    set(stack "${stack}+dynamic")
+  endif()
+  set(${result} ${stack} PARENT_SCOPE)
+endfunction()
+
+# Sizes of the objects in the directory: text;data;bss;hsm.c text
+function(get_sizes directory result)
+  file(GLOB objects ${directory}/*.o)
+  execute_process(COMMAND ${SIZE} ${objects} OUTPUT_VARIABLE output RESULT_VARIABLE status)
+  if(NOT status EQUAL 0)
+    message(FATAL_ERROR "${SIZE} failed")
+  endif()
+
+  set(text 0)
+  set(data 0)
+  set(bss 0)
+  set(core 0)
+  string(REPLACE "\n" ";" lines "${output}")
+  foreach(line ${lines})
+    if(line MATCHES "^ *([0-9]+)[ \t]+([0-9]+)[ \t]+([0-9]+)[ \t]+[0-9]+[ \t]+[0-9a-f]+[ \t]+(.*)$")
+      set(object_text ${CMAKE_MATCH_1})
+      math(EXPR text "${text} + ${CMAKE_MATCH_1}")
+      math(EXPR data "${data} + ${CMAKE_MATCH_2}")
+      math(EXPR bss "${bss} + ${CMAKE_MATCH_3}")
+      if(CMAKE_MATCH_4 MATCHES "/hsm\\.o$")
+        set(core ${object_text})
+      endif()
+    endif()
+  endforeach()
+  set(${result} "${text};${data};${bss};${core}" PARENT_SCOPE)
+endfunction()
+
+# Footprint of all the configurations
+set(REPORT)
+foreach(configuration ${CONFIGURATIONS})
+  string(REGEX REPLACE ":[^:]*$" "" name "${configuration}")
+  string(REGEX REPLACE "^.*:" "" definitions "${configuration}")
+  string(REPLACE "," ";" definitions "${definitions}")
+
+  set(defines -DHSM_USDT_PROBES=0 -DMAX_HIERARCHICAL_LEVEL=8)
+  foreach(definition ${definitions})
+    list(APPEND defines -D${definition})
+  endforeach()
+
+  string(REPLACE "/" "_" directory "${name}")
+  string(REPLACE ":" "-" directory "${directory}")
+  set(directory ${WORK_DIR}/${directory})
+  file(REMOVE_RECURSE ${directory})
+  file(MAKE_DIRECTORY ${directory})
+
+  foreach(source ${SOURCES})
+    get_filename_component(object ${source} NAME_WE)
+    set(stack_flags)
+    if(STACK_INFO)
+      set(stack_flags -fstack-usage -fcallgraph-info=su)
+    endif()
+    execute_process(COMMAND ${COMPILER} ${FLAG_LIST} ${stack_flags} ${defines} -I${SOURCE_DIR}
+                            -c ${source} -o ${object}.o
+                    WORKING_DIRECTORY ${directory} RESULT_VARIABLE status ERROR_VARIABLE errors)
+    if(NOT status EQUAL 0)
+      message(FATAL_ERROR "${name}: ${source} doesn't compile\n${errors}")
+    endif()
+  endforeach()
+
+  get_sizes(${directory} sizes)
+  set(stack "-")
+  if(STACK_INFO)
+    get_stack(${directory} stack)
+  endif()
+
+  string(REPLACE ";" " " sizes "${sizes}")
+  list(APPEND REPORT "${name} ${sizes} ${stack}")
+endforeach()
+
+if(UPDATE)
+  set(content "# Footprint of src/*.c, made by the hsm_footprint_baseline target, see tools/footprint/footprint.cmake\n")
+  string(APPEND content "# compiler ${IDENTITY}\n")
+  string(APPEND content "# configuration text data bss hsm.c-text stack\n")
+  foreach(line ${REPORT})
+    string(APPEND content "${line}\n")
+  endforeach()
+  file(WRITE ${BASELINE} "${content}")
+  message(STATUS "Footprint baseline written to ${BASELINE}")
+  return()
+endif()
+
+# Compare with the baseline
+set(BASELINE_IDENTITY)
+if(EXISTS ${BASELINE})
+  file(STRINGS ${BASELINE} baseline_lines)
+  foreach(line ${baseline_lines})
+    if(line MATCHES "^# compiler (.*)$")
+      set(BASELINE_IDENTITY "${CMAKE_MATCH_1}")
+    elseif(NOT line MATCHES "^#" AND line MATCHES "^([^ ]+) (.*)$")
+      string(REPLACE "/" "_" key "${CMAKE_MATCH_1}")
+      string(REPLACE ":" "-" key "${key}")
+      set(BASELINE_${key} "${CMAKE_MATCH_2}")
+    endif()
+  endforeach()
+endif()
+
+set(CHECKED OFF)
+if(BASELINE_IDENTITY STREQUAL IDENTITY)
+  set(CHECKED ON)
+endif()
+
+message("Footprint in bytes, ${IDENTITY}")
+message("configuration                       text    data     bss  hsm.c-text             stack")
+set(REGRESSIONS 0)
+foreach(line ${REPORT})
+  string(REPLACE " " ";" fields "${line}")
+  list(GET fields 0 name)
+  list(GET fields 1 text)
+  list(GET fields 2 data)
+  list(GET fields 3 bss)
+  list(GET fields 4 core)
+  list(GET fields 5 stack)
+
+  set(row "${name}")
+  string(LENGTH "${row}" length)
+  while(length LESS 32)
+    string(APPEND row " ")
+    math(EXPR length "${length} + 1")
+  endwhile()
+
+  string(REPLACE "/" "_" key "${name}")
+  string(REPLACE ":" "-" key "${key}")
+  set(baseline_fields)
+  if(DEFINED BASELINE_${key})
+    string(REPLACE " " ";" baseline_fields "${BASELINE_${key}}")
+  endif()
+
+  set(index 0)
+  foreach(value ${text} ${data} ${bss} ${core} ${stack})
+    set(cell "${value}")
+    if(baseline_fields)
+      list(GET baseline_fields ${index} old)
+      string(REGEX REPLACE "[^0-9].*" "" old_bytes "${old}")
+      string(REGEX REPLACE "[^0-9].*" "" new_bytes "${value}")
+      if(NOT old_bytes STREQUAL "" AND NOT new_bytes STREQUAL "" AND NOT old_bytes EQUAL new_bytes)
+        math(EXPR delta "${new_bytes} - ${old_bytes}")
+        if(delta GREATER 0)
+          set(cell "${cell}(+${delta})")
+          if(CHECKED)
+            math(EXPR REGRESSIONS "${REGRESSIONS} + 1")
+          endif()
+        else()
+          set(cell "${cell}(${delta})")
+        endif()
+      endif()
+    endif()
+
+    set(width 8)
+    if(index EQUAL 3)
+      set(width 12)
+    elseif(index EQUAL 4)
+      set(width 18)
+    endif()
+    string(LENGTH "${cell}" length)
+    while(length LESS width)
+      set(cell " ${cell}")
+      math(EXPR length "${length} + 1")
+    endwhile()
+    string(APPEND row "${cell}")
+    math(EXPR index "${index} + 1")
+  endforeach()
+  message("${row}")
+endforeach()
+
+if(NOT EXISTS ${BASELINE})
+  message(WARNING "No footprint baseline ${BASELINE}, make it with the hsm_footprint_baseline target")
+elseif(NOT CHECKED)
+  message(WARNING "Footprint baseline is of \"${BASELINE_IDENTITY}\", not checked with \"${IDENTITY}\"")
+elseif(REGRESSIONS GREATER 0)
+  message(FATAL_ERROR "Footprint grows in ${REGRESSIONS} values. If it is expected, "
+                      "update the baseline with the hsm_footprint_baseline target")
+else()
+  message(STATUS "Footprint doesn't grow from the baseline")
+endif()
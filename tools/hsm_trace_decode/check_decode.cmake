@@ -0,0 +1,79 @@
+# Check of hsm_trace_decode on the dump written by the feature test.
+# Run with cmake -DDECODER=<hsm_trace_decode> -DDUMP=<dump file> -DPOST_DUMP=<dump file> -DOUTPUT=<json file>
+#         -P check_decode.cmake
+#
+# The dump has the same state machine dispatched on two threads, both at index 0 of their
+# state machine arrays: a bubbling event from state 3 and the transition of state 1 to state 4.
+# The post dump has two event objects posted to a state machine, each one after the dispatch of
+# the previous one, so that both take the same pool block and have the same flow id.
+
+# Text mode
+execute_process(COMMAND ${DECODER} ${DUMP} RESULT_VARIABLE result OUTPUT_VARIABLE text ERROR_VARIABLE error)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "hsm_trace_decode ${DUMP} failed: ${error}")
+endif()
+
+foreach(pattern
+        "20 records, 0 dropped"
+        "machine  0  dispatch +state +3 +event +5"
+        "result +state +3 +event +5  EVENT_UN_HANDLED, now in state 3"
+        "bubble +state +3 +event +6  -> parent 2"
+        "transition +state +3 +event +6  -> target 4"
+        "result +state +1 +event +6  EVENT_HANDLED, now in state 4")
+  if(NOT text MATCHES "${pattern}")
+    message(FATAL_ERROR "Text trace doesn't contain \"${pattern}\":\n${text}")
+  endif()
+endforeach()
+
+# Chrome trace event mode
+file(REMOVE ${OUTPUT})
+execute_process(COMMAND ${DECODER} ${DUMP} ${OUTPUT} RESULT_VARIABLE result ERROR_VARIABLE error)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "hsm_trace_decode ${DUMP} ${OUTPUT} failed: ${error}")
+endif()
+file(READ ${OUTPUT} json)
+
+if(NOT CMAKE_VERSION VERSION_LESS 3.19)
+  string(JSON events ERROR_VARIABLE error LENGTH "${json}" traceEvents)
+  if(error)
+    message(FATAL_ERROR "Chrome trace is not valid JSON: ${error}")
+  endif()
+endif()
+
+# Each thread has its own track of machine 0 with the slices of the two handler calls.
+string(REGEX MATCHALL "\"tid\":[0-9]+,\"name\":\"thread_name\",\"args\":{\"name\":\"thread [0-9]+ machine 0\"" tracks "${json}")
+list(LENGTH tracks count)
+if(NOT count EQUAL 2)
+  message(FATAL_ERROR "Expected a track of machine 0 on each of 2 threads, found ${count}:\n${json}")
+endif()
+list(GET tracks 0 first)
+list(GET tracks 1 second)
+string(REGEX REPLACE "^\"tid\":([0-9]+),.*" "\\1" first "${first}")
+string(REGEX REPLACE "^\"tid\":([0-9]+),.*" "\\1" second "${second}")
+if(first STREQUAL second)
+  message(FATAL_ERROR "Both threads use the track ${first}")
+endif()
+
+foreach(tid ${first} ${second})
+  string(REGEX MATCHALL "\"ph\":\"X\",\"pid\":1,\"tid\":${tid}," slices "${json}")
+  list(LENGTH slices count)
+  if(NOT count EQUAL 2)
+    message(FATAL_ERROR "Expected 2 handler slices on track ${tid}, found ${count}:\n${json}")
+  endif()
+endforeach()
+
+# Each post of the same pool block has its own flow, from the post to the first dispatch of the event.
+file(REMOVE ${OUTPUT})
+execute_process(COMMAND ${DECODER} ${POST_DUMP} ${OUTPUT} RESULT_VARIABLE result ERROR_VARIABLE error)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "hsm_trace_decode ${POST_DUMP} ${OUTPUT} failed: ${error}")
+endif()
+file(READ ${OUTPUT} json)
+
+foreach(phase s f)
+  string(REGEX MATCHALL "\"ph\":\"${phase}\",[^}]*\"cat\":\"post\"" flows "${json}")
+  list(LENGTH flows count)
+  if(NOT count EQUAL 2)
+    message(FATAL_ERROR "Expected 2 post flows of phase ${phase}, found ${count}:\n${json}")
+  endif()
+endforeach()
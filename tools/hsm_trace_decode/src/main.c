@@ -0,0 +1,473 @@
+/**
+ * \file
+ * \brief Decoder of the binary trace dump of state machine framework
+
+ * \author  Nandkishor Biradar
+ * \date    18 October 2026
+
+ *  Copyright (c) 2018-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+// Usage: hsm_trace_decode <dump file> [chrome trace file]
+// Without the second argument, it prints one line per trace record.
+// Time is in microseconds since the earliest record.
+// With the second argument, it writes the trace in Chrome trace event JSON format,
+// that opens in chrome://tracing and https://ui.perfetto.dev
+
+/*
+ *  --------------------- INCLUDE FILES ---------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "hsm_trace_format.h"
+
+/*
+ *  --------------------- DEFINITION ---------------------
+ */
+
+#define MAX_MACHINES          ((uint32_t)TRACE_UNKNOWN_MACHINE + 1)
+#define MAX_NESTED_DISPATCH   8     //!< dispatch_event called from a state handler
+#define SELF_FLOW_BASE        0x100000000ull  //!< Flow ids of TRIGGERED_TO_SELF chains
+#define RESULT_UN_HANDLED         1           //!< EVENT_UN_HANDLED of state_machine_result_t
+#define RESULT_TRIGGERED_TO_SELF  2           //!< TRIGGERED_TO_SELF of state_machine_result_t
+#define RESULT_PENDING            3           //!< EVENT_PENDING of state_machine_result_t
+
+/*
+ *  --------------------- STRUCTURE ---------------------
+ */
+
+//! Trace record along with the trace buffer it is read from.
+typedef struct
+{
+  trace_record_t Record;
+  uint32_t Thread;
+}decoded_record_t;
+
+//! Records of the dump file.
+typedef struct
+{
+  decoded_record_t* Records;
+  uint64_t Count;
+  uint64_t Dropped;
+  uint64_t Origin;            //!< Earliest timestamp
+  uint64_t Ticks_Per_Second;
+}trace_t;
+
+//! Dispatch record waiting for its result on a trace buffer.
+typedef struct
+{
+  const trace_record_t* Dispatch[MAX_NESTED_DISPATCH];
+  uint32_t Depth;
+}dispatch_stack_t;
+
+/*
+ *  --------------------- GLOBAL VARIABLES ---------------------
+ */
+
+static const char* const Record_Names[TOTAL_TRACE_TYPES] =
+{
+  [TRACE_DISPATCH] = "dispatch",
+  [TRACE_RESULT] = "result",
+  [TRACE_BUBBLE] = "bubble",
+  [TRACE_TRANSITION] = "transition",
+  [TRACE_EXIT] = "exit",
+  [TRACE_ENTRY] = "entry",
+  [TRACE_POST] = "post",
+};
+
+//! Names of state_machine_result_t
+static const char* const Result_Names[] =
+{
+  "EVENT_HANDLED",
+  "EVENT_UN_HANDLED",
+  "TRIGGERED_TO_SELF",
+  "EVENT_PENDING",
+};
+
+/*
+ *  --------------------- FUNCTION BODY ---------------------
+ */
+
+static const char* get_result_name(uint8_t result)
+{
+  if(result < sizeof(Result_Names) / sizeof(Result_Names[0]))
+  {
+    return Result_Names[result];
+  }
+  return "unknown result";
+}
+
+//! Time of the record in microseconds since the earliest record.
+static double get_time(const trace_t* const pTrace, uint64_t timestamp)
+{
+  return (double)(timestamp - pTrace->Origin) * 1000000.0 / (double)pTrace->Ticks_Per_Second;
+}
+
+static bool load_trace(const char* const pPath, trace_t* const pTrace)
+{
+  FILE* const pFile = fopen(pPath, "rb");
+  if(pFile == NULL)
+  {
+    perror(pPath);
+    return false;
+  }
+
+  trace_dump_header_t header;
+  if((fread(&header, sizeof(header), 1, pFile) != 1)
+     || (header.Magic != TRACE_DUMP_MAGIC))
+  {
+    fprintf(stderr, "%s: not a state machine trace dump\n", pPath);
+    fclose(pFile);
+    return false;
+  }
+
+  if((header.Version != TRACE_DUMP_VERSION) || (header.Record_Size != sizeof(trace_record_t))
+     || (header.Ticks_Per_Second == 0))
+  {
+    fprintf(stderr, "%s: unsupported trace dump version %" PRIu32 "\n", pPath, header.Version);
+    fclose(pFile);
+    return false;
+  }
+
+  uint64_t capacity = 0;
+  trace_dump_block_t block;
+  pTrace->Records = NULL;
+  pTrace->Count = 0;
+  pTrace->Dropped = 0;
+  pTrace->Origin = UINT64_MAX;
+  pTrace->Ticks_Per_Second = header.Ticks_Per_Second;
+
+  while(fread(&block, sizeof(block), 1, pFile) == 1)
+  {
+    pTrace->Dropped += block.Dropped;
+
+    if(pTrace->Count + block.Count > capacity)
+    {
+      capacity = (pTrace->Count + block.Count) * 2;
+      decoded_record_t* const pRecords = realloc(pTrace->Records, capacity * sizeof(decoded_record_t));
+      if(pRecords == NULL)
+      {
+        fprintf(stderr, "%s: out of memory\n", pPath);
+        fclose(pFile);
+        return false;
+      }
+      pTrace->Records = pRecords;
+    }
+
+    for(uint32_t index = 0; index < block.Count; index++)
+    {
+      decoded_record_t* const pRecord = &pTrace->Records[pTrace->Count];
+      if(fread(&pRecord->Record, sizeof(trace_record_t), 1, pFile) != 1)
+      {
+        fprintf(stderr, "%s: truncated trace dump\n", pPath);
+        fclose(pFile);
+        return false;
+      }
+
+      pRecord->Thread = block.Thread;
+      if(pRecord->Record.Timestamp < pTrace->Origin)
+      {
+        pTrace->Origin = pRecord->Record.Timestamp;
+      }
+      pTrace->Count++;
+    }
+  }
+
+  fclose(pFile);
+  return true;
+}
+
+static void print_record(const trace_t* const pTrace, const decoded_record_t* const pDecoded)
+{
+  const trace_record_t* const pRecord = &pDecoded->Record;
+
+  printf("%14.3f  thread %2" PRIu32 "  ", get_time(pTrace, pRecord->Timestamp), pDecoded->Thread);
+  if(pRecord->Machine == TRACE_UNKNOWN_MACHINE)
+  {
+    printf("machine  -  ");
+  }
+  else
+  {
+    printf("machine %2u  ", (unsigned)pRecord->Machine);
+  }
+
+  if(pRecord->Type >= TOTAL_TRACE_TYPES)
+  {
+    printf("unknown record type %u\n", (unsigned)pRecord->Type);
+    return;
+  }
+
+  printf("%-10s  state %4" PRIu32 "  event %4" PRIu32, Record_Names[pRecord->Type],
+         pRecord->State, pRecord->Event);
+
+  switch(pRecord->Type)
+  {
+  case TRACE_DISPATCH:
+  case TRACE_POST:
+    if(pRecord->Aux != 0)
+    {
+      printf("  flow %08" PRIx32, pRecord->Aux);
+    }
+    break;
+
+  case TRACE_RESULT:
+    printf("  %s, now in state %" PRIu32, get_result_name(pRecord->Result), pRecord->Aux);
+    break;
+
+  case TRACE_BUBBLE:
+    printf("  -> parent %" PRIu32, pRecord->Aux);
+    break;
+
+  case TRACE_TRANSITION:
+    printf("  -> target %" PRIu32, pRecord->Aux);
+    break;
+
+  default:
+    break;
+  }
+  printf("\n");
+}
+
+static void print_trace(const trace_t* const pTrace)
+{
+  for(uint64_t index = 0; index < pTrace->Count; index++)
+  {
+    print_record(pTrace, &pTrace->Records[index]);
+  }
+  printf("%" PRIu64 " records, %" PRIu64 " dropped\n", pTrace->Count, pTrace->Dropped);
+}
+
+//! Track of the record. Threads dispatch their own arrays of state machines, so each thread has
+//! its own track of each machine index. Records outside of the dispatcher use the track of unknown machine.
+static uint64_t get_track(const decoded_record_t* const pDecoded)
+{
+  return (uint64_t)pDecoded->Thread * MAX_MACHINES + pDecoded->Record.Machine;
+}
+
+//! Write the common fields of a trace event.
+static void write_event(FILE* const pFile, const trace_t* const pTrace, const char* const pPhase,
+                        const decoded_record_t* const pDecoded, uint64_t timestamp)
+{
+  fprintf(pFile, ",\n{\"ph\":\"%s\",\"pid\":1,\"tid\":%" PRIu64 ",\"ts\":%.3f", pPhase,
+          get_track(pDecoded), get_time(pTrace, timestamp));
+}
+
+static void write_instant(FILE* const pFile, const trace_t* const pTrace,
+                          const decoded_record_t* const pDecoded, const char* const pName, uint32_t target)
+{
+  const trace_record_t* const pRecord = &pDecoded->Record;
+  write_event(pFile, pTrace, "i", pDecoded, pRecord->Timestamp);
+  fprintf(pFile, ",\"s\":\"t\",\"cat\":\"transition\",\"name\":\"%s %" PRIu32, pName, pRecord->State);
+  if(target != 0)
+  {
+    fprintf(pFile, " -> %" PRIu32, target);
+  }
+  fprintf(pFile, "\",\"args\":{\"event\":%" PRIu32 "}}", pRecord->Event);
+}
+
+static void write_flow(FILE* const pFile, const trace_t* const pTrace, const char* const pPhase,
+                       const decoded_record_t* const pDecoded, uint64_t timestamp,
+                       const char* const pCategory, uint64_t id)
+{
+  write_event(pFile, pTrace, pPhase, pDecoded, timestamp);
+  fprintf(pFile, ",\"cat\":\"%s\",\"name\":\"%s\",\"id\":%" PRIu64 "%s}", pCategory, pCategory, id,
+          (pPhase[0] == 'f') ? ",\"bp\":\"e\"" : "");
+}
+
+/** \brief Write the trace in Chrome trace event format.
+ *  Each state machine has its own track on each thread, each state handler call is a slice on it.
+ *  Flow arrows link the TRIGGERED_TO_SELF results to the next dispatch
+ *  and the posts of event objects to their dispatch.
+ */
+static bool write_chrome_trace(const trace_t* const pTrace, const char* const pPath)
+{
+  FILE* const pFile = fopen(pPath, "w");
+  if(pFile == NULL)
+  {
+    perror(pPath);
+    return false;
+  }
+
+  uint32_t threads = 0;
+  for(uint64_t index = 0; index < pTrace->Count; index++)
+  {
+    if(pTrace->Records[index].Thread >= threads)
+    {
+      threads = pTrace->Records[index].Thread + 1;
+    }
+  }
+
+  // Per track: flow waiting for the next dispatch and the flow of posted event being processed.
+  const uint64_t tracks = (uint64_t)threads * MAX_MACHINES;
+  uint64_t* const pSelf_Flow = calloc(tracks, sizeof(uint64_t));
+  uint32_t* const pPost_Flow = calloc(tracks, sizeof(uint32_t));
+  bool* const pUsed = calloc(tracks, sizeof(bool));
+  dispatch_stack_t* const pStacks = calloc(threads + 1, sizeof(dispatch_stack_t));
+
+  if(((tracks != 0) && ((pSelf_Flow == NULL) || (pPost_Flow == NULL) || (pUsed == NULL))) || (pStacks == NULL))
+  {
+    fprintf(stderr, "%s: out of memory\n", pPath);
+    free(pSelf_Flow);
+    free(pPost_Flow);
+    free(pUsed);
+    free(pStacks);
+    fclose(pFile);
+    return false;
+  }
+
+  uint64_t self_flows = SELF_FLOW_BASE;
+  fprintf(pFile, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                 "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"state machines\"}}");
+
+  for(uint64_t index = 0; index < pTrace->Count; index++)
+  {
+    const decoded_record_t* const pDecoded = &pTrace->Records[index];
+    const trace_record_t* const pRecord = &pDecoded->Record;
+    const uint64_t track = get_track(pDecoded);
+    dispatch_stack_t* const pStack = &pStacks[pDecoded->Thread];
+    pUsed[track] = true;
+
+    switch(pRecord->Type)
+    {
+    case TRACE_DISPATCH:
+      if(pStack->Depth < MAX_NESTED_DISPATCH)
+      {
+        pStack->Dispatch[pStack->Depth] = pRecord;
+      }
+      pStack->Depth++;
+
+      if(pSelf_Flow[track] != 0)
+      {
+        write_flow(pFile, pTrace, "f", pDecoded, pRecord->Timestamp, "self", pSelf_Flow[track]);
+        pSelf_Flow[track] = 0;
+      }
+
+      // Event object is dispatched again on bubbling, trigger to self and asynchronous completion,
+      // link only the first dispatch.
+      if((pRecord->Aux != 0) && (pRecord->Aux != pPost_Flow[track]))
+      {
+        write_flow(pFile, pTrace, "f", pDecoded, pRecord->Timestamp, "post", pRecord->Aux);
+      }
+      pPost_Flow[track] = pRecord->Aux;
+      break;
+
+    case TRACE_RESULT:
+      if((pStack->Depth == 0) || (pStack->Depth-- > MAX_NESTED_DISPATCH))
+      {
+        break;    // Dispatch is not in the dump.
+      }
+      {
+        const trace_record_t* const pDispatch = pStack->Dispatch[pStack->Depth];
+        write_event(pFile, pTrace, "X", pDecoded, pDispatch->Timestamp);
+        fprintf(pFile, ",\"dur\":%.3f,\"cat\":\"handler\",\"name\":\"state %" PRIu32 "\","
+                       "\"args\":{\"event\":%" PRIu32 ",\"result\":\"%s\",\"state\":%" PRIu32 "}}",
+                get_time(pTrace, pRecord->Timestamp) - get_time(pTrace, pDispatch->Timestamp),
+                pDispatch->State, pDispatch->Event, get_result_name(pRecord->Result), pRecord->Aux);
+
+        if(pRecord->Result == RESULT_TRIGGERED_TO_SELF)
+        {
+          pSelf_Flow[track] = ++self_flows;
+          write_flow(pFile, pTrace, "s", pDecoded, pDispatch->Timestamp, "self", self_flows);
+        }
+
+        // The event object is released once its processing is over. The pool may hand the same block,
+        // that is the same flow id, to the next post.
+        if((pRecord->Result != RESULT_UN_HANDLED) && (pRecord->Result != RESULT_TRIGGERED_TO_SELF)
+           && (pRecord->Result != RESULT_PENDING))
+        {
+          pPost_Flow[track] = 0;
+        }
+      }
+      break;
+
+    case TRACE_BUBBLE:
+      write_instant(pFile, pTrace, pDecoded, "bubble", pRecord->Aux);
+      break;
+
+    case TRACE_TRANSITION:
+      write_instant(pFile, pTrace, pDecoded, "transition", pRecord->Aux);
+      break;
+
+    case TRACE_EXIT:
+      write_instant(pFile, pTrace, pDecoded, "exit", 0);
+      break;
+
+    case TRACE_ENTRY:
+      write_instant(pFile, pTrace, pDecoded, "entry", 0);
+      break;
+
+    case TRACE_POST:
+      // Zero length slice, so that the flow arrow has a slice to start from.
+      write_event(pFile, pTrace, "X", pDecoded, pRecord->Timestamp);
+      fprintf(pFile, ",\"dur\":0,\"cat\":\"post\",\"name\":\"post event %" PRIu32 "\"}", pRecord->Event);
+      write_flow(pFile, pTrace, "s", pDecoded, pRecord->Timestamp, "post", pRecord->Aux);
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  for(uint64_t track = 0; track < tracks; track++)
+  {
+    if(pUsed[track])
+    {
+      const uint32_t machine = (uint32_t)(track % MAX_MACHINES);
+      fprintf(pFile, ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%" PRIu64 ",\"name\":\"thread_name\","
+                     "\"args\":{\"name\":\"thread %" PRIu32 " ", track, (uint32_t)(track / MAX_MACHINES));
+      if(machine == TRACE_UNKNOWN_MACHINE)
+      {
+        fprintf(pFile, "outside dispatcher\"}}");
+      }
+      else
+      {
+        fprintf(pFile, "machine %" PRIu32 "\"}}", machine);
+      }
+    }
+  }
+  fprintf(pFile, "\n]}\n");
+
+  free(pSelf_Flow);
+  free(pPost_Flow);
+  free(pUsed);
+  free(pStacks);
+  return fclose(pFile) == 0;
+}
+
+int main(int argc, char* argv[])
+{
+  if((argc != 2) && (argc != 3))
+  {
+    fprintf(stderr, "Usage: %s <dump file> [chrome trace file]\n", argv[0]);
+    return 2;
+  }
+
+  trace_t trace = {0};
+  if(load_trace(argv[1], &trace) == false)
+  {
+    free(trace.Records);
+    return 1;
+  }
+
+  bool success = true;
+  if(argc == 2)
+  {
+    print_trace(&trace);
+  }
+  else
+  {
+    success = write_chrome_trace(&trace, argv[2]);
+  }
+
+  free(trace.Records);
+  return success ? 0 : 1;
+}